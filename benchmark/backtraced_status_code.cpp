@@ -0,0 +1,75 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/backtraced_status_code.hpp"
+#include "status-code/posix_code.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#ifndef ITERATIONS
+#define ITERATIONS 1000000
+#endif
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static NOINLINE system_code fail(int errcode)
+{
+  return make_backtraced_status_code(posix_code(errcode));
+}
+
+static double benchmark(unsigned period)
+{
+  set_backtrace_sampling_period(period);
+  volatile size_t sink = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < ITERATIONS; n++)
+  {
+    system_code sc = fail(EBADF);
+    sink = sink + static_cast<size_t>(sc.value());
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  (void) sink;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS;
+}
+
+int main()
+{
+  struct
+  {
+    const char *description;
+    unsigned period;
+  } const rates[] = {{"0%", 0}, {"1%", 100}, {"100%", 1}};
+  for(auto &rate : rates)
+  {
+    printf("Sampling %5s: %f ns per error\n", rate.description, benchmark(rate.period));
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/compact_code.hpp"
+#include "status-code/http_status_code.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifndef CODES
+#define CODES 4000000  // too many to stay in cache, so memory traffic is measured too
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// The last error of many connections: mostly would block, some resets, and the odd HTTP error
+template <class T> static std::vector<T> make_codes()
+{
+  std::vector<T> ret;
+  ret.reserve(CODES);
+  unsigned seed = 78;
+  for(size_t n = 0; n < CODES; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    switch((seed >> 8) % 8)
+    {
+    case 0:
+      ret.push_back(T(http_status_code(404)));
+      break;
+    case 1:
+      ret.push_back(T(posix_code(ECONNRESET)));
+      break;
+    default:
+      ret.push_back(T(posix_code(EAGAIN)));
+      break;
+    }
+  }
+  return ret;
+}
+
+template <class F> static double measure(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s: %f ns per code (%zu)\n", name, ret, sink);
+  return ret;
+}
+
+template <class T> static size_t count_would_block(const std::vector<T> &codes)
+{
+  size_t ret = 0;
+  for(const auto &c : codes)
+  {
+    ret += (c == errc::resource_unavailable_try_again);
+  }
+  return ret;
+}
+
+template <class T> static size_t count_not_found(const std::vector<T> &codes)
+{
+  size_t ret = 0;
+  for(const auto &c : codes)
+  {
+    ret += (c == errc::no_such_file_or_directory);
+  }
+  return ret;
+}
+
+int main()
+{
+  printf("%d codes take %zu bytes as system_code, %zu bytes as compact_code\n\n", CODES, CODES * sizeof(system_code), CODES * sizeof(compact_code));
+
+  std::vector<system_code> system_codes;
+  std::vector<compact_code> compact_codes;
+  measure("make system_code", [&] {
+    system_codes = make_codes<system_code>();
+    return system_codes.size();
+  });
+  measure("make compact_code", [&] {
+    compact_codes = make_codes<compact_code>();
+    return compact_codes.size();
+  });
+  // POSIX codes equal to the errc, which compact codes decide from their flags alone
+  measure("system_code == errc::resource_unavailable_try_again", [&] { return count_would_block(system_codes); });
+  measure("compact_code == errc::resource_unavailable_try_again", [&] { return count_would_block(compact_codes); });
+  // Only HTTP codes are equal, which compact codes decide through the registry's table
+  measure("system_code == errc::no_such_file_or_directory", [&] { return count_not_found(system_codes); });
+  measure("compact_code == errc::no_such_file_or_directory", [&] { return count_not_found(compact_codes); });
+  measure("compact_code from system_code", [&] {
+    size_t ret = 0;
+    for(const auto &c : system_codes)
+    {
+      ret += compact_code(c).index();
+    }
+    return ret;
+  });
+  measure("compact_code to system_code", [&] {
+    size_t ret = 0;
+    for(const auto &c : compact_codes)
+    {
+      ret += c.to_system_code().failure();
+    }
+    return ret;
+  });
+  return 0;
+}
@@ -0,0 +1,111 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/equivalence_cache.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifndef CODES
+#define CODES 1000000
+#endif
+#ifndef SAMPLE
+#define SAMPLE 1024  // small enough to stay in cache, so the comparisons are measured rather than memory
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// Failures as a retry loop on a non-blocking socket might see them: mostly would block, otherwise a few others
+static std::vector<system_code> make_sample()
+{
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  static const int errnos[] = {EAGAIN, EAGAIN, EAGAIN, EAGAIN, EAGAIN, EAGAIN, EINTR, ECONNRESET};
+  using code_type = posix_code;
+#else
+  static const errc errnos[] = {errc::resource_unavailable_try_again, errc::resource_unavailable_try_again, errc::resource_unavailable_try_again,
+                                errc::resource_unavailable_try_again, errc::resource_unavailable_try_again, errc::resource_unavailable_try_again,
+                                errc::interrupted,                    errc::connection_reset};
+  using code_type = generic_code;
+#endif
+  std::vector<system_code> ret;
+  ret.reserve(SAMPLE);
+  unsigned seed = 78;
+  for(size_t n = 0; n < SAMPLE; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    ret.push_back(code_type(errnos[(seed >> 8) % (sizeof(errnos) / sizeof(errnos[0]))]));
+  }
+  return ret;
+}
+
+template <class F> static double measure(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s: %f ns per comparison (%zu)\n", name, ret, sink);
+  return ret;
+}
+
+int main()
+{
+  const std::vector<system_code> sample = make_sample();
+  // Most codes compare equal, which equivalent() finds on its first virtual call
+  measure("sc == errc::resource_unavailable_try_again", [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += (sample[n % SAMPLE] == errc::resource_unavailable_try_again);
+    }
+    return ret;
+  });
+  measure("SYSTEM_ERROR2_ERRC_EQUIVALENT(sc, errc::resource_unavailable_try_again)", [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += SYSTEM_ERROR2_ERRC_EQUIVALENT(sample[n % SAMPLE], errc::resource_unavailable_try_again);
+    }
+    return ret;
+  });
+  // No codes compare equal, which costs equivalent() all four of its stages
+  measure("sc == errc::timed_out", [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += (sample[n % SAMPLE] == errc::timed_out);
+    }
+    return ret;
+  });
+  measure("SYSTEM_ERROR2_ERRC_EQUIVALENT(sc, errc::timed_out)", [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += SYSTEM_ERROR2_ERRC_EQUIVALENT(sample[n % SAMPLE], errc::timed_out);
+    }
+    return ret;
+  });
+  return 0;
+}
@@ -0,0 +1,65 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/system_error2.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#ifndef ITERATIONS
+#define ITERATIONS 10000000
+#endif
+
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static NOINLINE error fail1(int errcode)
+{
+  return error(posix_code(errcode));
+}
+static NOINLINE error fail2(int errcode)
+{
+  return error(posix_code(errcode));
+}
+
+int main()
+{
+  volatile size_t sink = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < ITERATIONS; n++)
+  {
+    error e = (n & 1) ? fail1(EBADF) : fail2(ENOENT);
+    sink = sink + static_cast<size_t>(e.value());
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  (void) sink;
+  printf("Call site attribution %s: %f ns per error construction\n", SYSTEM_ERROR2_CALL_SITES ? "enabled" : "disabled",
+         static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS);
+  return 0;
+}
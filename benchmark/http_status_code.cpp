@@ -0,0 +1,156 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef LINES
+#define LINES 1000000
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+/* Status lines in the proportions typically recorded at a caching reverse proxy. As
+recorded traffic cannot be shipped, a sample is synthesised from these proportions.
+*/
+static const struct
+{
+  const char *line;
+  unsigned weight;
+} traffic[] = {
+{"HTTP/1.1 200 OK\r\n", 700},                    //
+{"HTTP/1.1 304 Not Modified\r\n", 100},          //
+{"HTTP/1.1 301 Moved Permanently\r\n", 35},      //
+{"HTTP/1.1 302 Found\r\n", 25},                  //
+{"HTTP/1.1 404 Not Found\r\n", 60},              //
+{"HTTP/1.1 204 No Content\r\n", 30},             //
+{"HTTP/1.1 206 Partial Content\r\n", 15},        //
+{"HTTP/1.0 200 OK\r\n", 10},                     //
+{"HTTP/1.1 403 Forbidden\r\n", 8},               //
+{"HTTP/1.1 500 Internal Server Error\r\n", 7},   //
+{"HTTP/1.1 502 Bad Gateway\r\n", 5},             //
+{"HTTP/1.1 503 Service Unavailable\r\n", 4},     //
+{"HTTP/1.1 429 Too Many Requests\r\n", 1},       //
+};
+
+static std::string make_sample()
+{
+  unsigned total = 0;
+  for(const auto &t : traffic)
+  {
+    total += t.weight;
+  }
+  std::string ret;
+  unsigned seed = 78;
+  for(size_t n = 0; n < LINES; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    unsigned pick = (seed >> 8) % total;
+    for(const auto &t : traffic)
+    {
+      if(pick < t.weight)
+      {
+        ret.append(t.line);
+        break;
+      }
+      pick -= t.weight;
+    }
+  }
+  return ret;
+}
+
+// What one might write without the parser
+static size_t naive_parse(http_status_code *codes, size_t max, const char *buffer, size_t length)
+{
+  size_t count = 0;
+  const char *end = buffer + length;
+  while(count < max && buffer < end)
+  {
+    const auto *eol = static_cast<const char *>(memchr(buffer, '\n', static_cast<size_t>(end - buffer)));
+    if(eol == nullptr)
+    {
+      break;
+    }
+    if(strncmp(buffer, "HTTP/1.", 7) == 0 && (buffer[7] == '0' || buffer[7] == '1') && buffer[8] == ' ')
+    {
+      codes[count] = http_status_code(static_cast<int>(strtol(buffer + 9, nullptr, 10)));
+    }
+    else
+    {
+      codes[count].clear();
+    }
+    buffer = eol + 1;
+    count++;
+  }
+  return count;
+}
+
+template <class F> static double measure(const char *name, const char *unit, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / LINES;
+  printf("%s: %f ns per %s (%zu)\n", name, ret, unit, sink);
+  return ret;
+}
+
+int main()
+{
+  const std::string sample = make_sample();
+  std::vector<http_status_code> codes(LINES);
+  measure("naive parse", "status line", [&] { return naive_parse(codes.data(), codes.size(), sample.data(), sample.size()); });
+  measure("parse_http_status_lines", "status line", [&] { return parse_http_status_lines(codes.data(), codes.size(), sample.data(), sample.size()); });
+  measure("is_http_*() classification", "code", [&] {
+    size_t ret = 0;
+    for(const auto &c : codes)
+    {
+      ret += c.is_http_success() + c.is_http_redirection() * 2 + c.is_http_client_error() * 3 + c.is_http_server_error() * 4;
+    }
+    return ret;
+  });
+  measure("generic code mapping", "code", [&] {
+    size_t ret = 0;
+    for(const auto &c : codes)
+    {
+      ret += (c == errc::no_such_file_or_directory);
+    }
+    return ret;
+  });
+  measure("message()", "code", [&] {
+    size_t ret = 0;
+    for(const auto &c : codes)
+    {
+      ret += c.message().size();
+    }
+    return ret;
+  });
+  return 0;
+}
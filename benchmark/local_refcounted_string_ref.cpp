@@ -0,0 +1,79 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/system_error2.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifndef ITERATIONS
+#define ITERATIONS 1000000
+#endif
+#ifndef STAGES
+#define STAGES 16
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+using string_ref = status_code_domain::string_ref;
+
+static char *make_text()
+{
+  static constexpr const char text[] = "Bad file descriptor";
+  auto *p = static_cast<char *>(malloc(sizeof(text)));
+  memcpy(p, text, sizeof(text));
+  return p;
+}
+
+// Each message is copied through a pipeline of stages which each keep a copy, as when formatting logs
+template <class T> static double benchmark(const char *name)
+{
+  std::vector<string_ref> stages;
+  stages.reserve(STAGES);
+  volatile size_t sink = 0;
+  auto begin = std::chrono::high_resolution_clock::now();
+  for(size_t n = 0; n < ITERATIONS; n++)
+  {
+    T msg(make_text());
+    for(size_t i = 0; i < STAGES; i++)
+    {
+      stages.push_back(msg);
+    }
+    sink = sink + stages.back().size();
+    stages.clear();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  (void) sink;
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / ITERATIONS / STAGES;
+  printf("%s: %f ns per message copy and destruction\n", name, ret);
+  return ret;
+}
+
+int main()
+{
+  benchmark<status_code_domain::atomic_refcounted_string_ref>("atomic_refcounted_string_ref");
+  benchmark<status_code_domain::local_refcounted_string_ref>("local_refcounted_string_ref");
+  return 0;
+}
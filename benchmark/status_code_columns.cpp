@@ -0,0 +1,153 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+#include "status-code/status_code_columns.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifndef CODES
+#define CODES 1000000
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// A batch of syscall outcomes: mostly successes, some would blocks, and the odd HTTP error
+template <class F> static void make_codes(F &&f)
+{
+  unsigned seed = 78;
+  for(size_t n = 0; n < CODES; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    switch((seed >> 8) % 16)
+    {
+    case 0:
+      f(http_status_code(404));
+      break;
+    case 1:
+    case 2:
+      f(posix_code(EAGAIN));
+      break;
+    case 3:
+      f(http_status_code(200));
+      break;
+    default:
+      f(posix_code(0));
+      break;
+    }
+  }
+}
+
+template <class F> static double measure(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s: %f ns per code (%zu)\n", name, ret, sink);
+  return ret;
+}
+
+int main()
+{
+  std::vector<system_code> codes;
+  status_code_columns cols;
+  codes.reserve(CODES);
+  cols.reserve(CODES);
+  make_codes([&](system_code c) { codes.push_back(std::move(c)); });
+  make_codes([&](const compact_code &c) { cols.push_back(c); });
+
+  measure("count failures of std::vector<system_code>", [&] {
+    size_t ret = 0;
+    for(const auto &c : codes)
+    {
+      ret += c.failure();
+    }
+    return ret;
+  });
+  measure("status_code_columns::count_failures()", [&] { return cols.count_failures(); });
+
+  measure("group by domain of std::vector<system_code>", [&] {
+    struct group
+    {
+      const status_code_domain *domain;
+      size_t count;
+    };
+    std::vector<group> groups;
+    for(const auto &c : codes)
+    {
+      size_t n = 0;
+      while(n < groups.size() && *groups[n].domain != c.domain())
+      {
+        n++;
+      }
+      if(n == groups.size())
+      {
+        groups.push_back({&c.domain(), 0});
+      }
+      groups[n].count++;
+    }
+    size_t ret = 0;
+    for(const auto &g : groups)
+    {
+      ret += g.count;
+    }
+    return ret;
+  });
+  measure("status_code_columns::group_by_domain()", [&] {
+    size_t ret = 0;
+    for(const auto &g : cols.group_by_domain())
+    {
+      ret += g.count;
+    }
+    return ret;
+  });
+  measure("status_code_columns::histogram_by_errc()", [&] { return cols.histogram_by_errc()[errc::resource_unavailable_try_again]; });
+
+  // Make the only failure the last code, so the whole batch is scanned
+  codes.back() = posix_code(EIO);
+  status_code_columns late;
+  late.reserve(CODES);
+  for(size_t n = 0; n < CODES - 1; n++)
+  {
+    late.push_back(posix_code(0));
+  }
+  late.push_back(posix_code(EIO));
+  for(size_t n = 0; n < CODES - 1; n++)
+  {
+    codes[n] = posix_code(0);
+  }
+  measure("first failure of std::vector<system_code>", [&] {
+    size_t n = 0;
+    while(n < codes.size() && !codes[n].failure())
+    {
+      n++;
+    }
+    return n;
+  });
+  measure("status_code_columns::first_failure()", [&] { return late.first_failure(); });
+  return 0;
+}
@@ -0,0 +1,121 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/exact_hash.hpp"
+#include "status-code/http_status_code.hpp"
+#include "status-code/status_code_flat_map.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#ifndef CODES
+#define CODES 1000000
+#endif
+#ifndef DISTINCT
+#define DISTINCT 1000  // distinct codes, as error metrics might see
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// The hash and equality a user would write for themselves
+struct hand_hash
+{
+  size_t operator()(const trivial_system_code &c) const noexcept
+  {
+    return std::hash<unsigned long long>()(c.empty() ? 0 : c.domain().id()) ^ std::hash<intptr_t>()(c.value());
+  }
+};
+struct hand_equal
+{
+  bool operator()(const trivial_system_code &a, const trivial_system_code &b) const noexcept
+  {
+    return a.empty() ? b.empty() : (!b.empty() && a.domain() == b.domain() && a.value() == b.value());
+  }
+};
+
+static std::vector<trivial_system_code> make_codes()
+{
+  std::vector<trivial_system_code> ret;
+  ret.reserve(CODES);
+  unsigned seed = 78;
+  for(size_t n = 0; n < CODES; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    const int value = static_cast<int>((seed >> 8) % (DISTINCT / 2));
+    ret.push_back(((seed >> 24) & 1) ? trivial_system_code(posix_code(value)) : trivial_system_code(http_status_code(value)));
+  }
+  return ret;
+}
+
+template <class F> static double measure(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s: %f ns per code (%zu)\n", name, ret, sink);
+  return ret;
+}
+
+// Counts each code, then looks each up again
+template <class Map> static void run(const char *name, const std::vector<trivial_system_code> &codes)
+{
+  char buffer[256];
+  Map map;
+  snprintf(buffer, sizeof(buffer), "%s count", name);
+  measure(buffer, [&] {
+    for(const auto &c : codes)
+    {
+      map[c]++;
+    }
+    return map.size();
+  });
+  snprintf(buffer, sizeof(buffer), "%s lookup", name);
+  measure(buffer, [&] {
+    size_t ret = 0;
+    for(const auto &c : codes)
+    {
+      ret += map.find(c) != map.end();
+    }
+    return ret;
+  });
+}
+
+// status_code_flat_map::find() returns a pointer rather than an iterator
+template <class Map> struct flat_map_adapter : Map
+{
+  const typename Map::mapped_type *end() const noexcept { return nullptr; }
+};
+
+int main()
+{
+  const std::vector<trivial_system_code> codes = make_codes();
+  run<std::unordered_map<trivial_system_code, size_t, hand_hash, hand_equal>>("std::unordered_map with hand written hash", codes);
+  run<std::unordered_map<trivial_system_code, size_t, exact_hash, exact_equal>>("std::unordered_map with exact_hash", codes);
+  run<flat_map_adapter<status_code_flat_map<size_t>>>("status_code_flat_map", codes);
+  run<flat_map_adapter<status_code_flat_map<size_t, generic_key>>>("status_code_flat_map with generic_key", codes);
+  return 0;
+}
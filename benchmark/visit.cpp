@@ -0,0 +1,133 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/system_code.hpp"
+#include "status-code/visit.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifndef CODES
+#define CODES 10000000
+#endif
+#ifndef SAMPLE
+#define SAMPLE 1024  // small enough to stay in cache, so the dispatch is measured rather than memory
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// As many distinct domains as wanted, each of which is otherwise the generic domain
+template <size_t N> class bench_domain : public _generic_code_domain
+{
+public:
+  constexpr bench_domain() noexcept
+      : _generic_code_domain(0x5b1dd2f6c3a8e471ull + N * 0x9e3779b97f4a7c15ull)
+  {
+  }
+  static const bench_domain &get()
+  {
+    static const bench_domain v;
+    return v;
+  }
+};
+template <size_t N> using bench_code = status_code<bench_domain<N>>;
+
+struct handler
+{
+  template <size_t N> size_t operator()(const bench_code<N> &c) const { return N + static_cast<size_t>(c.value()); }
+  size_t operator()(const status_code<void> & /*unused*/) const { return 0; }
+};
+
+// What callers write today: compare the domain with each candidate's in turn
+template <size_t N, size_t Count> struct if_chain
+{
+  static size_t invoke(const status_code<void> &sc)
+  {
+    if(sc.domain() == bench_domain<N>::get())
+    {
+      return handler()(static_cast<const bench_code<N> &>(sc));
+    }
+    return if_chain<N + 1, Count>::invoke(sc);
+  }
+};
+template <size_t Count> struct if_chain<Count, Count>
+{
+  static size_t invoke(const status_code<void> &sc) { return handler()(sc); }
+};
+
+template <size_t... I> static std::vector<system_code> make_sample(detail::index_sequence<I...> /*unused*/)
+{
+  using maker = system_code (*)(errc);
+  static const maker makers[] = {[](errc v) -> system_code { return bench_code<I>(v); }...};
+  std::vector<system_code> ret;
+  ret.reserve(SAMPLE);
+  unsigned seed = 78;
+  for(size_t n = 0; n < SAMPLE; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    ret.push_back(makers[(seed >> 8) % sizeof...(I)](errc::timed_out));
+  }
+  return ret;
+}
+
+template <class F> static double measure(const char *name, size_t count, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s with %zu domains: %f ns per code (%zu)\n", name, count, ret, sink);
+  return ret;
+}
+
+// Codes are spread evenly over the candidate domains, so an if-chain makes half as many compares as there are candidates
+template <size_t... I> static void compare(detail::index_sequence<I...> seq)
+{
+  const std::vector<system_code> sample = make_sample(seq);
+  measure("if-chain", sizeof...(I), [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += if_chain<0, sizeof...(I)>::invoke(sample[n % SAMPLE]);
+    }
+    return ret;
+  });
+  measure("visit()", sizeof...(I), [&] {
+    size_t ret = 0;
+    for(size_t n = 0; n < CODES; n++)
+    {
+      ret += visit<bench_code<I>...>(sample[n % SAMPLE], handler());
+    }
+    return ret;
+  });
+}
+
+int main()
+{
+  compare(detail::make_index_sequence<2>::type());
+  compare(detail::make_index_sequence<8>::type());
+  compare(detail::make_index_sequence<32>::type());
+  return 0;
+}
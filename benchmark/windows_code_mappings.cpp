@@ -0,0 +1,121 @@
+/* Benchmarks
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/windows_code_mappings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#ifndef CODES
+#define CODES 1000000
+#endif
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+using nt_win32 = detail::nt_code_to_win32_code_source<>;
+
+// Codes as they might arrive in telemetry from Windows machines: mostly mapped, some not
+static std::vector<uint32_t> make_sample()
+{
+  std::vector<uint32_t> ret;
+  ret.reserve(CODES);
+  unsigned seed = 78;
+  for(size_t n = 0; n < CODES; n++)
+  {
+    seed = seed * 1103515245 + 12345;
+    const unsigned pick = seed >> 8;
+    ret.push_back((pick % 10 == 0) ? (0xc0000000 | (pick & 0xffff)) : nt_win32::entries[pick % nt_win32::count].code);
+  }
+  return ret;
+}
+
+template <class F> static double measure(const char *name, F &&f)
+{
+  auto begin = std::chrono::high_resolution_clock::now();
+  const size_t sink = f();
+  auto end = std::chrono::high_resolution_clock::now();
+  const double ret = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()) / CODES;
+  printf("%s: %f ns per code (%zu)\n", name, ret, sink);
+  return ret;
+}
+
+int main()
+{
+  const std::vector<uint32_t> sample = make_sample();
+  // What one might write without the mappings being usable outside the Windows domains
+  std::unordered_map<uint32_t, uint32_t> map;
+  for(const auto &e : nt_win32::entries)
+  {
+    map.emplace(e.code, e.win32);
+  }
+  printf("Tables: %zu bytes NT to Win32, %zu bytes NT to errc, %zu bytes Win32 to errc\n", sizeof(nt_win32::entries),
+         sizeof(detail::nt_code_to_errc_source<>::entries), sizeof(detail::win32_code_to_errc_source<>::entries));
+  measure("std::unordered_map NT to Win32", [&] {
+    size_t ret = 0;
+    for(const auto c : sample)
+    {
+      auto it = map.find(c);
+      ret += (it != map.end()) ? it->second : static_cast<uint32_t>(-1);
+    }
+    return ret;
+  });
+  measure("std::lower_bound NT to Win32", [&] {
+    size_t ret = 0;
+    for(const auto c : sample)
+    {
+      auto it = std::lower_bound(std::begin(nt_win32::entries), std::end(nt_win32::entries), c,
+                                 [](const detail::nt_code_to_win32_code_entry &e, uint32_t v) { return e.code < v; });
+      ret += (it != std::end(nt_win32::entries) && it->code == c) ? it->win32 : static_cast<uint32_t>(-1);
+    }
+    return ret;
+  });
+  measure("win32_code_from_nt_code()", [&] {
+    size_t ret = 0;
+    for(const auto c : sample)
+    {
+      ret += win32_code_from_nt_code(c);
+    }
+    return ret;
+  });
+  measure("errc_from_nt_code()", [&] {
+    size_t ret = 0;
+    for(const auto c : sample)
+    {
+      ret += static_cast<size_t>(errc_from_nt_code(c));
+    }
+    return ret;
+  });
+  measure("errc_from_win32_code()", [&] {
+    size_t ret = 0;
+    for(const auto c : sample)
+    {
+      ret += static_cast<size_t>(errc_from_win32_code(c & 0xffff));
+    }
+    return ret;
+  });
+  return 0;
+}
@@ -0,0 +1,395 @@
+/* Sampled backtrace capture for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_BACKTRACED_STATUS_CODE_HPP
+#define SYSTEM_ERROR2_BACKTRACED_STATUS_CODE_HPP
+
+#include "nested_status_code.hpp"
+#include "system_code.hpp"
+
+#ifndef SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES
+//! The maximum number of return addresses captured into a backtraced status code. Can be overriden via predefinition.
+#define SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES 16
+#endif
+
+#ifndef SYSTEM_ERROR2_HAVE_EXECINFO
+#if !defined(SYSTEM_ERROR2_NOT_POSIX) && defined(__has_include)
+#if __has_include(<execinfo.h>)
+#define SYSTEM_ERROR2_HAVE_EXECINFO 1
+#endif
+#endif
+#ifndef SYSTEM_ERROR2_HAVE_EXECINFO
+#define SYSTEM_ERROR2_HAVE_EXECINFO 0
+#endif
+#endif
+#if SYSTEM_ERROR2_HAVE_EXECINFO
+#include <execinfo.h>  // for backtrace, backtrace_symbols
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+#if defined(_WIN32) && !SYSTEM_ERROR2_HAVE_EXECINFO
+//! \exclude
+namespace win32
+{
+  // Used to capture the return addresses of the calling thread
+  extern unsigned short __stdcall RtlCaptureStackBackTrace(unsigned long FramesToSkip, unsigned long FramesToCapture, void **BackTrace,
+                                                          unsigned long *BackTraceHash);
+#if(defined(__x86_64__) || defined(_M_X64)) || (defined(__aarch64__) || defined(_M_ARM64))
+#pragma comment(linker, "/alternatename:?RtlCaptureStackBackTrace@win32@system_error2@@YAGKKPEAPEAXPEAK@Z=RtlCaptureStackBackTrace")
+#elif defined(__x86__) || defined(_M_IX86) || defined(__i386__)
+#pragma comment(linker, "/alternatename:?RtlCaptureStackBackTrace@win32@system_error2@@YGGKKPAPAXPAK@Z=_RtlCaptureStackBackTrace@16")
+#elif defined(__arm__) || defined(_M_ARM)
+#pragma comment(linker, "/alternatename:?RtlCaptureStackBackTrace@win32@system_error2@@YAGKKPAPAXPAK@Z=RtlCaptureStackBackTrace")
+#else
+#error Unknown architecture
+#endif
+}  // namespace win32
+#endif
+
+/*! The raw return addresses captured when a backtraced status code was sampled.
+
+These are not symbolised until `message()` is called on the status code, and
+can be written out as-is for offline symbolisation.
+*/
+struct status_code_backtrace
+{
+  //! The number of valid entries in `frames`
+  size_t count{0};
+  //! The raw return addresses, innermost first
+  void *frames[SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES]{};
+
+  //! The number of frames captured
+  constexpr size_t size() const noexcept { return count; }
+  //! True if no frames were captured
+  SYSTEM_ERROR2_NODISCARD constexpr bool empty() const noexcept { return count == 0; }
+  //! Iterator to the first frame
+  constexpr void *const *begin() const noexcept { return frames; }
+  //! Iterator to after the last frame
+  constexpr void *const *end() const noexcept { return frames + count; }
+};
+
+namespace detail
+{
+  inline std::atomic<unsigned> &backtrace_sampling_period_storage() noexcept
+  {
+    static std::atomic<unsigned> v(0);
+    return v;
+  }
+  // The unsampled path costs one relaxed load and one thread local increment
+  inline bool sample_backtrace() noexcept
+  {
+    static thread_local unsigned count;
+    const unsigned period = backtrace_sampling_period_storage().load(std::memory_order_relaxed);
+    if(period == 0 || ++count < period)
+    {
+      return false;
+    }
+    count = 0;
+    return true;
+  }
+  inline size_t capture_backtrace(void **frames, size_t max) noexcept
+  {
+#if SYSTEM_ERROR2_HAVE_EXECINFO && !SYSTEM_ERROR2_REALTIME
+    // glibc's backtrace() may load the unwinder upon first use, so is not real-time safe
+    const int ret = ::backtrace(frames, static_cast<int>(max));
+    return (ret > 0) ? static_cast<size_t>(ret) : 0;
+#elif defined(_WIN32)
+    return win32::RtlCaptureStackBackTrace(0, static_cast<unsigned long>(max), frames, nullptr);
+#else
+    (void) frames;
+    (void) max;
+    return 0;
+#endif
+  }
+  // Writes "0x" followed by the hexadecimal address, returns characters written (always 2 + 2 * sizeof(void *))
+  inline size_t format_frame_address(char *buffer, const void *addr) noexcept
+  {
+    static constexpr const char hex[] = "0123456789abcdef";
+    auto v = reinterpret_cast<uintptr_t>(addr);  // NOLINT
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    for(size_t n = 0; n < 2 * sizeof(void *); n++)
+    {
+      buffer[2 + n] = hex[(v >> ((2 * sizeof(void *) - 1 - n) * 4)) & 0xf];
+    }
+    return 2 + 2 * sizeof(void *);
+  }
+  /* Renders the message of a status code followed by one line per frame. Symbols are
+  looked up here, and not when the backtrace was captured.
+  */
+  inline status_code_domain::string_ref render_backtrace_message(const status_code_domain::string_ref &msg, const status_code_backtrace &bt) noexcept
+  {
+    static constexpr const char header[] = "\nBacktrace:";
+#if SYSTEM_ERROR2_HAVE_EXECINFO
+    char **symbols = ::backtrace_symbols(bt.frames, static_cast<int>(bt.count));
+#else
+    char **symbols = nullptr;
+#endif
+    size_t length = msg.size() + sizeof(header) - 1;
+    for(size_t n = 0; n < bt.count; n++)
+    {
+      length += 3 + ((symbols != nullptr) ? strlen(symbols[n]) : (2 + 2 * sizeof(void *)));  // NOLINT
+    }
+    auto *p = static_cast<char *>(malloc(length + 1));  // NOLINT
+    if(p == nullptr)
+    {
+      free(symbols);  // NOLINT
+      return status_code_domain::string_ref("failed to get message from system");
+    }
+    char *out = p;
+    memcpy(out, msg.data(), msg.size());
+    out += msg.size();
+    memcpy(out, header, sizeof(header) - 1);
+    out += sizeof(header) - 1;
+    for(size_t n = 0; n < bt.count; n++)
+    {
+      *out++ = '\n';
+      *out++ = ' ';
+      *out++ = ' ';
+      if(symbols != nullptr)
+      {
+        const size_t len = strlen(symbols[n]);  // NOLINT
+        memcpy(out, symbols[n], len);
+        out += len;
+      }
+      else
+      {
+        out += format_frame_address(out, bt.frames[n]);
+      }
+    }
+    *out = 0;
+    free(symbols);  // NOLINT
+    return status_code_domain::atomic_refcounted_string_ref(p, length);
+  }
+  // As `render_backtrace_message()`, but without allocating, so frames are rendered as addresses only
+  inline size_t render_backtrace_message_into(const status_code<void> &code, const status_code_backtrace &bt, char *buffer, size_t length) noexcept
+  {
+    static constexpr const char header[] = "\nBacktrace:";
+    message_writer out{buffer, length, 0};
+    out.append(code);
+    out.append(header, sizeof(header) - 1);
+    char frame[3 + 2 + 2 * sizeof(void *)] = {'\n', ' ', ' '};
+    for(size_t n = 0; n < bt.count; n++)
+    {
+      out.append(frame, 3 + format_frame_address(frame + 3, bt.frames[n]));
+    }
+    return out.written;
+  }
+}  // namespace detail
+
+//! A status code carrying the status code `StatusCode` plus the backtrace captured when it was made.
+template <class StatusCode> using backtraced_status_code = status_code<detail::backtraced_domain<StatusCode>>;
+
+namespace detail
+{
+  /* The domain of a status code which wraps another status code, adding a backtrace.
+  Codes of this domain are only ever constructed when sampled, and are then shoehorned
+  into a `system_code` using `make_nested_status_code()`.
+  */
+  template <class StatusCode> class backtraced_domain : public status_code_domain
+  {
+    template <class DomainType> friend class status_code;
+    template <class StatusCode_, class Allocator> friend class indirecting_domain;
+    using _base = status_code_domain;
+    using _mycode = status_code<backtraced_domain>;
+
+  public:
+    //! The value type of the backtraced code, which is the original code plus the raw return addresses
+    struct value_type
+    {
+      //! The original status code
+      StatusCode code;
+      //! The return addresses captured at construction
+      status_code_backtrace backtrace;
+    };
+    using _base::string_ref;
+
+    constexpr backtraced_domain() noexcept
+        : _base(0x8e0b4f2ad1c76a35 ^ typename StatusCode::domain_type().id() /* unique-ish based on domain's unique id */)
+    {
+    }
+    backtraced_domain(const backtraced_domain &) = default;
+    backtraced_domain(backtraced_domain &&) = default;  // NOLINT
+    backtraced_domain &operator=(const backtraced_domain &) = default;
+    backtraced_domain &operator=(backtraced_domain &&) = default;  // NOLINT
+    ~backtraced_domain() = default;
+
+#if __cplusplus < 201402L && !defined(_MSC_VER)
+    static inline const backtraced_domain &get()
+    {
+      static backtraced_domain v;
+      return v;
+    }
+#else
+    static inline constexpr const backtraced_domain &get();
+#endif
+
+    virtual string_ref name() const noexcept override { return typename StatusCode::domain_type().name(); }  // NOLINT
+
+    virtual payload_info_t payload_info() const noexcept override
+    {
+      return {sizeof(value_type), sizeof(status_code_domain *) + sizeof(value_type),
+              (alignof(value_type) > alignof(status_code_domain *)) ? alignof(value_type) : alignof(status_code_domain *)};
+    }
+
+  protected:
+    virtual bool _do_failure(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      return static_cast<const _mycode &>(code).value().code.failure();  // NOLINT
+    }
+    virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override  // NOLINT
+    {
+      assert(code1.domain() == *this);
+      const auto &c1 = static_cast<const _mycode &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        const auto &c2 = static_cast<const _mycode &>(code2);  // NOLINT
+        return c1.value().code.strictly_equivalent(c2.value().code);
+      }
+      return c1.value().code.strictly_equivalent(code2);
+    }
+    virtual generic_code _generic_code(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code).value().code;  // NOLINT
+      return static_cast<const status_code_domain &>(c.domain())._generic_code(c);
+    }
+    virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code).value().code;  // NOLINT
+      return static_cast<const status_code_domain &>(c.domain())._do_matches(c, set);
+    }
+    virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &v = static_cast<const _mycode &>(code).value();  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+      // Symbolising the backtrace allocates, use message_into() for the addresses
+      return v.code.message();
+#else
+      return render_backtrace_message(v.code.message(), v.backtrace);
+#endif
+    }
+    virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &v = static_cast<const _mycode &>(code).value();  // NOLINT
+      return render_backtrace_message_into(v.code, v.backtrace, buffer, length);
+    }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      static_cast<const _mycode &>(code).value().code.throw_exception();  // NOLINT
+      abort();                                                            // suppress buggy GCC warning
+    }
+#endif
+  };
+#if __cplusplus >= 201402L || defined(_MSC_VER)
+  template <class StatusCode> constexpr backtraced_domain<StatusCode> _backtraced_domain{};
+  template <class StatusCode> inline constexpr const backtraced_domain<StatusCode> &backtraced_domain<StatusCode>::get()
+  {
+    return _backtraced_domain<StatusCode>;
+  }
+#endif
+
+  template <class T, class Alloc> inline system_code erase_or_nest(T &&v, Alloc && /*unused*/, std::true_type /*erasable*/) noexcept
+  {
+    return system_code(static_cast<T &&>(v));
+  }
+  template <class T, class Alloc> inline system_code erase_or_nest(T &&v, Alloc &&alloc, std::false_type /*erasable*/)
+  {
+    return make_nested_status_code(static_cast<T &&>(v), static_cast<Alloc &&>(alloc));
+  }
+}  // namespace detail
+
+//! Sets the backtrace sampling period: zero never captures, one captures every time, `N` captures one in every `N` per thread.
+inline void set_backtrace_sampling_period(unsigned period) noexcept
+{
+  detail::backtrace_sampling_period_storage().store(period, std::memory_order_relaxed);
+}
+//! Returns the backtrace sampling period. Defaults to zero i.e. never capture.
+inline unsigned backtrace_sampling_period() noexcept
+{
+  return detail::backtrace_sampling_period_storage().load(std::memory_order_relaxed);
+}
+
+/*! Make a `system_code` from a status code, capturing a backtrace if sampled.
+
+If this call is not sampled (see `set_backtrace_sampling_period()`), the status
+code is type erased into the returned `system_code` as normal, or if it will not
+fit, it is nested using `make_nested_status_code()`. The cost above that of
+type erasure is one thread local counter increment.
+
+If this call is sampled, up to `SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES` raw return
+addresses are captured into a `backtraced_status_code<T>`, which is nested using
+`make_nested_status_code()` and `alloc`. The returned code compares, converts and
+throws exactly as the original would. Its `message()` appends the symbolised
+backtrace. Use `get_backtrace()` to retrieve the raw addresses for offline
+symbolisation.
+
+If `SYSTEM_ERROR2_REALTIME` is enabled, `alloc` must not be a `std::allocator`, no
+addresses are captured on platforms where capture may allocate, and `message()`
+does not append the backtrace.
+*/
+SYSTEM_ERROR2_TEMPLATE(class T, class Alloc = std::allocator<typename std::decay<T>::type>)
+SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<T>::value))  //
+inline system_code make_backtraced_status_code(T &&v, Alloc alloc = {})
+{
+  using status_code_type = typename std::decay<T>::type;
+  if(!detail::sample_backtrace())
+  {
+    return detail::erase_or_nest(static_cast<T &&>(v), static_cast<Alloc &&>(alloc),
+                                 std::integral_constant<bool, detail::domain_value_type_erasure_is_safe<detail::erased<typename system_code::value_type>,
+                                                                                              typename status_code_type::domain_type>::value>());
+  }
+  typename detail::backtraced_domain<status_code_type>::value_type bt{static_cast<T &&>(v), {}};
+  bt.backtrace.count = detail::capture_backtrace(bt.backtrace.frames, SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES);
+  using alloc_traits = std::allocator_traits<Alloc>;
+  return make_nested_status_code(backtraced_status_code<status_code_type>(static_cast<decltype(bt) &&>(bt)),
+                                 typename alloc_traits::template rebind_alloc<backtraced_status_code<status_code_type>>(alloc));
+}
+
+/*! If a status code was made by a sampled `make_backtraced_status_code()` from a
+status code of type `StatusCode`, return a pointer to its captured backtrace. Otherwise
+return null.
+*/
+SYSTEM_ERROR2_TEMPLATE(class StatusCode, class U)
+SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<StatusCode>::value))
+inline const status_code_backtrace *get_backtrace(const status_code<detail::erased<U>> &v) noexcept
+{
+  if(v.empty())
+  {
+    return nullptr;
+  }
+  const auto *p = get_if<backtraced_status_code<StatusCode>>(&v);
+  return (p != nullptr) ? &p->value().backtrace : nullptr;
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -71,7 +71,11 @@ class _boost_error_code_domain final : public status_code_domain
   using _error_code_type = boost::system::error_code;
   using _error_category_type = boost::system::error_category;
 
+#if SYSTEM_ERROR2_REALTIME
+  char _name[64];
+#else
   std::string _name;
+#endif
 
   static _base::string_ref _make_string_ref(_error_code_type c) noexcept
   {
@@ -111,10 +115,20 @@ public:
   //! Default constructor
   explicit _boost_error_code_domain(const _error_category_type &category) noexcept
       : _base(0x0ea88ff382d94915 ^ reinterpret_cast<_base::unique_id_type>(&category))
+#if !SYSTEM_ERROR2_REALTIME
       , _name("boost_error_code_domain(")
+#endif
   {
+#if SYSTEM_ERROR2_REALTIME
+    // Truncates long category names rather than allocate
+    detail::message_writer w{_name, sizeof(_name), 0};
+    w.append("boost_error_code_domain(", 24);
+    w.append(category.name(), strlen(category.name()));
+    w.append(")", 1);
+#else
     _name.append(category.name());
     _name.push_back(')');
+#endif
   }
   _boost_error_code_domain(const _boost_error_code_domain &) = default;
   _boost_error_code_domain(_boost_error_code_domain &&) = default;
@@ -124,7 +138,11 @@ public:
 
   static inline const _boost_error_code_domain *get(_error_code_type ec);
 
+#if SYSTEM_ERROR2_REALTIME
+  virtual string_ref name() const noexcept override { return string_ref(_name); }  // NOLINT
+#else
   virtual string_ref name() const noexcept override { return string_ref(_name.c_str(), _name.size()); }  // NOLINT
+#endif
 
   virtual payload_info_t payload_info() const noexcept override
   {
@@ -137,6 +155,7 @@ protected:
   virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override;
   virtual generic_code _generic_code(const status_code<void> &code) const noexcept override;
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override;
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override;
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override;
 #endif
@@ -149,7 +168,10 @@ namespace detail
     static constexpr size_t max_items = 64;
     static struct storage_t
     {
-      std::atomic<unsigned> _lock;
+      // Each item is empty (0), being constructed (1) or ready (2). Items are claimed with
+      // compare-exchange, so looking up a category already added never waits. Only a thread
+      // which meets an item still being constructed waits for it, as it may be the same category.
+      std::atomic<unsigned> states[max_items];
       union item_t
       {
         int _init;
@@ -160,43 +182,48 @@ namespace detail
         }
         ~item_t() {}
       } items[max_items];
-      size_t count{0};
 
-      void lock()
+      storage_t()
       {
-        while(_lock.exchange(1, std::memory_order_acquire) != 0)
-          ;
+        for(auto &state : states)
+        {
+          state.store(0, std::memory_order_relaxed);
+        }
       }
-      void unlock() { _lock.store(0, std::memory_order_release); }
-
-      storage_t() {}
       ~storage_t()
       {
-        lock();
-        for(size_t n = 0; n < count; n++)
+        for(size_t n = 0; n < max_items; n++)
         {
-          items[n].domain.~_boost_error_code_domain();
+          if(states[n].load(std::memory_order_acquire) == 2)
+          {
+            items[n].domain.~_boost_error_code_domain();
+          }
         }
-        unlock();
       }
       _boost_error_code_domain *add(const boost::system::error_category &category)
       {
-        _boost_error_code_domain *ret = nullptr;
-        lock();
-        for(size_t n = 0; n < count; n++)
+        for(size_t n = 0; n < max_items; n++)
         {
-          if(items[n].domain.error_category() == category)
+          unsigned state = states[n].load(std::memory_order_acquire);
+          if(state == 0)
           {
-            ret = &items[n].domain;
-            break;
+            if(states[n].compare_exchange_strong(state, 1, std::memory_order_acquire))
+            {
+              auto *ret = new(&items[n].domain) _boost_error_code_domain(category);
+              states[n].store(2, std::memory_order_release);
+              return ret;
+            }
+          }
+          while(state == 1)
+          {
+            state = states[n].load(std::memory_order_acquire);
+          }
+          if(state == 2 && items[n].domain.error_category() == category)
+          {
+            return &items[n].domain;
           }
         }
-        if(ret == nullptr && count < max_items)
-        {
-          ret = new(&items[count++].domain) _boost_error_code_domain(category);
-        }
-        unlock();
-        return ret;
+        return nullptr;
       }
     } storage;
     return storage.add(category);
@@ -299,7 +326,43 @@ inline _boost_error_code_domain::string_ref _boost_error_code_domain::_do_messag
 {
   assert(code.domain() == *this);
   const auto &c = static_cast<const boost_error_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+  // The category's message() returns a std::string, so only the generic message is available
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  if(c.category() == boost::system::generic_category() || c.category() == boost::system::system_category())
+  {
+    return detail::generic_code_message_ref(static_cast<errc>(c.value()));
+  }
+#endif
+  return detail::generic_code_message_ref(_generic_code(code).value());
+#else
   return _make_string_ref(_error_code_type(c.value(), c.category()));
+#endif
+}
+
+inline size_t _boost_error_code_domain::_do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept
+{
+  assert(code.domain() == *this);
+  const auto &c = static_cast<const boost_error_code &>(code);  // NOLINT
+  // The generic and system categories yield the system's own messages, which we can fetch without allocating
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  if(c.category() == boost::system::generic_category())
+  {
+    return posix_code(c.value()).message_into(buffer, length);
+  }
+#endif
+#ifdef _WIN32
+  if(c.category() == boost::system::system_category())
+  {
+    return win32_code((win32::DWORD) c.value()).message_into(buffer, length);
+  }
+#elif !defined(SYSTEM_ERROR2_NOT_POSIX)
+  if(c.category() == boost::system::system_category())
+  {
+    return posix_code(c.value()).message_into(buffer, length);
+  }
+#endif
+  return _base::_do_message_into(code, buffer, length);
 }
 
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
@@ -0,0 +1,502 @@
+/* Causal chains of SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_CHAINED_STATUS_CODE_HPP
+#define SYSTEM_ERROR2_CHAINED_STATUS_CODE_HPP
+
+#include "system_code.hpp"
+
+#include <iterator>  // for reverse_iterator
+
+#ifndef SYSTEM_ERROR2_CHAIN_MAX_DEPTH
+//! The maximum number of links retained in a status code chain. Can be overriden via predefinition, must be at least two.
+#define SYSTEM_ERROR2_CHAIN_MAX_DEPTH 16
+#endif
+
+#ifndef SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS
+//! The number of chain blocks statically preallocated when `SYSTEM_ERROR2_REALTIME` is enabled. Can be overriden via predefinition.
+#define SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS 64
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  static_assert(SYSTEM_ERROR2_CHAIN_MAX_DEPTH >= 2, "SYSTEM_ERROR2_CHAIN_MAX_DEPTH must be at least two");
+
+  /* A chain is a single reference counted block of `system_code`, ordered from the root
+  cause outwards. Blocks are immutable once shared, so copying a chained status code
+  merely increments the reference count.
+  */
+  struct chain_block
+  {
+    mutable std::atomic<unsigned> count;
+    unsigned size;
+    unsigned capacity;
+    size_t omitted;
+
+    system_code *links() noexcept { return reinterpret_cast<system_code *>(this + 1); }              // NOLINT
+    const system_code *links() const noexcept { return reinterpret_cast<const system_code *>(this + 1); }  // NOLINT
+  };
+  static_assert(sizeof(chain_block) % alignof(system_code) == 0, "chain_block header would misalign its links");
+
+#if SYSTEM_ERROR2_REALTIME
+  /* In real-time configuration blocks come from a static pool, all of them with room
+  for the maximum depth of chain, and are claimed with compare-exchange.
+  */
+  struct chain_block_pool
+  {
+    static constexpr size_t block_size = sizeof(chain_block) + SYSTEM_ERROR2_CHAIN_MAX_DEPTH * sizeof(system_code);
+    std::atomic<bool> used[SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS];
+    alignas(chain_block) alignas(system_code) char blocks[SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS][block_size];
+  };
+  inline chain_block_pool &get_chain_block_pool() noexcept
+  {
+    static chain_block_pool pool;  // zero initialised, so no guard is needed
+    return pool;
+  }
+  inline chain_block *allocate_chain_block(unsigned /*unused*/) noexcept
+  {
+    chain_block_pool &pool = get_chain_block_pool();
+    for(size_t n = 0; n < SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS; n++)
+    {
+      bool expected = false;
+      if(!pool.used[n].load(std::memory_order_relaxed) && pool.used[n].compare_exchange_strong(expected, true, std::memory_order_acquire))
+      {
+        return new(pool.blocks[n]) chain_block{{1}, 0, SYSTEM_ERROR2_CHAIN_MAX_DEPTH, 0};
+      }
+    }
+    return nullptr;
+  }
+  inline void free_chain_block(chain_block *p) noexcept
+  {
+    chain_block_pool &pool = get_chain_block_pool();
+    const auto n = static_cast<size_t>(reinterpret_cast<char *>(p) - pool.blocks[0]) / chain_block_pool::block_size;  // NOLINT
+    pool.used[n].store(false, std::memory_order_release);
+  }
+#else
+  inline chain_block *allocate_chain_block(unsigned capacity) noexcept
+  {
+    auto *p = static_cast<chain_block *>(malloc(sizeof(chain_block) + capacity * sizeof(system_code)));  // NOLINT
+    if(p != nullptr)
+    {
+      new(p) chain_block{{1}, 0, capacity, 0};
+    }
+    return p;
+  }
+  inline void free_chain_block(chain_block *p) noexcept { free(p); }  // NOLINT
+#endif
+  inline void release_chain_block(const chain_block *p) noexcept
+  {
+    if(1 == p->count.fetch_sub(1, std::memory_order_release))
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      auto *mp = const_cast<chain_block *>(p);  // NOLINT
+      for(unsigned n = 0; n < mp->size; n++)
+      {
+        mp->links()[n].~system_code();
+      }
+      mp->~chain_block();
+      free_chain_block(mp);
+    }
+  }
+}  // namespace detail
+
+/*! A non-owning view of the links of a chained status code, iterating from the
+outermost failure inwards to the root cause.
+*/
+class status_code_chain
+{
+  const system_code *_begin{nullptr}, *_end{nullptr};
+  size_t _omitted{0};
+
+public:
+  //! The iterator type, which iterates from the outermost failure to the root cause
+  using const_iterator = std::reverse_iterator<const system_code *>;
+  //! The iterator type
+  using iterator = const_iterator;
+
+  //! Constructs an empty chain
+  constexpr status_code_chain() noexcept {}
+  //! Constructs a chain over the links `[begin, end)`, ordered from the root cause outwards
+  constexpr status_code_chain(const system_code *begin, const system_code *end, size_t omitted = 0) noexcept
+      : _begin(begin)
+      , _end(end)
+      , _omitted(omitted)
+  {
+  }
+
+  //! True if there are no links
+  SYSTEM_ERROR2_NODISCARD constexpr bool empty() const noexcept { return _begin == _end; }
+  //! The number of links retained
+  constexpr size_t size() const noexcept { return static_cast<size_t>(_end - _begin); }
+  //! The number of links between the root cause and the next outermost which were discarded to bound the depth
+  constexpr size_t omitted() const noexcept { return _omitted; }
+  //! The outermost failure
+  const system_code &outermost() const noexcept { return _end[-1]; }
+  //! The root cause
+  constexpr const system_code &root_cause() const noexcept { return *_begin; }
+  //! Iterator to the outermost failure
+  const_iterator begin() const noexcept { return const_iterator(_end); }
+  //! Iterator to after the root cause
+  const_iterator end() const noexcept { return const_iterator(_begin); }
+};
+
+namespace detail
+{
+  /* The domain of a chain of status codes. Its value is a pointer to a `chain_block`,
+  and it only ever exists type erased into a `system_code`.
+  */
+  class chain_domain : public status_code_domain
+  {
+    template <class DomainType> friend class status_code;
+    using _base = status_code_domain;
+
+  public:
+    using value_type = const chain_block *;
+    using _base::string_ref;
+
+    constexpr chain_domain() noexcept
+        : _base(0x6c1e29f3a0b8d457)
+    {
+    }
+    chain_domain(const chain_domain &) = default;
+    chain_domain(chain_domain &&) = default;  // NOLINT
+    chain_domain &operator=(const chain_domain &) = default;
+    chain_domain &operator=(chain_domain &&) = default;  // NOLINT
+    ~chain_domain() = default;
+
+    static inline constexpr const chain_domain &get();
+
+    virtual string_ref name() const noexcept override { return string_ref("chained domain"); }  // NOLINT
+
+    virtual payload_info_t payload_info() const noexcept override
+    {
+      return {sizeof(value_type), sizeof(status_code_domain *) + sizeof(value_type),
+              (alignof(value_type) > alignof(status_code_domain *)) ? alignof(value_type) : alignof(status_code_domain *)};
+    }
+
+    //! Returns the chain within a code of this domain
+    static status_code_chain chain(const status_code<void> &code) noexcept
+    {
+      const chain_block *p = static_cast<const status_code<chain_domain> &>(code).value();  // NOLINT
+      return {p->links(), p->links() + p->size, p->omitted};
+    }
+
+  protected:
+    // Writes "(N links omitted)", returns characters written
+    static size_t _format_omitted(char (&buffer)[40], size_t omitted) noexcept
+    {
+      static constexpr const char suffix[] = " links omitted)";
+      char digits[24];
+      size_t ndigits = 0, len = 1;
+      for(size_t v = omitted; v > 0; v /= 10)
+      {
+        digits[ndigits++] = static_cast<char>('0' + (v % 10));
+      }
+      buffer[0] = '(';
+      while(ndigits > 0)
+      {
+        buffer[len++] = digits[--ndigits];
+      }
+      memcpy(buffer + len, suffix, sizeof(suffix) - 1);
+      return len + sizeof(suffix) - 1;
+    }
+    virtual bool _do_failure(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      return chain(code).outermost().failure();
+    }
+    virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override  // NOLINT
+    {
+      assert(code1.domain() == *this);  // NOLINT
+      for(const auto &link : chain(code1))
+      {
+        if(link.equivalent(code2))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    virtual generic_code _generic_code(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      // The outermost link with a generic mapping determines the mapping of the chain
+      for(const auto &link : chain(code))
+      {
+        generic_code ret = static_cast<const status_code_domain &>(link.domain())._generic_code(link);
+        if(ret.value() != errc::unknown)
+        {
+          return ret;
+        }
+      }
+      return generic_code(errc::unknown);
+    }
+    virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+      // Rendering the whole chain needs an allocation, use message_into() for that
+      return chain(code).outermost().message();
+#else
+      static constexpr const char separator[] = "; caused by: ";
+      const status_code_chain c = chain(code);
+      // string_ref is not default constructible
+      union message_storage
+      {
+        char _uninit;
+        string_ref msg;
+        message_storage() noexcept {}
+        ~message_storage() {}
+      } messages[SYSTEM_ERROR2_CHAIN_MAX_DEPTH];
+      char omittedbuffer[40];
+      size_t omittedlen = 0;
+      size_t length = 0, n = 0;
+      for(const auto &link : c)
+      {
+        new(&messages[n].msg) string_ref(link.message());
+        length += messages[n].msg.size() + ((n > 0) ? sizeof(separator) - 1 : 0);
+        n++;
+      }
+      if(c.omitted() > 0)
+      {
+        omittedlen = _format_omitted(omittedbuffer, c.omitted());
+        length += sizeof(separator) - 1 + omittedlen;
+      }
+      struct message_destroyer
+      {
+        message_storage *messages;
+        size_t n;
+        ~message_destroyer()
+        {
+          for(size_t i = 0; i < n; i++)
+          {
+            messages[i].msg.~string_ref();
+          }
+        }
+      } destroyer{messages, n};
+      auto *p = static_cast<char *>(malloc(length + 1));  // NOLINT
+      if(p == nullptr)
+      {
+        return string_ref("failed to get message from system");
+      }
+      char *out = p;
+      for(size_t i = 0; i < n; i++)
+      {
+        if(i > 0)
+        {
+          memcpy(out, separator, sizeof(separator) - 1);
+          out += sizeof(separator) - 1;
+          if(i == n - 1 && omittedlen > 0)
+          {
+            memcpy(out, omittedbuffer, omittedlen);
+            out += omittedlen;
+            memcpy(out, separator, sizeof(separator) - 1);
+            out += sizeof(separator) - 1;
+          }
+        }
+        memcpy(out, messages[i].msg.data(), messages[i].msg.size());
+        out += messages[i].msg.size();
+      }
+      *out = 0;
+      return atomic_refcounted_string_ref(p, length);
+#endif
+    }
+    virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      static constexpr const char separator[] = "; caused by: ";
+      const status_code_chain c = chain(code);
+      message_writer out{buffer, length, 0};
+      size_t i = 0;
+      for(const auto &link : c)
+      {
+        if(i > 0)
+        {
+          out.append(separator, sizeof(separator) - 1);
+          if(i == c.size() - 1 && c.omitted() > 0)
+          {
+            char omittedbuffer[40];
+            out.append(omittedbuffer, _format_omitted(omittedbuffer, c.omitted()));
+            out.append(separator, sizeof(separator) - 1);
+          }
+        }
+        out.append(link);
+        i++;
+      }
+      return out.written;
+    }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      chain(code).outermost().throw_exception();
+      abort();  // suppress buggy GCC warning
+    }
+#endif
+    virtual bool _do_erased_copy(status_code<void> &dst, const status_code<void> &src, payload_info_t dstinfo) const override  // NOLINT
+    {
+      // Note that dst may not have its domain set
+      const auto srcinfo = payload_info();
+      assert(src.domain() == *this);  // NOLINT
+      if(dstinfo.total_size < srcinfo.total_size)
+      {
+        return false;
+      }
+      const chain_block *p = static_cast<const status_code<chain_domain> &>(src).value();  // NOLINT
+      p->count.fetch_add(1, std::memory_order_relaxed);
+      new(&dst) status_code<chain_domain>(in_place, p);
+      return true;
+    }
+    virtual void _do_erased_destroy(status_code<void> &code, size_t /*unused*/) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);  // NOLINT
+      release_chain_block(static_cast<const status_code<chain_domain> &>(code).value());  // NOLINT
+    }
+  };
+  constexpr chain_domain chain_domain_inst = {};
+  inline constexpr const chain_domain &chain_domain::get()
+  {
+    return chain_domain_inst;
+  }
+
+  // Appends a link to a uniquely owned block, discarding the link above the root cause if full
+  inline void append_chain_link(chain_block *p, system_code &&link) noexcept
+  {
+    system_code *links = p->links();
+    if(p->size == SYSTEM_ERROR2_CHAIN_MAX_DEPTH)
+    {
+      links[1].~system_code();
+      for(unsigned n = 1; n < p->size - 1; n++)
+      {
+        new(&links[n]) system_code(static_cast<system_code &&>(links[n + 1]));
+        links[n + 1].~system_code();
+      }
+      p->size--;
+      p->omitted++;
+    }
+    new(&links[p->size++]) system_code(static_cast<system_code &&>(link));
+  }
+}  // namespace detail
+
+/*! Make a `system_code` recording that `outer` failed because `cause` failed.
+
+If `cause` is itself a chain, `outer` is appended to it: if that chain is not shared
+with any other code, this is done in place without allocating, unless the block needs
+to grow. Otherwise a new block of links is allocated, and the links are cloned into it.
+If `cause` is empty, `outer` is returned as is.
+
+The chain retains at most `SYSTEM_ERROR2_CHAIN_MAX_DEPTH` links. When full, the link
+immediately above the root cause is discarded, so the root cause and the most recent
+failures are always retained.
+
+Copying the returned code increments a reference count only. It compares equivalent
+to anything which any of its links compare equivalent to, is a failure if `outer` is,
+converts to the generic code of its outermost link which has a generic mapping, and
+throws the exception of `outer`. `message()` renders the whole chain, outermost first.
+Use `get_chain()` to walk the links.
+
+Throws `std::bad_alloc` if allocation fails, or if C++ exceptions are disabled, returns
+`outer` without its causes. If `SYSTEM_ERROR2_REALTIME` is enabled, blocks come from a
+static pool of `SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS` instead, `outer` is returned without
+its causes if the pool is exhausted, and `message()` renders the outermost link only.
+*/
+inline system_code make_chained_status_code(system_code outer, system_code cause)
+{
+  using detail::chain_block;
+  using chain_code = status_code<detail::chain_domain>;
+  if(cause.empty())
+  {
+    return outer;
+  }
+  const chain_block *existing = nullptr;
+  if(cause.domain() == detail::chain_domain::get())
+  {
+    existing = static_cast<const chain_code &>(static_cast<const status_code<void> &>(cause)).value();  // NOLINT
+    // If we are the sole owner and there is room, append in place
+    if(existing->count.load(std::memory_order_acquire) == 1 && (existing->size < existing->capacity || existing->size == SYSTEM_ERROR2_CHAIN_MAX_DEPTH))
+    {
+      auto *p = const_cast<chain_block *>(existing);  // NOLINT
+      detail::append_chain_link(p, static_cast<system_code &&>(outer));
+      p->count.fetch_add(1, std::memory_order_relaxed);  // released by cause's destructor
+      return chain_code(in_place, p);
+    }
+  }
+  const unsigned needed = (existing != nullptr) ? existing->size + 1 : 2;
+  unsigned capacity = 4;
+  while(capacity < needed)
+  {
+    capacity *= 2;
+  }
+  if(capacity > SYSTEM_ERROR2_CHAIN_MAX_DEPTH)
+  {
+    capacity = SYSTEM_ERROR2_CHAIN_MAX_DEPTH;
+  }
+  chain_block *p = detail::allocate_chain_block(capacity);
+  if(p == nullptr)
+  {
+#if(defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)) && !SYSTEM_ERROR2_REALTIME
+    throw std::bad_alloc();
+#else
+    return outer;
+#endif
+  }
+  chain_code ret(in_place, p);  // takes ownership, released if anything below throws
+  system_code guard(static_cast<chain_code &&>(ret));
+  if(existing != nullptr)
+  {
+    const bool unique = (existing->count.load(std::memory_order_acquire) == 1);
+    auto *links = const_cast<chain_block *>(existing)->links();  // NOLINT
+    for(unsigned n = 0; n < existing->size; n++)
+    {
+      // Moving links out of a uniquely owned block is safe, as its owner is about to be destroyed
+      new(&p->links()[n]) system_code(unique ? static_cast<system_code &&>(links[n]) : links[n].clone());
+      p->size++;
+    }
+    p->omitted = existing->omitted;
+  }
+  else
+  {
+    new(&p->links()[p->size++]) system_code(static_cast<system_code &&>(cause));
+  }
+  detail::append_chain_link(p, static_cast<system_code &&>(outer));
+  return guard;
+}
+
+/*! Returns a view of the links of `code`, from the outermost failure to the root
+cause. If `code` is not a chain, the view contains `code` alone.
+*/
+inline status_code_chain get_chain(const system_code &code) noexcept
+{
+  if(!code.empty() && code.domain() == detail::chain_domain::get())
+  {
+    return detail::chain_domain::chain(code);
+  }
+  return {&code, &code + 1};
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -221,11 +221,37 @@ protected:
     }
     return generic_code(errc::unknown);
   }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);
     const auto &c = static_cast<const com_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    // Fetching messages from the system may allocate and take locks
+    return detail::generic_code_message_ref(_generic_code(c).value());
+#else
     return _make_string_ref(c.value());
+#endif
+  }
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);
+    const auto &c = static_cast<const com_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    return detail::message_copy(buffer, length, detail::generic_code_message(_generic_code(c).value()));
+#else
+    _com_error ce(c.value(), nullptr);
+#ifdef _UNICODE
+    return detail::win32_message_into(ce.ErrorMessage(), (win32::DWORD) wcslen(ce.ErrorMessage()), buffer, length);
+#else
+    size_t len = strlen(ce.ErrorMessage());
+    while(len > 0 && (ce.ErrorMessage()[len - 1] == 10 || ce.ErrorMessage()[len - 1] == 13))
+    {
+      --len;
+    }
+    return detail::message_copy(buffer, length, ce.ErrorMessage(), len);
+#endif
+#endif
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
@@ -243,6 +269,14 @@ inline constexpr const _com_code_domain &_com_code_domain::get()
   return com_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_com_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 SYSTEM_ERROR2_NAMESPACE_END
 
 #endif
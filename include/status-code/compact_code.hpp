@@ -0,0 +1,394 @@
+/* A compact 8-byte encoding of SG14 status codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_COMPACT_CODE_HPP
+#define SYSTEM_ERROR2_COMPACT_CODE_HPP
+
+#include "system_code.hpp"
+
+#include <atomic>
+#include <cstdint>  // for uint16_t, uint32_t
+
+//! The most domains which `compact_code` can index, which sizes the process-wide registry.
+#ifndef SYSTEM_ERROR2_COMPACT_CODE_MAX_DOMAINS
+#define SYSTEM_ERROR2_COMPACT_CODE_MAX_DOMAINS 256
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+class compact_code;
+class status_code_columns;
+
+namespace detail
+{
+  // True if codes of the domain fit into a compact_code, i.e. they own nothing and their value is no more than 32 bits
+  template <class DomainType, bool = traits::is_trivially_erasable<DomainType>::value> struct compact_code_can_hold
+  {
+    static constexpr bool value = false;
+  };
+  template <class DomainType> struct compact_code_can_hold<DomainType, true>
+  {
+    static constexpr bool value =
+    is_erasure_castable<uint32_t, typename DomainType::value_type>::value && sizeof(typename DomainType::value_type) <= sizeof(uint32_t);
+  };
+  // True if a code of the domain is equivalent to exactly the errc with the same value
+  template <class DomainType> struct compact_code_value_is_errc
+  {
+    static constexpr bool value = false;
+  };
+  template <> struct compact_code_value_is_errc<_generic_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  template <> struct compact_code_value_is_errc<_posix_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+#endif
+
+  template <class DomainType> struct compact_code_domain_functions
+  {
+    using value_type = typename DomainType::value_type;
+    static system_code to_system_code(uint32_t v) noexcept { return status_code<DomainType>(in_place, erasure_cast<value_type>(v)); }
+    static bool equivalent(uint32_t v, errc e) noexcept
+    {
+      return typed_equivalence<DomainType, _generic_code_domain>::equivalent(status_code<DomainType>(in_place, erasure_cast<value_type>(v)), generic_code(e));
+    }
+    static errc generic_errc(uint32_t v) noexcept
+    {
+      const status_code<DomainType> c(in_place, erasure_cast<value_type>(v));
+      return instrumented_dispatch::generic_code_of(c.domain(), c).value();
+    }
+  };
+}  // namespace detail
+
+/*! The process-wide registry which assigns each domain used by `compact_code` a 16-bit index.
+
+Index zero means empty. The generic and POSIX domains (and on Windows, the Win32 and NT domains)
+are registered on first use of the registry, so `system_code`s of those domains can always be
+compacted. Any other domain is registered by the first `compact_code` constructed from a typed
+code of that domain, or explicitly by `index_of<DomainType>()`. Registration is thread safe, and
+takes a spin lock, so is best done during startup. Lookups never lock.
+
+For each index the registry keeps, alongside the domain, plain functions comparing a value of
+that domain with an `errc` and returning its closest `errc`. The comparison is built from
+`equivalence_traits` where those are specialised, so comparing a `compact_code` of such a domain
+with an `errc` never calls the domain's virtual functions.
+*/
+class compact_code_domain_registry
+{
+  friend class compact_code;
+  friend class status_code_columns;
+
+public:
+  //! The type of a domain index.
+  using index_type = uint16_t;
+  //! The most domains which can be registered.
+  static constexpr size_t capacity = SYSTEM_ERROR2_COMPACT_CODE_MAX_DOMAINS;
+  static_assert(capacity < 65536, "SYSTEM_ERROR2_COMPACT_CODE_MAX_DOMAINS must fit into a 16-bit index");
+
+private:
+  struct _row
+  {
+    status_code_domain::unique_id_type id;
+    const status_code_domain *domain;
+    system_code (*to_system_code)(uint32_t);
+    bool (*equivalent)(uint32_t, errc);
+    errc (*generic_errc)(uint32_t);
+    bool value_is_errc;
+  };
+  _row _rows[capacity + 1];
+  std::atomic<size_t> _count{1};  // rows [1, _count) are published
+  std::atomic<bool> _lock{false};
+
+  compact_code_domain_registry() noexcept
+      : _rows{}
+  {
+    _add<_generic_code_domain>();
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    _add<_posix_code_domain>();
+#endif
+#if defined(_WIN32) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+    _add<_win32_code_domain>();
+    _add<_nt_code_domain>();
+#endif
+  }
+
+  template <class DomainType> index_type _add() noexcept
+  {
+    const status_code_domain &domain = DomainType::get();
+    while(_lock.exchange(true, std::memory_order_acquire))
+    {
+    }
+    index_type ret = find(domain);
+    const size_t count = _count.load(std::memory_order_relaxed);
+    if(ret == 0 && count <= capacity)
+    {
+      _rows[count] = {domain.id(), &domain, &detail::compact_code_domain_functions<DomainType>::to_system_code,
+                      &detail::compact_code_domain_functions<DomainType>::equivalent, &detail::compact_code_domain_functions<DomainType>::generic_errc,
+                      detail::compact_code_value_is_errc<DomainType>::value};
+      _count.store(count + 1, std::memory_order_release);
+      ret = static_cast<index_type>(count);
+    }
+    _lock.store(false, std::memory_order_release);
+    return ret;
+  }
+
+public:
+  compact_code_domain_registry(const compact_code_domain_registry &) = delete;
+  compact_code_domain_registry &operator=(const compact_code_domain_registry &) = delete;
+
+  //! Returns the registry.
+  static compact_code_domain_registry &get() noexcept
+  {
+    static compact_code_domain_registry v;
+    return v;
+  }
+
+  //! Returns the index of `DomainType`, registering it if need be. Returns zero if the registry is full.
+  SYSTEM_ERROR2_TEMPLATE(class DomainType)
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(detail::compact_code_can_hold<DomainType>::value))
+  static index_type index_of() noexcept
+  {
+    static const index_type v = get()._add<DomainType>();
+    return v;
+  }
+
+  //! Returns the index of a domain if it has been registered, otherwise zero.
+  index_type find(const status_code_domain &domain) const noexcept
+  {
+    const size_t count = _count.load(std::memory_order_acquire);
+    for(size_t n = 1; n < count; n++)
+    {
+      if(_rows[n].id == domain.id())
+      {
+        return static_cast<index_type>(n);
+      }
+    }
+    return 0;
+  }
+
+  //! Returns the domain with index `idx`, or null if `idx` has not been assigned.
+  const status_code_domain *domain(index_type idx) const noexcept
+  {
+    return (idx != 0 && idx < _count.load(std::memory_order_acquire)) ? _rows[idx].domain : nullptr;
+  }
+
+  //! Returns the number of domains registered.
+  size_t size() const noexcept { return _count.load(std::memory_order_acquire) - 1; }
+};
+
+/*! An eight byte status code for storing very many codes, such as the last error of each
+of millions of connections, at half the size of a `system_code`.
+
+It holds a 16-bit domain index assigned by `compact_code_domain_registry`, 16 bits of flags,
+and the code's value in 32 bits. Only codes of domains which are trivially erasable (see
+`traits::is_trivially_erasable`) and whose value fits in 32 bits can be held, which includes
+every domain of `system_code` but not nested nor chained codes.
+
+It is trivially copyable. Whether the code is a failure is decided when it is constructed,
+so does not call into the domain. Comparison with an `errc` is a plain value comparison for
+generic and POSIX codes, and otherwise goes through the registry's table for the domain index. Anything else, such as `message()`, converts back into a `system_code`.
+*/
+class compact_code
+{
+  friend class status_code_columns;
+
+  uint32_t _value{0};
+  compact_code_domain_registry::index_type _index{0};
+  uint16_t _flags{0};
+
+  enum : uint16_t
+  {
+    _failure = 1U << 0U,
+    _value_is_errc = 1U << 1U  // Equivalent to exactly errc(_value), as for generic and POSIX codes
+  };
+
+  void _set(compact_code_domain_registry::index_type idx, uint32_t value, bool failure) noexcept
+  {
+    if(idx != 0)
+    {
+      _value = value;
+      _index = idx;
+      _flags = static_cast<uint16_t>((failure ? _failure : 0) | (compact_code_domain_registry::get()._rows[idx].value_is_errc ? _value_is_errc : 0));
+    }
+  }
+
+public:
+  //! The type of the raw value.
+  using value_type = uint32_t;
+  //! The type of a reference to a message string.
+  using string_ref = system_code::string_ref;
+
+  //! Default construction to empty
+  compact_code() = default;
+  //! Copy constructor
+  compact_code(const compact_code &) = default;
+  //! Move constructor
+  compact_code(compact_code &&) = default;  // NOLINT
+  //! Copy assignment
+  compact_code &operator=(const compact_code &) = default;
+  //! Move assignment
+  compact_code &operator=(compact_code &&) = default;  // NOLINT
+  ~compact_code() = default;
+
+  //! Implicit construction from any status code whose domain it can hold, registering the domain if need be.
+  SYSTEM_ERROR2_TEMPLATE(class DomainType)  //
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(detail::compact_code_can_hold<DomainType>::value))
+  compact_code(const status_code<DomainType> &v) noexcept  // NOLINT
+  {
+    if(!v.empty())
+    {
+      _set(compact_code_domain_registry::index_of<DomainType>(), detail::erasure_cast<uint32_t>(v.value()), v.failure());
+    }
+  }
+  //! Implicit construction from any type where an ADL discovered `make_status_code(T, Args ...)` returns a `status_code`.
+  SYSTEM_ERROR2_TEMPLATE(
+  class T, class... Args,  //
+  class MakeStatusCodeResult =
+  typename detail::safe_get_make_status_code_result<T, Args...>::type)  // Safe ADL lookup of make_status_code(), returns void if not found
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(!std::is_same<typename std::decay<T>::type, compact_code>::value       // not copy/move of self
+                                              && is_status_code<MakeStatusCodeResult>::value                        // ADL makes a status code
+                                              && std::is_constructible<compact_code, MakeStatusCodeResult>::value))  // ADLed status code is compatible
+  compact_code(T &&v, Args &&...args) noexcept(noexcept(make_status_code(std::declval<T>(), std::declval<Args>()...)))  // NOLINT
+      : compact_code(make_status_code(static_cast<T &&>(v), static_cast<Args &&>(args)...))
+  {
+  }
+  //! Implicit construction from any `quick_status_code_from_enum<Enum>` enumerated type.
+  SYSTEM_ERROR2_TEMPLATE(class Enum,                                                                          //
+                         class QuickStatusCodeType = typename quick_status_code_from_enum<Enum>::code_type)   // Enumeration has been activated
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(std::is_constructible<compact_code, QuickStatusCodeType>::value))  // Its status code is compatible
+  compact_code(Enum &&v) noexcept  // NOLINT
+      : compact_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
+  {
+  }
+  /*! Explicit construction from an erased status code such as `system_code`. This will be empty if
+  the code's domain has not been registered, which the generic and POSIX domains always are.
+  */
+  template <class ErasedType> explicit compact_code(const status_code<detail::erased<ErasedType>> &v) noexcept
+  {
+    if(!v.empty())
+    {
+      _set(compact_code_domain_registry::get().find(v.domain()), detail::erasure_cast<uint32_t>(v.value()), v.failure());
+    }
+  }
+
+  //! True if the code is empty.
+  constexpr bool empty() const noexcept { return _index == 0; }
+  //! Returns the index of the code's domain, zero if empty.
+  constexpr compact_code_domain_registry::index_type index() const noexcept { return _index; }
+  //! Returns the domain of the code, which must not be empty.
+  const status_code_domain &domain() const noexcept { return *compact_code_domain_registry::get().domain(_index); }
+  //! Returns the raw value, which is the domain's value erasure cast into 32 bits.
+  constexpr value_type value() const noexcept { return _value; }
+  //! True if the code is a success. An empty code is neither a success nor a failure.
+  constexpr bool success() const noexcept { return _index != 0 && (_flags & _failure) == 0; }
+  //! True if the code is a failure. An empty code is neither a success nor a failure.
+  constexpr bool failure() const noexcept { return (_flags & _failure) != 0; }
+  //! Reset the code to empty.
+  SYSTEM_ERROR2_CONSTEXPR14 void clear() noexcept { *this = compact_code(); }
+
+  //! Returns the equivalent `system_code`.
+  system_code to_system_code() const noexcept
+  {
+    return (_index != 0) ? compact_code_domain_registry::get()._rows[_index].to_system_code(_value) : system_code();
+  }
+  //! Returns a reference to a string textually representing the code.
+  string_ref message() const noexcept { return to_system_code().message(); }
+
+  //! True if the code is equivalent to `e`, which does not call into the code's domain.
+  bool equivalent(errc e) const noexcept
+  {
+    if((_flags & _value_is_errc) != 0)
+    {
+      return _value == detail::erasure_cast<uint32_t>(e);
+    }
+    return _index != 0 && compact_code_domain_registry::get()._rows[_index].equivalent(_value, e);
+  }
+  //! True if both codes are of the same domain and value, or both empty.
+  constexpr bool strictly_equivalent(const compact_code &o) const noexcept { return _index == o._index && _value == o._value; }
+  //! True if the codes are semantically equivalent, see `status_code<void>::equivalent()`.
+  bool equivalent(const compact_code &o) const noexcept
+  {
+    if(strictly_equivalent(o))
+    {
+      return true;
+    }
+    if(_index == 0 || o._index == 0)
+    {
+      return false;
+    }
+    if((_flags & o._flags & _value_is_errc) != 0)
+    {
+      return _value == o._value;
+    }
+    return to_system_code().equivalent(o.to_system_code());
+  }
+};
+static_assert(sizeof(compact_code) == 8, "compact_code is not eight bytes!");
+static_assert(std::is_trivially_copyable<compact_code>::value, "compact_code is not trivially copyable!");
+
+//! ADL discovered, so any status code constructible from a `system_code` is constructible from a `compact_code`.
+SYSTEM_ERROR2_TEMPLATE(class T)  // a template so other codes do not convert into a compact_code to get here
+SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(std::is_same<T, compact_code>::value))
+inline system_code make_status_code(T v) noexcept
+{
+  return v.to_system_code();
+}
+
+//! True if the codes are semantically equivalent.
+inline bool operator==(const compact_code &a, const compact_code &b) noexcept
+{
+  return a.equivalent(b);
+}
+//! True if the codes are not semantically equivalent.
+inline bool operator!=(const compact_code &a, const compact_code &b) noexcept
+{
+  return !a.equivalent(b);
+}
+//! True if the code is equivalent to the `errc`.
+inline bool operator==(const compact_code &a, errc b) noexcept
+{
+  return a.equivalent(b);
+}
+//! True if the code is equivalent to the `errc`.
+inline bool operator==(errc a, const compact_code &b) noexcept
+{
+  return b.equivalent(a);
+}
+//! True if the code is not equivalent to the `errc`.
+inline bool operator!=(const compact_code &a, errc b) noexcept
+{
+  return !a.equivalent(b);
+}
+//! True if the code is not equivalent to the `errc`.
+inline bool operator!=(errc a, const compact_code &b) noexcept
+{
+  return !b.equivalent(a);
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
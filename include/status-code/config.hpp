@@ -139,6 +139,59 @@ http://www.boost.org/LICENSE_1_0.txt)
 #define SYSTEM_ERROR2_NODISCARD
 #endif
 
+#ifndef SYSTEM_ERROR2_ERROR_COUNTERS
+//! Defined to 1 to count each construction of an errored status code and each `throw_exception()` by domain and value, see `error_counters.hpp`.
+#define SYSTEM_ERROR2_ERROR_COUNTERS 0
+#endif
+#ifndef SYSTEM_ERROR2_CALL_SITES
+//! Defined to 1 to count each construction of an errored status code by the address of the code constructing it, see `error_call_sites.hpp`.
+#define SYSTEM_ERROR2_CALL_SITES 0
+#endif
+
+#ifndef SYSTEM_ERROR2_INSTRUMENT
+//! Defined to 1 to count calls of each `status_code_domain` operation per domain, and which stage answers `equivalent()`, see `instrumentation.hpp`.
+#define SYSTEM_ERROR2_INSTRUMENT 0
+#endif
+#ifndef SYSTEM_ERROR2_INSTRUMENT_TIMING
+//! Defined to 1 to additionally accumulate the cycles spent in each `status_code_domain` operation if `SYSTEM_ERROR2_INSTRUMENT` is enabled.
+#define SYSTEM_ERROR2_INSTRUMENT_TIMING 0
+#endif
+
+#ifndef SYSTEM_ERROR2_USDT
+//! Defined to 1 to place SystemTap compatible USDT probes upon the creation, throwing and translation of status codes, see `usdt.hpp`.
+#define SYSTEM_ERROR2_USDT 0
+#endif
+
+#ifndef SYSTEM_ERROR2_REALTIME
+/*! Defined to 1 to make every library path safe to call from real-time threads: no
+`malloc()`, no locks and no unbounded loops. Messages of the system domains then come
+from static tables, which are less specific than the system's messages, nested status
+codes require an allocator other than `std::allocator`, and facilities which cannot
+work without allocating fail in a documented way instead. Thread local state is set up
+upon a thread's first use of a facility, which should happen outside real-time sections.
+*/
+#define SYSTEM_ERROR2_REALTIME 0
+#endif
+
+#ifndef SYSTEM_ERROR2_MESSAGE_CATALOGS
+/*! Defined to 1 to have `posix_code` and status codes from `quick_status_code_from_enum`
+look up their messages in the catalog installed by `install_message_catalog()` first.
+Can be overriden.
+*/
+#define SYSTEM_ERROR2_MESSAGE_CATALOGS 0
+#endif
+
+#ifndef SYSTEM_ERROR2_NOINLINE
+#if defined(_MSC_VER)
+//! Prevents inlining of a function. Can be overriden.
+#define SYSTEM_ERROR2_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__)
+#define SYSTEM_ERROR2_NOINLINE __attribute__((noinline))
+#else
+#define SYSTEM_ERROR2_NOINLINE
+#endif
+#endif
+
 #ifndef SYSTEM_ERROR2_TRIVIAL_ABI
 #if defined(STANDARDESE_IS_IN_THE_HOUSE) || (__clang_major__ >= 7 && !defined(__APPLE__))
 //! Defined to be `[[clang::trivial_abi]]` when on a new enough clang compiler. Usually automatic, can be overriden.
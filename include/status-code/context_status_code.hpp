@@ -0,0 +1,406 @@
+/* Per-thread context ring for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_CONTEXT_STATUS_CODE_HPP
+#define SYSTEM_ERROR2_CONTEXT_STATUS_CODE_HPP
+
+#include "generic_code.hpp"
+
+#include <cstdint>  // for uint32_t
+
+#ifndef SYSTEM_ERROR2_CONTEXT_RINGS
+//! The maximum number of threads which can concurrently hold a context ring. Can be overriden via predefinition, must be less than 256.
+#define SYSTEM_ERROR2_CONTEXT_RINGS 255
+#endif
+#ifndef SYSTEM_ERROR2_CONTEXT_RING_SLOTS
+//! The number of context records in each thread's ring. Can be overriden via predefinition, must be a power of two no more than 256.
+#define SYSTEM_ERROR2_CONTEXT_RING_SLOTS 64
+#endif
+#ifndef SYSTEM_ERROR2_CONTEXT_RING_TEXT
+//! The maximum length of a context record, including its null terminator. Can be overriden via predefinition.
+#define SYSTEM_ERROR2_CONTEXT_RING_TEXT 128
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  static_assert(SYSTEM_ERROR2_CONTEXT_RINGS > 0 && SYSTEM_ERROR2_CONTEXT_RINGS < 256, "SYSTEM_ERROR2_CONTEXT_RINGS must be between 1 and 255");
+  static_assert(SYSTEM_ERROR2_CONTEXT_RING_SLOTS > 0 && SYSTEM_ERROR2_CONTEXT_RING_SLOTS <= 256
+                && (SYSTEM_ERROR2_CONTEXT_RING_SLOTS & (SYSTEM_ERROR2_CONTEXT_RING_SLOTS - 1)) == 0,
+                "SYSTEM_ERROR2_CONTEXT_RING_SLOTS must be a power of two no more than 256");
+  static_assert(SYSTEM_ERROR2_CONTEXT_RING_TEXT > 1, "SYSTEM_ERROR2_CONTEXT_RING_TEXT must be at least 2");
+
+  /* Each ring numbers its records, and record N is written into slot N % SLOTS.
+  Each slot is a seqlock. Only the thread owning the ring ever writes, and it sets the
+  sequence to 2N+1 before writing record N and to 2N+2 after. Readers, which may be on
+  any thread, check that the sequence is even, names the record number in their handle,
+  and is unchanged after they have copied out the text.
+
+  Handles keep the low 24 bits of the record number, so a handle can only be mistaken
+  for a newer record after its ring has written another 16M records, rather than after
+  a slot has been rewritten some fixed number of times.
+
+  Rings live in static storage and are never freed, so a handle from an exited thread
+  can always be safely validated. Record numbers are never reset, so reuse of a ring by
+  a new thread invalidates handles from its previous owner.
+  */
+  static constexpr uint32_t context_record_mask = 0xffffff;
+  struct context_ring_slot
+  {
+    std::atomic<uint32_t> seq;
+    char text[SYSTEM_ERROR2_CONTEXT_RING_TEXT];
+  };
+  struct context_ring
+  {
+    std::atomic<bool> owned;
+    uint32_t records;
+    context_ring_slot slots[SYSTEM_ERROR2_CONTEXT_RING_SLOTS];
+  };
+  // Zero initialised, so pages are only made resident when a thread first uses its ring
+  inline context_ring *context_rings() noexcept
+  {
+    static context_ring v[SYSTEM_ERROR2_CONTEXT_RINGS];
+    return v;
+  }
+  // Index of the calling thread's ring, or SYSTEM_ERROR2_CONTEXT_RINGS if none were free
+  struct context_ring_owner
+  {
+    unsigned index{SYSTEM_ERROR2_CONTEXT_RINGS};
+
+    context_ring_owner() noexcept
+    {
+      context_ring *rings = context_rings();
+      for(unsigned n = 0; n < SYSTEM_ERROR2_CONTEXT_RINGS; n++)
+      {
+        bool expected = false;
+        if(!rings[n].owned.load(std::memory_order_relaxed) && rings[n].owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+          index = n;
+          break;
+        }
+      }
+    }
+    context_ring_owner(const context_ring_owner &) = delete;
+    context_ring_owner(context_ring_owner &&) = delete;
+    context_ring_owner &operator=(const context_ring_owner &) = delete;
+    context_ring_owner &operator=(context_ring_owner &&) = delete;
+    ~context_ring_owner()
+    {
+      if(index < SYSTEM_ERROR2_CONTEXT_RINGS)
+      {
+        context_rings()[index].owned.store(false, std::memory_order_release);
+      }
+    }
+  };
+  inline unsigned this_thread_context_ring() noexcept
+  {
+    static thread_local context_ring_owner owner;
+    return owner.index;
+  }
+}  // namespace detail
+
+/*! The handle to a context record kept inside the value of a status code with context.
+
+This is eight bytes, so a status code with context whose original value type is no more
+than four bytes can be type erased into `system_code` on 64 bit platforms.
+*/
+template <class T> struct context_handle
+{
+  static_assert(sizeof(T) <= 4, "context_handle can only carry values up to four bytes in size");
+  //! The value of the original status code
+  T value;
+  //! The low 24 bits of the number of the record within its ring, which also selects its slot
+  uint32_t record : 24;
+  //! The ring, or `SYSTEM_ERROR2_CONTEXT_RINGS` if no context could be recorded
+  uint32_t ring : 8;
+};
+
+namespace detail
+{
+  // Records a context into the calling thread's ring, returning ring and record number
+  inline void record_context(unsigned &ring, uint32_t &record, const char *context, size_t length) noexcept
+  {
+    const unsigned idx = this_thread_context_ring();
+    ring = idx;
+    record = 0;
+    if(idx >= SYSTEM_ERROR2_CONTEXT_RINGS)
+    {
+      return;
+    }
+    context_ring &r = context_rings()[idx];
+    const uint32_t n = r.records++;
+    context_ring_slot &s = r.slots[n % SYSTEM_ERROR2_CONTEXT_RING_SLOTS];
+    s.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    if(length >= SYSTEM_ERROR2_CONTEXT_RING_TEXT)
+    {
+      length = SYSTEM_ERROR2_CONTEXT_RING_TEXT - 1;
+    }
+    memcpy(s.text, context, length);
+    s.text[length] = 0;
+    s.seq.store(2 * n + 2, std::memory_order_release);
+    record = n & context_record_mask;
+  }
+  // Copies out a context into buffer, returning false if it has been overwritten
+  inline bool read_context(unsigned ring, uint32_t record, char (&buffer)[SYSTEM_ERROR2_CONTEXT_RING_TEXT]) noexcept
+  {
+    if(ring >= SYSTEM_ERROR2_CONTEXT_RINGS)
+    {
+      return false;
+    }
+    const context_ring_slot &s = context_rings()[ring].slots[record % SYSTEM_ERROR2_CONTEXT_RING_SLOTS];
+    const uint32_t seq1 = s.seq.load(std::memory_order_acquire);
+    if(seq1 == 0 || (seq1 & 1) != 0 || (((seq1 >> 1) - 1) & context_record_mask) != record)
+    {
+      return false;
+    }
+    memcpy(buffer, s.text, SYSTEM_ERROR2_CONTEXT_RING_TEXT);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint32_t seq2 = s.seq.load(std::memory_order_relaxed);
+    buffer[SYSTEM_ERROR2_CONTEXT_RING_TEXT - 1] = 0;
+    return seq1 == seq2;
+  }
+  inline status_code_domain::string_ref append_context_message(const status_code_domain::string_ref &msg, const char *context) noexcept
+  {
+    static constexpr const char separator[] = " [context: ";
+    const size_t contextlen = strlen(context);  // NOLINT
+    const size_t length = msg.size() + sizeof(separator) - 1 + contextlen + 1;
+    auto *p = static_cast<char *>(malloc(length + 1));  // NOLINT
+    if(p == nullptr)
+    {
+      return status_code_domain::string_ref("failed to get message from system");
+    }
+    char *out = p;
+    memcpy(out, msg.data(), msg.size());
+    out += msg.size();
+    memcpy(out, separator, sizeof(separator) - 1);
+    out += sizeof(separator) - 1;
+    memcpy(out, context, contextlen);
+    out += contextlen;
+    *out++ = ']';
+    *out = 0;
+    return status_code_domain::atomic_refcounted_string_ref(p, length);
+  }
+}  // namespace detail
+
+//! A status code carrying the status code `StatusCode` plus a handle to a context record in a thread's ring.
+template <class StatusCode> using context_status_code = status_code<detail::context_domain<StatusCode>>;
+
+namespace detail
+{
+  /* The domain of a status code which wraps another status code, adding a handle to
+  a context record. The original status code is reconstituted from its value on demand.
+  */
+  template <class StatusCode> class context_domain : public status_code_domain
+  {
+    template <class DomainType> friend class status_code;
+    template <class StatusCode_, class Allocator> friend class indirecting_domain;
+    using _base = status_code_domain;
+    using _mycode = status_code<context_domain>;
+
+    static constexpr StatusCode _inner(const _mycode &c) noexcept { return StatusCode(in_place, c.value().value); }
+
+  public:
+    //! The value type of the context code, which is the original value plus the context handle
+    using value_type = context_handle<typename StatusCode::value_type>;
+    using _base::string_ref;
+
+    constexpr context_domain() noexcept
+        : _base(0x3f6b1d9c27e54a81 ^ typename StatusCode::domain_type().id() /* unique-ish based on domain's unique id */)
+    {
+    }
+    context_domain(const context_domain &) = default;
+    context_domain(context_domain &&) = default;  // NOLINT
+    context_domain &operator=(const context_domain &) = default;
+    context_domain &operator=(context_domain &&) = default;  // NOLINT
+    ~context_domain() = default;
+
+#if __cplusplus < 201402L && !defined(_MSC_VER)
+    static inline const context_domain &get()
+    {
+      static context_domain v;
+      return v;
+    }
+#else
+    static inline constexpr const context_domain &get();
+#endif
+
+    virtual string_ref name() const noexcept override { return typename StatusCode::domain_type().name(); }  // NOLINT
+
+    virtual payload_info_t payload_info() const noexcept override
+    {
+      return {sizeof(value_type), sizeof(status_code_domain *) + sizeof(value_type),
+              (alignof(value_type) > alignof(status_code_domain *)) ? alignof(value_type) : alignof(status_code_domain *)};
+    }
+
+    /*! Copies the context of the code into `buffer`, returning false if there is no
+    context, or if it has since been overwritten by newer context.
+    */
+    static bool context(const _mycode &code, char (&buffer)[SYSTEM_ERROR2_CONTEXT_RING_TEXT]) noexcept
+    {
+      const value_type &v = code.value();
+      return read_context(v.ring, v.record, buffer);
+    }
+
+  protected:
+    virtual bool _do_failure(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      return _inner(static_cast<const _mycode &>(code)).failure();  // NOLINT
+    }
+    virtual bool _do_equivalent(const status_code<void> &code1, const status_code<void> &code2) const noexcept override  // NOLINT
+    {
+      assert(code1.domain() == *this);
+      const auto &c1 = static_cast<const _mycode &>(code1);  // NOLINT
+      if(code2.domain() == *this)
+      {
+        const auto &c2 = static_cast<const _mycode &>(code2);  // NOLINT
+        return _inner(c1).strictly_equivalent(_inner(c2));
+      }
+      return _inner(c1).strictly_equivalent(code2);
+    }
+    virtual generic_code _generic_code(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const StatusCode c = _inner(static_cast<const _mycode &>(code));  // NOLINT
+      return static_cast<const status_code_domain &>(c.domain())._generic_code(c);
+    }
+    virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const StatusCode c = _inner(static_cast<const _mycode &>(code));  // NOLINT
+      return static_cast<const status_code_domain &>(c.domain())._do_matches(c, set);
+    }
+    virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+      // Appending the context allocates, use message_into() for that
+      return _inner(c).message();
+#else
+      char buffer[SYSTEM_ERROR2_CONTEXT_RING_TEXT];
+      if(c.value().ring >= SYSTEM_ERROR2_CONTEXT_RINGS)
+      {
+        return _inner(c).message();
+      }
+      if(!context(c, buffer))
+      {
+        return append_context_message(_inner(c).message(), "overwritten");
+      }
+      return append_context_message(_inner(c).message(), buffer);
+#endif
+    }
+    virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code);  // NOLINT
+      if(c.value().ring >= SYSTEM_ERROR2_CONTEXT_RINGS)
+      {
+        return _inner(c).message_into(buffer, length);
+      }
+      static constexpr const char separator[] = " [context: ";
+      char text[SYSTEM_ERROR2_CONTEXT_RING_TEXT];
+      message_writer out{buffer, length, 0};
+      out.append(_inner(c));
+      out.append(separator, sizeof(separator) - 1);
+      if(context(c, text))
+      {
+        out.append(text, strlen(text));
+      }
+      else
+      {
+        out.append("overwritten", 11);
+      }
+      out.append("]", 1);
+      return out.written;
+    }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+    SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      _inner(static_cast<const _mycode &>(code)).throw_exception();  // NOLINT
+      abort();                                                       // suppress buggy GCC warning
+    }
+#endif
+  };
+#if __cplusplus >= 201402L || defined(_MSC_VER)
+  template <class StatusCode> constexpr context_domain<StatusCode> _context_domain{};
+  template <class StatusCode> inline constexpr const context_domain<StatusCode> &context_domain<StatusCode>::get()
+  {
+    return _context_domain<StatusCode>;
+  }
+#endif
+}  // namespace detail
+
+/*! Make a status code carrying the status code `v` plus a copy of the context string
+`context`, which is truncated to `SYSTEM_ERROR2_CONTEXT_RING_TEXT - 1` characters.
+
+The context is written into the next slot of a ring buffer belonging to the calling
+thread, overwriting the oldest record. The returned status code keeps only a handle
+to the slot, so this is O(1), never allocates, and if the original code's value
+is no more than four bytes, the returned code can be type erased into `system_code`.
+
+`message()` on the returned code appends the context to the original message if the
+slot has not since been overwritten, or appends `[context: overwritten]` if it has.
+If `SYSTEM_ERROR2_REALTIME` is enabled, only `message_into()` appends the context.
+Handles keep the low 24 bits of their record number, so if its thread has since made
+almost exactly a multiple of 2^24 further codes with context, a code may be given the
+context of a newer record.
+All other operations behave exactly as they would on the original code. If more than
+`SYSTEM_ERROR2_CONTEXT_RINGS` threads concurrently make codes with context, the
+surplus threads' codes carry no context.
+*/
+SYSTEM_ERROR2_TEMPLATE(class T)
+SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<T>::value))  //
+inline context_status_code<typename std::decay<T>::type> make_context_status_code(T &&v, const char *context,
+                                                                                 size_t length = static_cast<size_t>(-1)) noexcept
+{
+  using status_code_type = typename std::decay<T>::type;
+  unsigned ring;
+  uint32_t record;
+  detail::record_context(ring, record, context, (length == static_cast<size_t>(-1)) ? strlen(context) : length);
+  return context_status_code<status_code_type>(context_handle<typename status_code_type::value_type>{v.value(), record, ring});
+}
+
+/*! If a status code was made by `make_context_status_code()` from a status code of
+type `StatusCode`, and its context has not since been overwritten, copy the context into
+`buffer` and return true. Otherwise return false.
+*/
+SYSTEM_ERROR2_TEMPLATE(class StatusCode)
+SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<StatusCode>::value))
+inline bool get_context(const status_code<void> &v, char (&buffer)[SYSTEM_ERROR2_CONTEXT_RING_TEXT]) noexcept
+{
+  using domain_type = detail::context_domain<StatusCode>;
+  if(v.empty() || v.domain() != domain_type::get())
+  {
+    return false;
+  }
+  return domain_type::context(static_cast<const context_status_code<StatusCode> &>(v), buffer);  // NOLINT
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
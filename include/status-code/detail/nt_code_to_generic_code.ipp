@@ -1,98 +1,98 @@
-case 0x80000002: return EACCES;
-case 0x8000000f: return EAGAIN;
-case 0x80000010: return EAGAIN;
-case 0x80000011: return EBUSY;
-case 0xc0000002: return ENOSYS;
-case 0xc0000005: return EACCES;
-case 0xc0000008: return EINVAL;
-case 0xc000000e: return ENOENT;
-case 0xc000000f: return ENOENT;
-case 0xc0000010: return ENOSYS;
-case 0xc0000013: return EAGAIN;
-case 0xc0000017: return ENOMEM;
-case 0xc000001c: return ENOSYS;
-case 0xc000001e: return EACCES;
-case 0xc000001f: return EACCES;
-case 0xc0000021: return EACCES;
-case 0xc0000022: return EACCES;
-case 0xc0000024: return EINVAL;
-case 0xc0000033: return EINVAL;
-case 0xc0000034: return ENOENT;
-case 0xc0000035: return EEXIST;
-case 0xc0000037: return EINVAL;
-case 0xc000003a: return ENOENT;
-case 0xc0000040: return ENOMEM;
-case 0xc0000041: return EACCES;
-case 0xc0000042: return EINVAL;
-case 0xc0000043: return EACCES;
-case 0xc000004b: return EACCES;
-case 0xc0000054: return ENOLCK;
-case 0xc0000055: return ENOLCK;
-case 0xc0000056: return EACCES;
-case 0xc000007f: return ENOSPC;
-case 0xc0000087: return ENOMEM;
-case 0xc0000097: return ENOMEM;
-case 0xc000009b: return ENOENT;
-case 0xc000009e: return EAGAIN;
-case 0xc00000a2: return EACCES;
-case 0xc00000a3: return EAGAIN;
-case 0xc00000af: return ENOSYS;
-case 0xc00000ba: return EACCES;
-case 0xc00000c0: return ENODEV;
-case 0xc00000d4: return EXDEV;
-case 0xc00000d5: return EACCES;
-case 0xc00000fb: return ENOENT;
-case 0xc0000101: return ENOTEMPTY;
-case 0xc0000103: return EINVAL;
-case 0xc0000107: return EBUSY;
-case 0xc0000108: return EBUSY;
-case 0xc000010a: return EACCES;
-case 0xc000011f: return EMFILE;
-case 0xc0000120: return ECANCELED;
-case 0xc0000121: return EACCES;
-case 0xc0000123: return EACCES;
-case 0xc0000128: return EINVAL;
-case 0xc0000189: return EACCES;
-case 0xc00001ad: return ENOMEM;
-case 0xc000022d: return EAGAIN;
-case 0xc0000235: return EINVAL;
-case 0xc000026e: return EAGAIN;
-case 0xc000028a: return EACCES;
-case 0xc000028b: return EACCES;
-case 0xc000028d: return EACCES;
-case 0xc000028e: return EACCES;
-case 0xc000028f: return EACCES;
-case 0xc0000290: return EACCES;
-case 0xc000029c: return ENOSYS;
-case 0xc00002c5: return EACCES;
-case 0xc00002d3: return EAGAIN;
-case 0xc00002ea: return EACCES;
-case 0xc00002f0: return ENOENT;
-case 0xc0000373: return ENOMEM;
-case 0xc0000416: return ENOMEM;
-case 0xc0000433: return EBUSY;
-case 0xc0000434: return EBUSY;
-case 0xc0000455: return EINVAL;
-case 0xc0000467: return EACCES;
-case 0xc0000491: return ENOENT;
-case 0xc0000495: return EAGAIN;
-case 0xc0000503: return EAGAIN;
-case 0xc0000507: return EBUSY;
-case 0xc0000512: return EACCES;
-case 0xc000070a: return EINVAL;
-case 0xc000070b: return EINVAL;
-case 0xc000070c: return EINVAL;
-case 0xc000070d: return EINVAL;
-case 0xc000070e: return EINVAL;
-case 0xc000070f: return EINVAL;
-case 0xc0000710: return ENOSYS;
-case 0xc0000711: return ENOSYS;
-case 0xc0000716: return EINVAL;
-case 0xc000071b: return ENOSYS;
-case 0xc000071d: return ENOSYS;
-case 0xc000071e: return ENOSYS;
-case 0xc000071f: return ENOSYS;
-case 0xc0000720: return ENOSYS;
-case 0xc0000721: return ENOSYS;
-case 0xc000080f: return EAGAIN;
-case 0xc000a203: return EACCES;
+{0x80000002, errc::permission_denied},
+{0x8000000f, errc::resource_unavailable_try_again},
+{0x80000010, errc::resource_unavailable_try_again},
+{0x80000011, errc::device_or_resource_busy},
+{0xc0000002, errc::function_not_supported},
+{0xc0000005, errc::permission_denied},
+{0xc0000008, errc::invalid_argument},
+{0xc000000e, errc::no_such_file_or_directory},
+{0xc000000f, errc::no_such_file_or_directory},
+{0xc0000010, errc::function_not_supported},
+{0xc0000013, errc::resource_unavailable_try_again},
+{0xc0000017, errc::not_enough_memory},
+{0xc000001c, errc::function_not_supported},
+{0xc000001e, errc::permission_denied},
+{0xc000001f, errc::permission_denied},
+{0xc0000021, errc::permission_denied},
+{0xc0000022, errc::permission_denied},
+{0xc0000024, errc::invalid_argument},
+{0xc0000033, errc::invalid_argument},
+{0xc0000034, errc::no_such_file_or_directory},
+{0xc0000035, errc::file_exists},
+{0xc0000037, errc::invalid_argument},
+{0xc000003a, errc::no_such_file_or_directory},
+{0xc0000040, errc::not_enough_memory},
+{0xc0000041, errc::permission_denied},
+{0xc0000042, errc::invalid_argument},
+{0xc0000043, errc::permission_denied},
+{0xc000004b, errc::permission_denied},
+{0xc0000054, errc::no_lock_available},
+{0xc0000055, errc::no_lock_available},
+{0xc0000056, errc::permission_denied},
+{0xc000007f, errc::no_space_on_device},
+{0xc0000087, errc::not_enough_memory},
+{0xc0000097, errc::not_enough_memory},
+{0xc000009b, errc::no_such_file_or_directory},
+{0xc000009e, errc::resource_unavailable_try_again},
+{0xc00000a2, errc::permission_denied},
+{0xc00000a3, errc::resource_unavailable_try_again},
+{0xc00000af, errc::function_not_supported},
+{0xc00000ba, errc::permission_denied},
+{0xc00000c0, errc::no_such_device},
+{0xc00000d4, errc::cross_device_link},
+{0xc00000d5, errc::permission_denied},
+{0xc00000fb, errc::no_such_file_or_directory},
+{0xc0000101, errc::directory_not_empty},
+{0xc0000103, errc::invalid_argument},
+{0xc0000107, errc::device_or_resource_busy},
+{0xc0000108, errc::device_or_resource_busy},
+{0xc000010a, errc::permission_denied},
+{0xc000011f, errc::too_many_files_open},
+{0xc0000120, errc::operation_canceled},
+{0xc0000121, errc::permission_denied},
+{0xc0000123, errc::permission_denied},
+{0xc0000128, errc::invalid_argument},
+{0xc0000189, errc::permission_denied},
+{0xc00001ad, errc::not_enough_memory},
+{0xc000022d, errc::resource_unavailable_try_again},
+{0xc0000235, errc::invalid_argument},
+{0xc000026e, errc::resource_unavailable_try_again},
+{0xc000028a, errc::permission_denied},
+{0xc000028b, errc::permission_denied},
+{0xc000028d, errc::permission_denied},
+{0xc000028e, errc::permission_denied},
+{0xc000028f, errc::permission_denied},
+{0xc0000290, errc::permission_denied},
+{0xc000029c, errc::function_not_supported},
+{0xc00002c5, errc::permission_denied},
+{0xc00002d3, errc::resource_unavailable_try_again},
+{0xc00002ea, errc::permission_denied},
+{0xc00002f0, errc::no_such_file_or_directory},
+{0xc0000373, errc::not_enough_memory},
+{0xc0000416, errc::not_enough_memory},
+{0xc0000433, errc::device_or_resource_busy},
+{0xc0000434, errc::device_or_resource_busy},
+{0xc0000455, errc::invalid_argument},
+{0xc0000467, errc::permission_denied},
+{0xc0000491, errc::no_such_file_or_directory},
+{0xc0000495, errc::resource_unavailable_try_again},
+{0xc0000503, errc::resource_unavailable_try_again},
+{0xc0000507, errc::device_or_resource_busy},
+{0xc0000512, errc::permission_denied},
+{0xc000070a, errc::invalid_argument},
+{0xc000070b, errc::invalid_argument},
+{0xc000070c, errc::invalid_argument},
+{0xc000070d, errc::invalid_argument},
+{0xc000070e, errc::invalid_argument},
+{0xc000070f, errc::invalid_argument},
+{0xc0000710, errc::function_not_supported},
+{0xc0000711, errc::function_not_supported},
+{0xc0000716, errc::invalid_argument},
+{0xc000071b, errc::function_not_supported},
+{0xc000071d, errc::function_not_supported},
+{0xc000071e, errc::function_not_supported},
+{0xc000071f, errc::function_not_supported},
+{0xc0000720, errc::function_not_supported},
+{0xc0000721, errc::function_not_supported},
+{0xc000080f, errc::resource_unavailable_try_again},
+{0xc000a203, errc::permission_denied},
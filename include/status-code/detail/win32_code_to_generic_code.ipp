@@ -1,75 +1,75 @@
-case 0x1: return ENOSYS;
-case 0x2: return ENOENT;
-case 0x3: return ENOENT;
-case 0x4: return EMFILE;
-case 0x5: return EACCES;
-case 0x6: return EINVAL;
-case 0x8: return ENOMEM;
-case 0xc: return EACCES;
-case 0xe: return ENOMEM;
-case 0xf: return ENODEV;
-case 0x10: return EACCES;
-case 0x11: return EXDEV;
-case 0x13: return EACCES;
-case 0x14: return ENODEV;
-case 0x15: return EAGAIN;
-case 0x19: return EIO;
-case 0x1d: return EIO;
-case 0x1e: return EIO;
-case 0x20: return EACCES;
-case 0x21: return ENOLCK;
-case 0x27: return ENOSPC;
-case 0x37: return ENODEV;
-case 0x50: return EEXIST;
-case 0x52: return EACCES;
-case 0x57: return EINVAL;
-case 0x6e: return EIO;
-case 0x6f: return ENAMETOOLONG;
-case 0x70: return ENOSPC;
-case 0x7b: return EINVAL;
-case 0x83: return EINVAL;
-case 0x8e: return EBUSY;
-case 0x91: return ENOTEMPTY;
-case 0xaa: return EBUSY;
-case 0xb7: return EEXIST;
-case 0xd4: return ENOLCK;
-case 0x10b: return EINVAL;
-case 0x3e3: return ECANCELED;
-case 0x3e6: return EACCES;
-case 0x3f3: return EIO;
-case 0x3f4: return EIO;
-case 0x3f5: return EIO;
-case 0x4d5: return EAGAIN;
-case 0x961: return EBUSY;
-case 0x964: return EBUSY;
-case 0x2714: return EINTR;
-case 0x2719: return EBADF;
-case 0x271d: return EACCES;
-case 0x271e: return EFAULT;
-case 0x2726: return EINVAL;
-case 0x2728: return EMFILE;
-case 0x2733: return EWOULDBLOCK;
-case 0x2734: return EINPROGRESS;
-case 0x2735: return EALREADY;
-case 0x2736: return ENOTSOCK;
-case 0x2737: return EDESTADDRREQ;
-case 0x2738: return EMSGSIZE;
-case 0x2739: return EPROTOTYPE;
-case 0x273a: return ENOPROTOOPT;
-case 0x273b: return EPROTONOSUPPORT;
-case 0x273d: return EOPNOTSUPP;
-case 0x273f: return EAFNOSUPPORT;
-case 0x2740: return EADDRINUSE;
-case 0x2741: return EADDRNOTAVAIL;
-case 0x2742: return ENETDOWN;
-case 0x2743: return ENETUNREACH;
-case 0x2744: return ENETRESET;
-case 0x2745: return ECONNABORTED;
-case 0x2746: return ECONNRESET;
-case 0x2747: return ENOBUFS;
-case 0x2748: return EISCONN;
-case 0x2749: return ENOTCONN;
-case 0x274c: return ETIMEDOUT;
-case 0x274d: return ECONNREFUSED;
-case 0x274f: return ENAMETOOLONG;
-case 0x2751: return EHOSTUNREACH;
+{0x1, errc::function_not_supported},
+{0x2, errc::no_such_file_or_directory},
+{0x3, errc::no_such_file_or_directory},
+{0x4, errc::too_many_files_open},
+{0x5, errc::permission_denied},
+{0x6, errc::invalid_argument},
+{0x8, errc::not_enough_memory},
+{0xc, errc::permission_denied},
+{0xe, errc::not_enough_memory},
+{0xf, errc::no_such_device},
+{0x10, errc::permission_denied},
+{0x11, errc::cross_device_link},
+{0x13, errc::permission_denied},
+{0x14, errc::no_such_device},
+{0x15, errc::resource_unavailable_try_again},
+{0x19, errc::io_error},
+{0x1d, errc::io_error},
+{0x1e, errc::io_error},
+{0x20, errc::permission_denied},
+{0x21, errc::no_lock_available},
+{0x27, errc::no_space_on_device},
+{0x37, errc::no_such_device},
+{0x50, errc::file_exists},
+{0x52, errc::permission_denied},
+{0x57, errc::invalid_argument},
+{0x6e, errc::io_error},
+{0x6f, errc::filename_too_long},
+{0x70, errc::no_space_on_device},
+{0x7b, errc::invalid_argument},
+{0x83, errc::invalid_argument},
+{0x8e, errc::device_or_resource_busy},
+{0x91, errc::directory_not_empty},
+{0xaa, errc::device_or_resource_busy},
+{0xb7, errc::file_exists},
+{0xd4, errc::no_lock_available},
+{0x10b, errc::invalid_argument},
+{0x3e3, errc::operation_canceled},
+{0x3e6, errc::permission_denied},
+{0x3f3, errc::io_error},
+{0x3f4, errc::io_error},
+{0x3f5, errc::io_error},
+{0x4d5, errc::resource_unavailable_try_again},
+{0x961, errc::device_or_resource_busy},
+{0x964, errc::device_or_resource_busy},
+{0x2714, errc::interrupted},
+{0x2719, errc::bad_file_descriptor},
+{0x271d, errc::permission_denied},
+{0x271e, errc::bad_address},
+{0x2726, errc::invalid_argument},
+{0x2728, errc::too_many_files_open},
+{0x2733, errc::operation_would_block},
+{0x2734, errc::operation_in_progress},
+{0x2735, errc::connection_already_in_progress},
+{0x2736, errc::not_a_socket},
+{0x2737, errc::destination_address_required},
+{0x2738, errc::message_size},
+{0x2739, errc::wrong_protocol_type},
+{0x273a, errc::no_protocol_option},
+{0x273b, errc::protocol_not_supported},
+{0x273d, errc::operation_not_supported},
+{0x273f, errc::address_family_not_supported},
+{0x2740, errc::address_in_use},
+{0x2741, errc::address_not_available},
+{0x2742, errc::network_down},
+{0x2743, errc::network_unreachable},
+{0x2744, errc::network_reset},
+{0x2745, errc::connection_aborted},
+{0x2746, errc::connection_reset},
+{0x2747, errc::no_buffer_space},
+{0x2748, errc::already_connected},
+{0x2749, errc::not_connected},
+{0x274c, errc::timed_out},
+{0x274d, errc::connection_refused},
+{0x274f, errc::filename_too_long},
+{0x2751, errc::host_unreachable},
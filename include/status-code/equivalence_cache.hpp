@@ -0,0 +1,133 @@
+/* Per call site caches of status code equivalence
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_EQUIVALENCE_CACHE_HPP
+#define SYSTEM_ERROR2_EQUIVALENCE_CACHE_HPP
+
+#include "system_code.hpp"
+
+#include <atomic>
+#include <cstdint>  // for uint64_t
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // Domains whose equivalence to an errc is decided by the domain and value alone
+  constexpr inline bool equivalence_is_cacheable(status_code_domain::unique_id_type id) noexcept
+  {
+    return id == generic_code_domain.id()
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+           || id == posix_code_domain.id()
+#endif
+#if defined(_WIN32) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+           || id == win32_code_domain.id() || id == nt_code_domain.id()
+#endif
+    ;
+  }
+}  // namespace detail
+
+/*! A cache of whether erased status codes are equivalent to an `errc`, for use by a single
+comparison site which sees codes from a few domains over and over. Use `SYSTEM_ERROR2_ERRC_EQUIVALENT()`
+rather than instancing this directly.
+
+The answers for the last four domain and value pairs seen are remembered, so a repeat
+comparison costs a few loads rather than the virtual calls of `equivalent()`. Only the generic,
+POSIX and Win32/NT domains, whose codes are fully described by their value, are cached;
+codes of any other domain, such as nested codes which point elsewhere, are always compared
+with `equivalent()`. Each entry is a sequence lock, so the cache is thread safe without locking,
+and a comparison which races with an update simply misses.
+*/
+class errc_equivalence_cache
+{
+  struct _entry
+  {
+    std::atomic<unsigned> seq{0};
+    std::atomic<uint64_t> id{0};
+    std::atomic<uint64_t> value{0};
+    std::atomic<uint64_t> tag{0};  // target errc << 2 | valid << 1 | result
+  };
+  _entry _entries[4];
+  std::atomic<unsigned> _next{0};
+
+  static constexpr uint64_t _tag(errc target) noexcept { return (static_cast<uint64_t>(static_cast<uint32_t>(target)) << 2) | 2; }
+
+public:
+  //! Constructs an empty cache. This is constexpr, so a cache in static storage needs no initialisation guard.
+  constexpr errc_equivalence_cache() noexcept {}  // NOLINT
+  errc_equivalence_cache(const errc_equivalence_cache &) = delete;
+  errc_equivalence_cache &operator=(const errc_equivalence_cache &) = delete;
+
+  //! Returns `code == target`, using the cache where possible.
+  template <class T> bool equivalent(const status_code<detail::erased<T>> &code, errc target) noexcept
+  {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t), "errc_equivalence_cache only caches erased codes with integral values");
+#if SYSTEM_ERROR2_INSTRUMENT
+    return code.equivalent(generic_code(target));  // every comparison must be recorded
+#else
+    if(code.empty() || !detail::equivalence_is_cacheable(code.domain().id()))
+    {
+      return code.equivalent(generic_code(target));
+    }
+    const uint64_t id = code.domain().id(), value = static_cast<uint64_t>(code.value()), tag = _tag(target);
+    for(_entry &e : _entries)
+    {
+      const unsigned seq = e.seq.load(std::memory_order_acquire);
+      const uint64_t eid = e.id.load(std::memory_order_relaxed), evalue = e.value.load(std::memory_order_relaxed),
+                     etag = e.tag.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(eid == id && evalue == value && (etag & ~uint64_t(1)) == tag && (seq & 1) == 0 && e.seq.load(std::memory_order_relaxed) == seq)
+      {
+        return (etag & 1) != 0;
+      }
+    }
+    const bool ret = code.equivalent(generic_code(target));
+    // Replace the entries in turn, skipping the update if another thread is writing the entry
+    _entry &e = _entries[_next.fetch_add(1, std::memory_order_relaxed) % (sizeof(_entries) / sizeof(_entries[0]))];
+    unsigned seq = e.seq.load(std::memory_order_relaxed);
+    if((seq & 1) == 0 && e.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed))
+    {
+      std::atomic_thread_fence(std::memory_order_release);
+      e.id.store(id, std::memory_order_relaxed);
+      e.value.store(value, std::memory_order_relaxed);
+      e.tag.store(tag | (ret ? 1 : 0), std::memory_order_relaxed);
+      e.seq.store(seq + 2, std::memory_order_release);
+    }
+    return ret;
+#endif
+  }
+};
+
+/*! Evaluates to `code == target` for an erased status code with integral value, such as `system_code`,
+remembering the answer in a cache private to this use of the macro. See `errc_equivalence_cache`.
+*/
+#define SYSTEM_ERROR2_ERRC_EQUIVALENT(code, target)                                                                                                            \
+  ([&]() noexcept -> bool {                                                                                                                                    \
+    static SYSTEM_ERROR2_NAMESPACE::errc_equivalence_cache _system_error2_cache;                                                                              \
+    return _system_error2_cache.equivalent((code), (target));                                                                                                  \
+  }())
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -49,9 +49,19 @@ and move bitcopying.
 */
 using error = erased_errored_status_code<system_code::value_type>;
 
+/*! An errored `trivial_system_code` which is always a failure. It is to `error`
+what `trivial_system_code` is to `system_code`: it can only hold codes of
+trivially erasable domains, and in exchange every compiler transports it in
+exactly two CPU registers. It converts implicitly into `error`.
+*/
+using trivial_error = trivial_erased_errored_status_code<system_code::value_type>;
+
 #ifndef NDEBUG
 static_assert(sizeof(error) == 2 * sizeof(void *), "error is not exactly two pointers in size!");
 static_assert(traits::is_move_bitcopying<error>::value, "error is not move bitcopying!");
+static_assert(sizeof(trivial_error) == 2 * sizeof(void *), "trivial_error is not exactly two pointers in size!");
+static_assert(std::is_trivially_copyable<trivial_error>::value, "trivial_error is not trivially copyable!");
+static_assert(std::is_trivially_destructible<trivial_error>::value, "trivial_error is not trivially destructible!");
 #endif
 
 SYSTEM_ERROR2_NAMESPACE_END
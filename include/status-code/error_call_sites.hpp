@@ -0,0 +1,276 @@
+/* Call site attribution for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_ERROR_CALL_SITES_HPP
+#define SYSTEM_ERROR2_ERROR_CALL_SITES_HPP
+
+#include "config.hpp"
+
+#include <cstdint>  // for uintptr_t
+
+#ifndef SYSTEM_ERROR2_CALL_SITES_SHARDS
+//! The number of threads which can concurrently own an uncontended shard of call site counters. Can be overriden via predefinition.
+#define SYSTEM_ERROR2_CALL_SITES_SHARDS 32
+#endif
+#ifndef SYSTEM_ERROR2_CALL_SITES_SLOTS
+//! The number of distinct call sites each shard can count. Can be overriden via predefinition, must be a power of two.
+#define SYSTEM_ERROR2_CALL_SITES_SLOTS 512
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+extern "C" void *_ReturnAddress(void);
+#pragma intrinsic(_ReturnAddress)
+#define SYSTEM_ERROR2_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define SYSTEM_ERROR2_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+//! The number of errored status codes constructed at a call site.
+struct error_call_site
+{
+  //! The address of the instruction after the call which recorded the construction.
+  const void *address{nullptr};
+  //! The number of constructions since the last reset.
+  unsigned long long count{0};
+};
+
+namespace detail
+{
+  static_assert((SYSTEM_ERROR2_CALL_SITES_SLOTS & (SYSTEM_ERROR2_CALL_SITES_SLOTS - 1)) == 0, "SYSTEM_ERROR2_CALL_SITES_SLOTS must be a power of two");
+
+  /* Each thread claims a shard of its own on first use, so counting is a plain
+  load and store without any atomic read-modify-write. Threads which cannot claim
+  a shard share a further shard, which they increment with atomic read-modify-write.
+  Slots are claimed by CASing the call site address in, and never change thereafter.
+  Shards live in static storage and are never freed, so counts made by exited threads
+  are retained.
+  */
+  struct call_site_slot
+  {
+    std::atomic<uintptr_t> address;
+    std::atomic<unsigned long long> count;
+  };
+  struct call_site_shard
+  {
+    std::atomic<bool> owned;
+    call_site_slot slots[SYSTEM_ERROR2_CALL_SITES_SLOTS];
+  };
+  struct call_sites_state
+  {
+    call_site_shard shards[SYSTEM_ERROR2_CALL_SITES_SHARDS + 1];  // the last is shared
+    std::atomic<unsigned long long> dropped;
+  };
+  inline call_sites_state &call_sites() noexcept
+  {
+    static call_sites_state v;
+    return v;
+  }
+  struct call_site_shard_owner
+  {
+    call_site_shard *shard{nullptr};
+
+    call_site_shard_owner() noexcept
+    {
+      call_sites_state &state = call_sites();
+      for(unsigned n = 0; n < SYSTEM_ERROR2_CALL_SITES_SHARDS; n++)
+      {
+        bool expected = false;
+        if(!state.shards[n].owned.load(std::memory_order_relaxed) && state.shards[n].owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+        {
+          shard = &state.shards[n];
+          return;
+        }
+      }
+      shard = &state.shards[SYSTEM_ERROR2_CALL_SITES_SHARDS];
+    }
+    call_site_shard_owner(const call_site_shard_owner &) = delete;
+    call_site_shard_owner(call_site_shard_owner &&) = delete;
+    call_site_shard_owner &operator=(const call_site_shard_owner &) = delete;
+    call_site_shard_owner &operator=(call_site_shard_owner &&) = delete;
+    ~call_site_shard_owner()
+    {
+      if(shard != &call_sites().shards[SYSTEM_ERROR2_CALL_SITES_SHARDS])
+      {
+        shard->owned.store(false, std::memory_order_release);
+      }
+    }
+  };
+  SYSTEM_ERROR2_NOINLINE inline call_site_shard *claim_call_site_shard() noexcept
+  {
+    static thread_local call_site_shard_owner owner;
+    return owner.shard;
+  }
+  // Trivially initialised thread local, so no guard on the hot path
+  inline call_site_shard *&this_thread_call_site_shard() noexcept
+  {
+    static thread_local call_site_shard *shard;
+    return shard;
+  }
+  inline constexpr unsigned call_site_hash(uintptr_t address) noexcept
+  {
+    return static_cast<unsigned>((static_cast<unsigned long long>(address) * 0x9e3779b97f4a7c15ULL) >> 40);
+  }
+  inline call_site_slot *find_call_site(call_site_shard &shard, uintptr_t address) noexcept
+  {
+    const unsigned hash = call_site_hash(address);
+    for(unsigned n = 0; n < SYSTEM_ERROR2_CALL_SITES_SLOTS; n++)
+    {
+      call_site_slot &s = shard.slots[(hash + n) & (SYSTEM_ERROR2_CALL_SITES_SLOTS - 1)];
+      const uintptr_t a = s.address.load(std::memory_order_relaxed);
+      if(a == address)
+      {
+        return &s;
+      }
+      if(a == 0)
+      {
+        return nullptr;
+      }
+    }
+    return nullptr;
+  }
+
+  /*! \exclude Counts one construction at the call site `site`, which is the return address
+  of a function which is not inlined and is called by the errored status code constructors.
+  If those constructors are not themselves inlined, as in unoptimised builds, the call site
+  recorded will be within those constructors.
+  */
+  inline void record_error_call_site(const void *site) noexcept
+  {
+    const auto address = reinterpret_cast<uintptr_t>(site);  // NOLINT
+    call_site_shard *&shard = this_thread_call_site_shard();
+    if(shard == nullptr)
+    {
+      shard = claim_call_site_shard();
+    }
+    const bool exclusive = (shard != &call_sites().shards[SYSTEM_ERROR2_CALL_SITES_SHARDS]);
+    const unsigned hash = call_site_hash(address);
+    for(unsigned n = 0; n < SYSTEM_ERROR2_CALL_SITES_SLOTS; n++)
+    {
+      call_site_slot &s = shard->slots[(hash + n) & (SYSTEM_ERROR2_CALL_SITES_SLOTS - 1)];
+      uintptr_t a = s.address.load(std::memory_order_relaxed);
+      if(a == 0 && s.address.compare_exchange_strong(a, address, std::memory_order_relaxed))
+      {
+        a = address;
+      }
+      if(a == address)
+      {
+        if(exclusive)
+        {
+          s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        else
+        {
+          s.count.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+      }
+    }
+    call_sites().dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}  // namespace detail
+
+/*! Copies up to `max` of the call sites which have constructed the most errored
+status codes since the last reset into `out`, most frequent first, merging the per-thread
+shards. Returns the number of call sites copied.
+
+Call sites are only ever recorded when `SYSTEM_ERROR2_CALL_SITES` is enabled. They
+can be symbolised with your debugger, `addr2line`, or `backtrace_symbols()`.
+*/
+inline size_t top_error_call_sites(error_call_site *out, size_t max) noexcept
+{
+  detail::call_sites_state &state = detail::call_sites();
+  const unsigned shards = SYSTEM_ERROR2_CALL_SITES_SHARDS + 1;
+  size_t n = 0;
+  for(unsigned shard = 0; shard < shards; shard++)
+  {
+    for(auto &s : state.shards[shard].slots)
+    {
+      const uintptr_t address = s.address.load(std::memory_order_relaxed);
+      if(address == 0)
+      {
+        continue;
+      }
+      // Skip call sites which an earlier shard also has, as they were merged then
+      bool seen = false;
+      for(unsigned earlier = 0; earlier < shard && !seen; earlier++)
+      {
+        seen = (detail::find_call_site(state.shards[earlier], address) != nullptr);
+      }
+      if(seen)
+      {
+        continue;
+      }
+      unsigned long long count = s.count.load(std::memory_order_relaxed);
+      for(unsigned later = shard + 1; later < shards; later++)
+      {
+        if(const detail::call_site_slot *o = detail::find_call_site(state.shards[later], address))
+        {
+          count += o->count.load(std::memory_order_relaxed);
+        }
+      }
+      if(count == 0 || (n == max && (max == 0 || out[max - 1].count >= count)))
+      {
+        continue;
+      }
+      // Insertion into the sorted top N
+      size_t i = (n < max) ? n++ : max - 1;
+      for(; i > 0 && out[i - 1].count < count; i--)
+      {
+        out[i] = out[i - 1];
+      }
+      out[i].address = reinterpret_cast<const void *>(address);  // NOLINT
+      out[i].count = count;
+    }
+  }
+  return n;
+}
+
+/*! Resets the counts of all call sites to zero. Increments concurrent with the reset
+may or may not be lost, and a thread incrementing its own shard concurrently may
+restore a count from before the reset.
+*/
+inline void reset_error_call_sites() noexcept
+{
+  detail::call_sites_state &state = detail::call_sites();
+  for(auto &shard : state.shards)
+  {
+    for(auto &s : shard.slots)
+    {
+      s.count.store(0, std::memory_order_relaxed);
+    }
+  }
+  state.dropped.store(0, std::memory_order_relaxed);
+}
+
+//! Returns how many constructions were not attributed since the last reset because a shard had no free slots.
+inline unsigned long long error_call_sites_dropped() noexcept
+{
+  return detail::call_sites().dropped.load(std::memory_order_relaxed);
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,427 @@
+/* Error occurrence counters for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_ERROR_COUNTERS_HPP
+#define SYSTEM_ERROR2_ERROR_COUNTERS_HPP
+
+#include "status_code_domain.hpp"
+
+#ifndef SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS
+//! The number of shards of error counters, threads are assigned to shards round robin. Can be overriden via predefinition, must be a power of two.
+#define SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS 16
+#endif
+#ifndef SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS
+//! The number of distinct (domain, value, event) keys each shard can count. Can be overriden via predefinition, must be a power of two.
+#define SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS 256
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+//! The events which are counted when `SYSTEM_ERROR2_ERROR_COUNTERS` is enabled.
+enum class error_event : unsigned char
+{
+  constructed,  //!< An errored status code was constructed
+  thrown        //!< `throw_exception()` was called upon a status code
+};
+
+//! The merged count of occurrences of an event for a (domain, value) pair.
+struct error_counter
+{
+  //! The domain of the status code.
+  const status_code_domain *domain{nullptr};
+  //! The value of the status code, sign extended if of one, two or four bytes, otherwise its leading eight bytes.
+  long long value{0};
+  //! The event counted.
+  error_event event{error_event::constructed};
+  //! The number of occurrences since the last reset.
+  unsigned long long count{0};
+};
+
+namespace detail
+{
+  static_assert((SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS & (SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS - 1)) == 0,
+                "SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS must be a power of two");
+  static_assert((SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS & (SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS - 1)) == 0,
+                "SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS must be a power of two");
+
+  /* Each shard is an open addressing hash table which is only ever inserted into.
+  A slot is claimed by CASing its state from empty to busy, its key is written, and
+  then its state is released as ready, after which its key never changes. Counts are
+  relaxed atomic increments. Counting never waits: an occurrence whose probe meets a
+  slot which is still being claimed by another thread is counted as dropped.
+  */
+  struct error_counter_slot
+  {
+    std::atomic<unsigned> state;  // 0 = empty, 1 = key being written, 2 = ready
+    const status_code_domain *domain;
+    unsigned long long id;
+    long long value;
+    error_event event;
+    std::atomic<unsigned long long> count;
+  };
+  struct error_counter_shard
+  {
+    error_counter_slot slots[SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS];
+  };
+  struct error_counters_state
+  {
+    error_counter_shard shards[SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS];
+    std::atomic<unsigned> next_shard;
+    std::atomic<unsigned long long> dropped;
+  };
+  inline error_counters_state &error_counters() noexcept
+  {
+    static error_counters_state v;
+    return v;
+  }
+  inline error_counter_shard &this_thread_error_counter_shard() noexcept
+  {
+    static thread_local error_counter_shard *shard =
+    &error_counters().shards[error_counters().next_shard.fetch_add(1, std::memory_order_relaxed) & (SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS - 1)];
+    return *shard;
+  }
+  inline constexpr unsigned error_counter_hash(unsigned long long id, long long value, error_event event) noexcept
+  {
+    return static_cast<unsigned>(((id ^ (static_cast<unsigned long long>(value) * 0x9e3779b97f4a7c15ULL) ^ static_cast<unsigned long long>(event)) *
+                                  0xff51afd7ed558ccdULL) >>
+                                 40);
+  }
+  // Returns the ready slot for the key, or null if it is absent
+  inline error_counter_slot *find_error_counter(error_counter_shard &shard, unsigned long long id, long long value, error_event event) noexcept
+  {
+    const unsigned hash = error_counter_hash(id, value, event);
+    for(unsigned n = 0; n < SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS; n++)
+    {
+      error_counter_slot &s = shard.slots[(hash + n) & (SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS - 1)];
+      const unsigned state = s.state.load(std::memory_order_acquire);
+      if(state == 0)
+      {
+        return nullptr;
+      }
+      if(state == 2 && s.id == id && s.value == value && s.event == event)
+      {
+        return &s;
+      }
+    }
+    return nullptr;
+  }
+
+  //! \exclude Counts one occurrence of `event` for `(domain, value)` in the calling thread's shard.
+  inline void count_error_event(const status_code_domain &domain, long long value, error_event event) noexcept
+  {
+    error_counter_shard &shard = this_thread_error_counter_shard();
+    const unsigned long long id = domain.id();
+    const unsigned hash = error_counter_hash(id, value, event);
+    for(unsigned n = 0; n < SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS; n++)
+    {
+      error_counter_slot &s = shard.slots[(hash + n) & (SYSTEM_ERROR2_ERROR_COUNTERS_SLOTS - 1)];
+      unsigned state = s.state.load(std::memory_order_acquire);
+      if(state == 0)
+      {
+        if(s.state.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_acquire))
+        {
+          s.domain = &domain;
+          s.id = id;
+          s.value = value;
+          s.event = event;
+          s.count.store(1, std::memory_order_relaxed);
+          s.state.store(2, std::memory_order_release);
+          return;
+        }
+      }
+      if(state == 1)
+      {
+        /* Another thread sharing this shard is writing a key into this slot. It may be
+        our key, so probing on could insert a duplicate, and waiting for it would not be
+        lock free, so count the occurrence as dropped instead.
+        */
+        break;
+      }
+      if(s.id == id && s.value == value && s.event == event)
+      {
+        s.count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    error_counters().dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  //! \exclude The value of a status code as counted.
+  template <class T> inline long long error_counter_value(const T &v, std::true_type /*integral*/) noexcept { return static_cast<long long>(v); }
+  template <class T> inline long long error_counter_value(const T &v, std::false_type /*integral*/) noexcept
+  {
+    long long ret = 0;
+    memcpy(&ret, &v, (sizeof(T) < sizeof(ret)) ? sizeof(T) : sizeof(ret));
+    return ret;
+  }
+  template <class T> inline long long error_counter_value(const T &v) noexcept
+  {
+    return error_counter_value(v, std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value>());
+  }
+  /* \exclude The value of a status code of unknown type as counted. The domain knows only the
+  size of the value, so values smaller than `long long` are assumed to be signed.
+  */
+  template <class StatusCode> inline long long erased_error_counter_value(const StatusCode &code) noexcept
+  {
+    const auto info = code.domain().payload_info();
+    const size_t offset = (sizeof(status_code_domain *) + info.total_alignment - 1) & ~(info.total_alignment - 1);
+    const auto *p = reinterpret_cast<const unsigned char *>(&code) + offset;  // NOLINT
+    switch(info.payload_size)
+    {
+    case 1:
+      return static_cast<signed char>(*p);
+    case 2:
+    {
+      short v;
+      memcpy(&v, p, sizeof(v));
+      return v;
+    }
+    case 4:
+    {
+      int v;
+      memcpy(&v, p, sizeof(v));
+      return v;
+    }
+    default:
+    {
+      long long ret = 0;
+      memcpy(&ret, p, (info.payload_size < sizeof(ret)) ? info.payload_size : sizeof(ret));
+      return ret;
+    }
+    }
+  }
+
+  // Calls f(domain, value, event, count) once per distinct key across all shards
+  template <class F> inline void for_each_error_counter(F &&f) noexcept
+  {
+    error_counters_state &state = error_counters();
+    for(unsigned shard = 0; shard < SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS; shard++)
+    {
+      for(auto &s : state.shards[shard].slots)
+      {
+        if(s.state.load(std::memory_order_acquire) != 2)
+        {
+          continue;
+        }
+        // Skip keys which an earlier shard also has, as they were reported then
+        bool seen = false;
+        for(unsigned earlier = 0; earlier < shard && !seen; earlier++)
+        {
+          seen = (find_error_counter(state.shards[earlier], s.id, s.value, s.event) != nullptr);
+        }
+        if(seen)
+        {
+          continue;
+        }
+        unsigned long long count = s.count.load(std::memory_order_relaxed);
+        for(unsigned later = shard + 1; later < SYSTEM_ERROR2_ERROR_COUNTERS_SHARDS; later++)
+        {
+          if(const error_counter_slot *o = find_error_counter(state.shards[later], s.id, s.value, s.event))
+          {
+            count += o->count.load(std::memory_order_relaxed);
+          }
+        }
+        if(count > 0)
+        {
+          f(*s.domain, s.value, s.event, count);
+        }
+      }
+    }
+  }
+
+  // Appends to a buffer with snprintf semantics
+  struct error_counters_writer
+  {
+    char *buffer;
+    size_t length;
+    size_t written;
+
+    void put(char c) noexcept
+    {
+      if(written + 1 < length)
+      {
+        buffer[written] = c;
+      }
+      written++;
+    }
+    void put(const char *s, size_t len) noexcept
+    {
+      for(size_t n = 0; n < len; n++)
+      {
+        put(s[n]);
+      }
+    }
+    void put_label(const char *s, size_t len) noexcept
+    {
+      for(size_t n = 0; n < len; n++)
+      {
+        if(s[n] == '\\' || s[n] == '"')
+        {
+          put('\\');
+          put(s[n]);
+        }
+        else if(s[n] == '\n')
+        {
+          put("\\n", 2);
+        }
+        else
+        {
+          put(s[n]);
+        }
+      }
+    }
+    void put_unsigned(unsigned long long v) noexcept
+    {
+      char digits[20];
+      size_t n = 0;
+      do
+      {
+        digits[n++] = static_cast<char>('0' + (v % 10));
+        v /= 10;
+      } while(v > 0);
+      while(n > 0)
+      {
+        put(digits[--n]);
+      }
+    }
+    void put_signed(long long v) noexcept
+    {
+      if(v < 0)
+      {
+        put('-');
+        put_unsigned(0ULL - static_cast<unsigned long long>(v));
+      }
+      else
+      {
+        put_unsigned(static_cast<unsigned long long>(v));
+      }
+    }
+    size_t finish() noexcept
+    {
+      if(length > 0)
+      {
+        buffer[(written < length) ? written : length - 1] = 0;
+      }
+      return written;
+    }
+  };
+}  // namespace detail
+
+/*! Copies the counters of every (domain, value, event) with a non-zero count since the
+last reset into `out`, merging the per-thread shards. Returns the number of distinct
+counters, which may exceed `max`, in which case only the first `max` were copied.
+
+Counters are only ever incremented when `SYSTEM_ERROR2_ERROR_COUNTERS` is enabled.
+Concurrent increments may or may not be included in the snapshot.
+*/
+inline size_t snapshot_error_counters(error_counter *out, size_t max) noexcept
+{
+  size_t n = 0;
+  detail::for_each_error_counter(
+  [&](const status_code_domain &domain, long long value, error_event event, unsigned long long count)
+  {
+    if(n < max)
+    {
+      out[n].domain = &domain;
+      out[n].value = value;
+      out[n].event = event;
+      out[n].count = count;
+    }
+    n++;
+  });
+  return n;
+}
+
+/*! Resets all counters to zero. Increments concurrent with the reset may or may not
+be lost.
+*/
+inline void reset_error_counters() noexcept
+{
+  detail::error_counters_state &state = detail::error_counters();
+  for(auto &shard : state.shards)
+  {
+    for(auto &s : shard.slots)
+    {
+      s.count.store(0, std::memory_order_relaxed);
+    }
+  }
+  state.dropped.store(0, std::memory_order_relaxed);
+}
+
+//! Returns how many occurrences were not counted since the last reset, because a shard had no free slots or a slot was being claimed concurrently.
+inline unsigned long long error_counters_dropped() noexcept
+{
+  return detail::error_counters().dropped.load(std::memory_order_relaxed);
+}
+
+/*! Writes the counters in the Prometheus text exposition format into `buffer`, which
+is always null terminated if `length` is not zero. Returns the number of characters
+which the full rendering requires, excluding the null terminator, so if this is not
+less than `length` the output was truncated. For example:
+
+\code
+# HELP system_error2_errors_total Occurrences of errors by domain, value and event.
+# TYPE system_error2_errors_total counter
+system_error2_errors_total{domain="posix domain",value="2",event="constructed"} 5
+system_error2_errors_dropped_total 0
+\endcode
+*/
+inline size_t write_error_counters_prometheus(char *buffer, size_t length) noexcept
+{
+  static constexpr const char help[] = "# HELP system_error2_errors_total Occurrences of errors by domain, value and event.\n"
+                                       "# TYPE system_error2_errors_total counter\n";
+  static constexpr const char dropped[] = "# HELP system_error2_errors_dropped_total Occurrences of errors which could not be counted.\n"
+                                          "# TYPE system_error2_errors_dropped_total counter\n"
+                                          "system_error2_errors_dropped_total ";
+  detail::error_counters_writer w{buffer, length, 0};
+  w.put(help, sizeof(help) - 1);
+  detail::for_each_error_counter(
+  [&](const status_code_domain &domain, long long value, error_event event, unsigned long long count)
+  {
+    static constexpr const char metric[] = "system_error2_errors_total{domain=\"";
+    w.put(metric, sizeof(metric) - 1);
+    auto name = domain.name();
+    w.put_label(name.data(), name.size());
+    w.put("\",value=\"", 9);
+    w.put_signed(value);
+    if(event == error_event::thrown)
+    {
+      w.put("\",event=\"thrown\"} ", 18);
+    }
+    else
+    {
+      w.put("\",event=\"constructed\"} ", 23);
+    }
+    w.put_unsigned(count);
+    w.put('\n');
+  });
+  w.put(dropped, sizeof(dropped) - 1);
+  w.put_unsigned(error_counters_dropped());
+  w.put('\n');
+  return w.finish();
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -27,8 +27,44 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "quick_status_code_from_enum.hpp"
 
+#if SYSTEM_ERROR2_ERROR_COUNTERS
+#include "error_counters.hpp"
+#endif
+#if SYSTEM_ERROR2_CALL_SITES
+#include "error_call_sites.hpp"
+#endif
+
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
+namespace detail
+{
+#if SYSTEM_ERROR2_ERROR_COUNTERS || SYSTEM_ERROR2_CALL_SITES || SYSTEM_ERROR2_USDT
+  /* Counts, records the call site of, and fires the USDT probe for the construction of an
+  errored status code, unless it was constructed from one which was already counted. This
+  must not be inlined, so that its return address, which is recorded as the call site, is
+  within the function which constructed the errored status code.
+  */
+  SYSTEM_ERROR2_NOINLINE inline void on_errored_code_constructed(const status_code<void> &code, bool counted) noexcept
+  {
+    if(counted || code.empty())
+    {
+      return;
+    }
+#if SYSTEM_ERROR2_ERROR_COUNTERS
+    count_error_event(code.domain(), erased_error_counter_value(code), error_event::constructed);
+#endif
+#if SYSTEM_ERROR2_CALL_SITES
+    record_error_call_site(SYSTEM_ERROR2_RETURN_ADDRESS());
+#endif
+#if SYSTEM_ERROR2_USDT
+    SYSTEM_ERROR2_USDT_PROBE(error_constructed, code.domain().id(), erased_error_counter_value(code));
+#endif
+  }
+#else
+  inline void on_errored_code_constructed(const status_code<void> & /*unused*/, bool /*unused*/) noexcept {}
+#endif
+}  // namespace detail
+
 /*! A `status_code` which is always a failure. The closest equivalent to
 `std::error_code`, except it cannot be modified, and is templated.
 
@@ -44,12 +80,13 @@ template <class DomainType> class errored_status_code : public status_code<Domai
   using _base::clear;
   using _base::success;
 
-  void _check()
+  void _check(bool counted = false)
   {
     if(_base::success())
     {
       std::terminate();
     }
+    detail::on_errored_code_constructed(*this, counted);
   }
 
 public:
@@ -98,7 +135,7 @@ public:
   errored_status_code(T &&v, Args &&...args) noexcept(noexcept(make_status_code(std::declval<T>(), std::declval<Args>()...)))  // NOLINT
       : errored_status_code(make_status_code(static_cast<T &&>(v), static_cast<Args &&>(args)...))
   {
-    _check();
+    _check(true);
   }
 
   //! Implicit construction from any `quick_status_code_from_enum<Enum>` enumerated type.
@@ -108,7 +145,7 @@ public:
   errored_status_code(Enum &&v) noexcept(std::is_nothrow_constructible<errored_status_code, QuickStatusCodeType>::value)  // NOLINT
       : errored_status_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
   {
-    _check();
+    _check(true);
   }
   //! Explicit in-place construction.
   template <class... Args>
@@ -147,7 +184,7 @@ public:
       : errored_status_code(detail::erasure_cast<value_type>(v.value()))  // NOLINT
   {
     assert(v.domain() == this->domain());  // NOLINT
-    _check();
+    _check(true);
   }
 
   //! Always false (including at compile time), as errored status codes are never successful.
@@ -164,17 +201,20 @@ namespace traits
   };
 }  // namespace traits
 
+template <class ErasedType> class trivial_erased_errored_status_code;
+
 template <class ErasedType> class errored_status_code<detail::erased<ErasedType>> : public status_code<detail::erased<ErasedType>>
 {
   using _base = status_code<detail::erased<ErasedType>>;
   using _base::success;
 
-  void _check()
+  void _check(bool counted = false)
   {
     if(_base::success())
     {
       std::terminate();
     }
+    detail::on_errored_code_constructed(*this, counted);
   }
 
 public:
@@ -226,7 +266,7 @@ public:
   errored_status_code(const errored_status_code<DomainType> &v) noexcept
       : _base(static_cast<const status_code<DomainType> &>(v))  // NOLINT
   {
-    _check();
+    _check(true);
   }
   //! Implicit move construction from any other status code if its value type is trivially copyable or move bitcopying and it would fit into our storage
   SYSTEM_ERROR2_TEMPLATE(class DomainType)  //
@@ -242,7 +282,7 @@ public:
   errored_status_code(errored_status_code<DomainType> &&v) noexcept
       : _base(static_cast<status_code<DomainType> &&>(v))  // NOLINT
   {
-    _check();
+    _check(true);
   }
   //! Implicit construction from any type where an ADL discovered `make_status_code(T, Args ...)` returns a `status_code`.
   SYSTEM_ERROR2_TEMPLATE(
@@ -256,7 +296,7 @@ public:
   errored_status_code(T &&v, Args &&...args) noexcept(noexcept(make_status_code(std::declval<T>(), std::declval<Args>()...)))  // NOLINT
       : errored_status_code(make_status_code(static_cast<T &&>(v), static_cast<Args &&>(args)...))
   {
-    _check();
+    _check(true);
   }
   //! Implicit construction from any `quick_status_code_from_enum<Enum>` enumerated type.
   SYSTEM_ERROR2_TEMPLATE(class Enum,                                                                                      //
@@ -265,7 +305,7 @@ public:
   errored_status_code(Enum &&v) noexcept(std::is_nothrow_constructible<errored_status_code, QuickStatusCodeType>::value)  // NOLINT
       : errored_status_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
   {
-    _check();
+    _check(true);
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   //! Explicit copy construction from an unknown status code. Note that this will be empty if its value type is not trivially copyable or would not fit into our
@@ -276,6 +316,11 @@ public:
     _check();
   }
 #endif
+  //! Implicit construction from a trivial erased errored status code of the same erased type, which is always lossless.
+  errored_status_code(const trivial_erased_errored_status_code<ErasedType> &v) noexcept  // NOLINT
+      : _base(static_cast<const trivial_erased_status_code<ErasedType> &>(v))
+  {
+  }
 
   //! Always false (including at compile time), as errored status codes are never successful.
   constexpr bool success() const noexcept { return false; }
@@ -296,6 +341,105 @@ namespace traits
   };
 }  // namespace traits
 
+/*! A `trivial_erased_status_code` which is always a failure, as `erased_errored_status_code` is to
+`erased_status_code`. It is trivially copyable and destructible, and converts implicitly and losslessly
+into the `erased_errored_status_code` of the same erased type.
+*/
+template <class ErasedType> class trivial_erased_errored_status_code : public trivial_erased_status_code<ErasedType>
+{
+  using _base = trivial_erased_status_code<ErasedType>;
+  using _base::clear;
+  using _base::success;
+
+  void _check(bool counted = false)
+  {
+    if(_base::success())
+    {
+      std::terminate();
+    }
+    detail::on_errored_code_constructed(*this, counted);
+  }
+
+public:
+  using domain_type = typename _base::domain_type;
+  using value_type = typename _base::value_type;
+  using string_ref = typename _base::string_ref;
+
+  //! Default construction to empty
+  trivial_erased_errored_status_code() = default;
+  //! Copy constructor
+  trivial_erased_errored_status_code(const trivial_erased_errored_status_code &) = default;
+  //! Move constructor
+  trivial_erased_errored_status_code(trivial_erased_errored_status_code &&) = default;  // NOLINT
+  //! Copy assignment
+  trivial_erased_errored_status_code &operator=(const trivial_erased_errored_status_code &) = default;
+  //! Move assignment
+  trivial_erased_errored_status_code &operator=(trivial_erased_errored_status_code &&) = default;  // NOLINT
+  ~trivial_erased_errored_status_code() = default;
+
+  //! Explicitly construct from any similarly erased trivial status code
+  explicit trivial_erased_errored_status_code(const _base &o) noexcept
+      : _base(o)
+  {
+    _check();
+  }
+  //! Implicit construction from any status code of a trivially erasable domain whose value type would fit into our storage.
+  SYSTEM_ERROR2_TEMPLATE(class DomainType)  //
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(detail::domain_value_type_trivial_erasure_is_safe<ErasedType, DomainType>::value))
+  trivial_erased_errored_status_code(const status_code<DomainType> &v) noexcept  // NOLINT
+      : _base(v)
+  {
+    _check();
+  }
+  //! Implicit construction from any errored status code of a trivially erasable domain whose value type would fit into our storage.
+  SYSTEM_ERROR2_TEMPLATE(class DomainType)  //
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(detail::domain_value_type_trivial_erasure_is_safe<ErasedType, DomainType>::value))
+  trivial_erased_errored_status_code(const errored_status_code<DomainType> &v) noexcept  // NOLINT
+      : _base(static_cast<const status_code<DomainType> &>(v))
+  {
+    _check(true);
+  }
+  //! Implicit construction from any type where an ADL discovered `make_status_code(T, Args ...)` returns a `status_code`.
+  SYSTEM_ERROR2_TEMPLATE(
+  class T, class... Args,  //
+  class MakeStatusCodeResult =
+  typename detail::safe_get_make_status_code_result<T, Args...>::type)  // Safe ADL lookup of make_status_code(), returns void if not found
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(!std::is_same<typename std::decay<T>::type, trivial_erased_errored_status_code>::value  // not copy/move of self
+                                              && !std::is_same<typename std::decay<T>::type, value_type>::value                       // not copy/move of value type
+                                              && is_status_code<MakeStatusCodeResult>::value                                          // ADL makes a status code
+                                              && std::is_constructible<trivial_erased_errored_status_code, MakeStatusCodeResult>::value))  // ADLed status code is compatible
+  trivial_erased_errored_status_code(T &&v, Args &&...args) noexcept(noexcept(make_status_code(std::declval<T>(), std::declval<Args>()...)))  // NOLINT
+      : trivial_erased_errored_status_code(make_status_code(static_cast<T &&>(v), static_cast<Args &&>(args)...))
+  {
+    _check(true);
+  }
+  //! Implicit construction from any `quick_status_code_from_enum<Enum>` enumerated type.
+  SYSTEM_ERROR2_TEMPLATE(class Enum,                                                                                                      //
+                         class QuickStatusCodeType = typename quick_status_code_from_enum<Enum>::code_type)                               // Enumeration has been activated
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(std::is_constructible<trivial_erased_errored_status_code, QuickStatusCodeType>::value))    // Its status code is compatible
+  trivial_erased_errored_status_code(Enum &&v) noexcept(std::is_nothrow_constructible<trivial_erased_errored_status_code, QuickStatusCodeType>::value)  // NOLINT
+      : trivial_erased_errored_status_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
+  {
+    _check(true);
+  }
+  //! Explicit construction from an erased errored status code of the same erased type. This will be empty if its domain is not trivially erasable.
+  explicit trivial_erased_errored_status_code(const errored_status_code<detail::erased<ErasedType>> &v) noexcept
+      : _base(static_cast<const status_code<detail::erased<ErasedType>> &>(v))
+  {
+  }
+
+  //! Always false (including at compile time), as errored status codes are never successful.
+  constexpr bool success() const noexcept { return false; }
+};
+
+namespace traits
+{
+  template <class ErasedType> struct is_move_bitcopying<trivial_erased_errored_status_code<ErasedType>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 
 //! True if the status code's are semantically equal via `equivalent()`.
 template <class DomainType1, class DomainType2>
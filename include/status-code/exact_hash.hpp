@@ -0,0 +1,127 @@
+/* Exact hashing and comparison of SG14 status codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_EXACT_HASH_HPP
+#define SYSTEM_ERROR2_EXACT_HASH_HPP
+
+#include "status_code.hpp"
+
+#include <cstdint>  // for uint64_t
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // The finaliser of MurmurHash3, which spreads every input bit over every output bit
+  inline uint64_t exact_hash_mix(uint64_t h) noexcept
+  {
+    h ^= h >> 33U;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33U;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33U;
+    return h;
+  }
+  // The payload follows the domain pointer, aligned to the code's alignment
+  inline const unsigned char *exact_payload(const status_code<void> &code, const status_code_domain::payload_info_t &info) noexcept
+  {
+    const size_t align = (info.total_alignment > 0) ? info.total_alignment : 1;
+    return reinterpret_cast<const unsigned char *>(&code) + (sizeof(const status_code_domain *) + align - 1) / align * align;  // NOLINT
+  }
+}  // namespace detail
+
+/*! A hash of status codes which is consistent with `exact_equal`, for use as the hash of a
+container which must hold distinct codes distinctly, which `std::hash` cannot be as status code
+equality is semantic.
+
+The hash is of the domain's unique id and of the code's payload bytes, as sized by the domain's
+`payload_info()`, which costs one virtual call. A typed code and an erased code holding it
+hash the same, so the two may be mixed in a container supporting transparent lookup. Empty codes
+hash to zero. Value types with padding bytes must zero them for equal codes to hash equal.
+*/
+struct exact_hash
+{
+  //! Enables heterogeneous lookup in C++ 20 unordered containers.
+  using is_transparent = void;
+
+  //! Returns the hash of `code`.
+  size_t operator()(const status_code<void> &code) const noexcept
+  {
+    if(code.empty())
+    {
+      return 0;
+    }
+    const status_code_domain::payload_info_t info = code.domain().payload_info();
+    const unsigned char *payload = detail::exact_payload(code, info);
+    uint64_t ret = code.domain().id();
+    size_t n = 0;
+    for(; n + sizeof(uint64_t) <= info.payload_size; n += sizeof(uint64_t))
+    {
+      uint64_t word;
+      memcpy(&word, payload + n, sizeof(word));  // fixed size copies compile to single loads
+      ret = detail::exact_hash_mix(ret ^ word);
+    }
+    if(n + sizeof(uint32_t) <= info.payload_size)
+    {
+      uint32_t word;
+      memcpy(&word, payload + n, sizeof(word));
+      ret = detail::exact_hash_mix(ret ^ word);
+      n += sizeof(uint32_t);
+    }
+    for(; n < info.payload_size; n++)
+    {
+      ret = detail::exact_hash_mix(ret ^ payload[n]);
+    }
+    return static_cast<size_t>(ret);
+  }
+};
+
+/*! True if two status codes are exactly equal, meaning both are empty, or both have domains of the
+same unique id and their payloads are bitwise identical. Unlike `operator==`, codes of different
+domains are never equal, however equivalent they may be.
+*/
+struct exact_equal
+{
+  //! Enables heterogeneous lookup in C++ 20 unordered containers.
+  using is_transparent = void;
+
+  //! Returns true if `a` and `b` are exactly equal.
+  bool operator()(const status_code<void> &a, const status_code<void> &b) const noexcept
+  {
+    if(a.empty() || b.empty())
+    {
+      return a.empty() && b.empty();
+    }
+    if(a.domain() != b.domain())
+    {
+      return false;
+    }
+    const status_code_domain::payload_info_t info = a.domain().payload_info();
+    return memcmp(detail::exact_payload(a, info), detail::exact_payload(b, info), info.payload_size) == 0;
+  }
+};
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
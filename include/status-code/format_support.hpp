@@ -0,0 +1,266 @@
+/* std::format and fmt support for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_FORMAT_SUPPORT_HPP
+#define SYSTEM_ERROR2_FORMAT_SUPPORT_HPP
+
+#include "error.hpp"
+
+/*! \def SYSTEM_ERROR2_FMT
+\brief Define to 1 to have `<fmt/format.h>` included, and `fmt::formatter` specialised
+for status codes and `string_ref`. Defaults to 0.
+*/
+#ifndef SYSTEM_ERROR2_FMT
+#define SYSTEM_ERROR2_FMT 0
+#endif
+#if SYSTEM_ERROR2_FMT
+#include <fmt/format.h>
+#endif
+
+#if(__cplusplus >= 202002L || _MSVC_LANG >= 202002L) && defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+//! \brief 1 if `std::formatter` is specialised for status codes and `string_ref`.
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+#define SYSTEM_ERROR2_HAVE_STD_FORMAT 1
+#include <format>
+#include <string_view>
+#else
+#define SYSTEM_ERROR2_HAVE_STD_FORMAT 0
+#endif
+
+#include <cstdlib>  // for abort
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // Which part of a status code a format specifier selects
+  enum class format_part : char
+  {
+    full = 'f',     // "domain name: message (value)"
+    name = 'n',     // the domain name
+    value = 'v',    // the raw value
+    message = 'm',  // the message
+  };
+  // True if the value of a status code is an integer or enumeration we can print
+  template <class StatusCode> struct has_formattable_value
+  {
+    using value_type = typename StatusCode::value_type;
+    static constexpr bool value = std::is_integral<value_type>::value || std::is_enum<value_type>::value;
+  };
+  template <class StatusCode> inline long long formattable_value(const StatusCode &code, std::true_type /*formattable*/) noexcept
+  {
+    return static_cast<long long>(code.value());
+  }
+  template <class StatusCode> inline long long formattable_value(const StatusCode & /*unused*/, std::false_type /*formattable*/) noexcept { return 0; }
+
+  template <class OutputIt> inline OutputIt format_chars(OutputIt out, const char *str, size_t len)
+  {
+    for(size_t n = 0; n < len; n++)
+    {
+      *out++ = str[n];
+    }
+    return out;
+  }
+  template <class OutputIt> inline OutputIt format_integer(OutputIt out, long long v)
+  {
+    char buffer[24];
+    size_t n = sizeof(buffer);
+    unsigned long long u = (v < 0) ? (0ULL - static_cast<unsigned long long>(v)) : static_cast<unsigned long long>(v);
+    do
+    {
+      buffer[--n] = static_cast<char>('0' + (u % 10));
+      u /= 10;
+    } while(u != 0);
+    if(v < 0)
+    {
+      buffer[--n] = '-';
+    }
+    return format_chars(out, buffer + n, sizeof(buffer) - n);
+  }
+  // Writes the message without allocating, unless it is too long for the stack buffer
+  template <class OutputIt> inline OutputIt format_message(OutputIt out, const status_code<void> &code)
+  {
+    char buffer[256];
+    const size_t len = code.message_into(buffer, sizeof(buffer));
+    if(len < sizeof(buffer))
+    {
+      return format_chars(out, buffer, len);
+    }
+    const auto msg = code.message();
+    return format_chars(out, msg.data(), msg.size());
+  }
+  template <class OutputIt>
+  inline OutputIt format_status_code(OutputIt out, const status_code<void> &code, format_part part, bool has_value, long long value)
+  {
+    if(code.empty())
+    {
+      return format_chars(out, "(empty)", 7);
+    }
+    switch(part)
+    {
+    case format_part::name:
+    {
+      const auto name = code.domain().name();
+      return format_chars(out, name.data(), name.size());
+    }
+    case format_part::value:
+      return format_integer(out, value);
+    case format_part::message:
+      return format_message(out, code);
+    case format_part::full:
+      break;
+    }
+    {
+      const auto name = code.domain().name();
+      out = format_chars(out, name.data(), name.size());
+    }
+    out = format_chars(out, ": ", 2);
+    out = format_message(out, code);
+    if(has_value)
+    {
+      out = format_chars(out, " (", 2);
+      out = format_integer(out, value);
+      out = format_chars(out, ")", 1);
+    }
+    return out;
+  }
+
+  template <class FormatError> SYSTEM_ERROR2_NORETURN inline void throw_format_error(const char *msg)
+  {
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+    throw FormatError(msg);
+#else
+    (void) msg;
+    abort();
+#endif
+  }
+
+  /* The implementation of `std::formatter` and `fmt::formatter` for status codes. Format
+  specifiers are empty or `f` for "domain name: message (value)", `n` for the domain name,
+  `v` for the raw value and `m` for the message.
+  */
+  template <class StatusCode, class FormatError> struct status_code_formatter
+  {
+    format_part _part{format_part::full};
+
+    template <class ParseContext> SYSTEM_ERROR2_CONSTEXPR14 auto parse(ParseContext &ctx) -> decltype(ctx.begin())
+    {
+      auto it = ctx.begin();
+      if(it != ctx.end() && *it != '}')
+      {
+        switch(*it)
+        {
+        case 'v':
+          if(!has_formattable_value<StatusCode>::value)
+          {
+            throw_format_error<FormatError>("the value of this status code is not an integer");
+          }
+          _part = format_part::value;
+          break;
+        case 'f':
+        case 'n':
+        case 'm':
+          _part = static_cast<format_part>(*it);
+          break;
+        default:
+          throw_format_error<FormatError>("invalid format specifier for status code");
+        }
+        ++it;
+      }
+      if(it != ctx.end() && *it != '}')
+      {
+        throw_format_error<FormatError>("invalid format specifier for status code");
+      }
+      return it;
+    }
+
+    template <class FormatContext> auto format(const StatusCode &code, FormatContext &ctx) const -> decltype(ctx.out())
+    {
+      using formattable = std::integral_constant<bool, has_formattable_value<StatusCode>::value>;
+      return format_status_code(ctx.out(), code, _part, formattable::value, formattable_value(code, formattable()));
+    }
+  };
+}  // namespace detail
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#if SYSTEM_ERROR2_HAVE_STD_FORMAT
+/*! `std::format()` support for status codes. Format specifiers are empty or `f` for
+"domain name: message (value)", `n` for the domain name, `v` for the raw value and `m`
+for the message. The message is written directly to the output without allocating for
+the built-in domains.
+*/
+template <class DomainType>
+struct std::formatter<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, char>
+    : SYSTEM_ERROR2_NAMESPACE::detail::status_code_formatter<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, std::format_error>
+{
+};
+//! \overload
+template <class DomainType>
+struct std::formatter<SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>, char>
+    : SYSTEM_ERROR2_NAMESPACE::detail::status_code_formatter<SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>, std::format_error>
+{
+};
+//! `std::format()` support for `string_ref`, with the same format specifiers as `std::string_view`.
+template <> struct std::formatter<SYSTEM_ERROR2_NAMESPACE::status_code_domain::string_ref, char> : std::formatter<std::string_view, char>
+{
+  template <class FormatContext> auto format(const SYSTEM_ERROR2_NAMESPACE::status_code_domain::string_ref &v, FormatContext &ctx) const
+  {
+    return std::formatter<std::string_view, char>::format(std::string_view(v.data(), v.size()), ctx);
+  }
+};
+#endif
+
+#if SYSTEM_ERROR2_FMT
+FMT_BEGIN_NAMESPACE
+/*! fmt support for status codes, with the same format specifiers as for `std::format()`.
+ */
+template <class DomainType>
+struct formatter<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, char>
+    : SYSTEM_ERROR2_NAMESPACE::detail::status_code_formatter<SYSTEM_ERROR2_NAMESPACE::status_code<DomainType>, format_error>
+{
+};
+//! \overload
+template <class DomainType>
+struct formatter<SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>, char>
+    : SYSTEM_ERROR2_NAMESPACE::detail::status_code_formatter<SYSTEM_ERROR2_NAMESPACE::errored_status_code<DomainType>, format_error>
+{
+};
+//! fmt support for `string_ref`, with the same format specifiers as `fmt::string_view`.
+template <> struct formatter<SYSTEM_ERROR2_NAMESPACE::status_code_domain::string_ref, char> : formatter<string_view, char>
+{
+  template <class FormatContext>
+  auto format(const SYSTEM_ERROR2_NAMESPACE::status_code_domain::string_ref &v, FormatContext &ctx) const -> decltype(ctx.out())
+  {
+    return formatter<string_view, char>::format(string_view(v.data(), v.size()), ctx);
+  }
+};
+FMT_END_NAMESPACE
+#endif
+
+#endif
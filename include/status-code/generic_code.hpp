@@ -27,7 +27,9 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "status_error.hpp"
 
-#include <cerrno>  // for error constants
+#include <cerrno>            // for error constants
+#include <cstdint>           // for uint64_t
+#include <initializer_list>  // for classify()
 
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
@@ -118,176 +120,343 @@ enum class errc : int
 
 namespace detail
 {
-  SYSTEM_ERROR2_CONSTEXPR14 inline const char *generic_code_message(errc code) noexcept
+  struct generic_code_entry
   {
-    switch(code)
-    {
-    case errc::success:
-      return "Success";
-    case errc::address_family_not_supported:
-      return "Address family not supported by protocol";
-    case errc::address_in_use:
-      return "Address already in use";
-    case errc::address_not_available:
-      return "Cannot assign requested address";
-    case errc::already_connected:
-      return "Transport endpoint is already connected";
-    case errc::argument_list_too_long:
-      return "Argument list too long";
-    case errc::argument_out_of_domain:
-      return "Numerical argument out of domain";
-    case errc::bad_address:
-      return "Bad address";
-    case errc::bad_file_descriptor:
-      return "Bad file descriptor";
-    case errc::bad_message:
-      return "Bad message";
-    case errc::broken_pipe:
-      return "Broken pipe";
-    case errc::connection_aborted:
-      return "Software caused connection abort";
-    case errc::connection_already_in_progress:
-      return "Operation already in progress";
-    case errc::connection_refused:
-      return "Connection refused";
-    case errc::connection_reset:
-      return "Connection reset by peer";
-    case errc::cross_device_link:
-      return "Invalid cross-device link";
-    case errc::destination_address_required:
-      return "Destination address required";
-    case errc::device_or_resource_busy:
-      return "Device or resource busy";
-    case errc::directory_not_empty:
-      return "Directory not empty";
-    case errc::executable_format_error:
-      return "Exec format error";
-    case errc::file_exists:
-      return "File exists";
-    case errc::file_too_large:
-      return "File too large";
-    case errc::filename_too_long:
-      return "File name too long";
-    case errc::function_not_supported:
-      return "Function not implemented";
-    case errc::host_unreachable:
-      return "No route to host";
-    case errc::identifier_removed:
-      return "Identifier removed";
-    case errc::illegal_byte_sequence:
-      return "Invalid or incomplete multibyte or wide character";
-    case errc::inappropriate_io_control_operation:
-      return "Inappropriate ioctl for device";
-    case errc::interrupted:
-      return "Interrupted system call";
-    case errc::invalid_argument:
-      return "Invalid argument";
-    case errc::invalid_seek:
-      return "Illegal seek";
-    case errc::io_error:
-      return "Input/output error";
-    case errc::is_a_directory:
-      return "Is a directory";
-    case errc::message_size:
-      return "Message too long";
-    case errc::network_down:
-      return "Network is down";
-    case errc::network_reset:
-      return "Network dropped connection on reset";
-    case errc::network_unreachable:
-      return "Network is unreachable";
-    case errc::no_buffer_space:
-      return "No buffer space available";
-    case errc::no_child_process:
-      return "No child processes";
-    case errc::no_link:
-      return "Link has been severed";
-    case errc::no_lock_available:
-      return "No locks available";
-    case errc::no_message:
-      return "No message of desired type";
-    case errc::no_protocol_option:
-      return "Protocol not available";
-    case errc::no_space_on_device:
-      return "No space left on device";
-    case errc::no_stream_resources:
-      return "Out of streams resources";
-    case errc::no_such_device_or_address:
-      return "No such device or address";
-    case errc::no_such_device:
-      return "No such device";
-    case errc::no_such_file_or_directory:
-      return "No such file or directory";
-    case errc::no_such_process:
-      return "No such process";
-    case errc::not_a_directory:
-      return "Not a directory";
-    case errc::not_a_socket:
-      return "Socket operation on non-socket";
-    case errc::not_a_stream:
-      return "Device not a stream";
-    case errc::not_connected:
-      return "Transport endpoint is not connected";
-    case errc::not_enough_memory:
-      return "Cannot allocate memory";
-#if ENOTSUP != EOPNOTSUPP
-    case errc::not_supported:
-      return "Operation not supported";
-#endif
-    case errc::operation_canceled:
-      return "Operation canceled";
-    case errc::operation_in_progress:
-      return "Operation now in progress";
-    case errc::operation_not_permitted:
-      return "Operation not permitted";
-    case errc::operation_not_supported:
-      return "Operation not supported";
-#if EAGAIN != EWOULDBLOCK
-    case errc::operation_would_block:
-      return "Resource temporarily unavailable";
-#endif
-    case errc::owner_dead:
-      return "Owner died";
-    case errc::permission_denied:
-      return "Permission denied";
-    case errc::protocol_error:
-      return "Protocol error";
-    case errc::protocol_not_supported:
-      return "Protocol not supported";
-    case errc::read_only_file_system:
-      return "Read-only file system";
-    case errc::resource_deadlock_would_occur:
-      return "Resource deadlock avoided";
-    case errc::resource_unavailable_try_again:
-      return "Resource temporarily unavailable";
-    case errc::result_out_of_range:
-      return "Numerical result out of range";
-    case errc::state_not_recoverable:
-      return "State not recoverable";
-    case errc::stream_timeout:
-      return "Timer expired";
-    case errc::text_file_busy:
-      return "Text file busy";
-    case errc::timed_out:
-      return "Connection timed out";
-    case errc::too_many_files_open_in_system:
-      return "Too many open files in system";
-    case errc::too_many_files_open:
-      return "Too many open files";
-    case errc::too_many_links:
-      return "Too many links";
-    case errc::too_many_symbolic_link_levels:
-      return "Too many levels of symbolic links";
-    case errc::value_too_large:
-      return "Value too large for defined data type";
-    case errc::wrong_protocol_type:
-      return "Protocol wrong type for socket";
-    default:
-      return "unknown";
-    }
+    const char *message;
+    size_t message_length;
+    const char *name;
+    size_t name_length;
+    errc value;
+  };
+#define SYSTEM_ERROR2_GENERIC_CODE_ENTRY(name, message)                                                                                                        \
+  generic_code_entry                                                                                                                                           \
+  {                                                                                                                                                            \
+    message, sizeof(message) - 1, #name, sizeof(#name) - 1, errc::name                                                                                        \
+  }
+  /* Every `errc` with its message, sorted by name. Where two names share a value, as
+  `not_supported` and `operation_not_supported` do on some platforms, the first is
+  used for the value's name.
+  */
+  template <class T = void> struct generic_code_source
+  {
+    static constexpr size_t count = 77;
+    static constexpr generic_code_entry entries[count] = {
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(address_family_not_supported, "Address family not supported by protocol"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(address_in_use, "Address already in use"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(address_not_available, "Cannot assign requested address"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(already_connected, "Transport endpoint is already connected"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(argument_list_too_long, "Argument list too long"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(argument_out_of_domain, "Numerical argument out of domain"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(bad_address, "Bad address"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(bad_file_descriptor, "Bad file descriptor"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(bad_message, "Bad message"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(broken_pipe, "Broken pipe"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(connection_aborted, "Software caused connection abort"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(connection_already_in_progress, "Operation already in progress"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(connection_refused, "Connection refused"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(connection_reset, "Connection reset by peer"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(cross_device_link, "Invalid cross-device link"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(destination_address_required, "Destination address required"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(device_or_resource_busy, "Device or resource busy"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(directory_not_empty, "Directory not empty"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(executable_format_error, "Exec format error"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(file_exists, "File exists"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(file_too_large, "File too large"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(filename_too_long, "File name too long"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(function_not_supported, "Function not implemented"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(host_unreachable, "No route to host"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(identifier_removed, "Identifier removed"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(illegal_byte_sequence, "Invalid or incomplete multibyte or wide character"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(inappropriate_io_control_operation, "Inappropriate ioctl for device"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(interrupted, "Interrupted system call"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(invalid_argument, "Invalid argument"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(invalid_seek, "Illegal seek"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(io_error, "Input/output error"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(is_a_directory, "Is a directory"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(message_size, "Message too long"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(network_down, "Network is down"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(network_reset, "Network dropped connection on reset"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(network_unreachable, "Network is unreachable"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_buffer_space, "No buffer space available"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_child_process, "No child processes"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_link, "Link has been severed"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_lock_available, "No locks available"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_message, "No message of desired type"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_protocol_option, "Protocol not available"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_space_on_device, "No space left on device"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_stream_resources, "Out of streams resources"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_such_device, "No such device"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_such_device_or_address, "No such device or address"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_such_file_or_directory, "No such file or directory"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(no_such_process, "No such process"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_a_directory, "Not a directory"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_a_socket, "Socket operation on non-socket"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_a_stream, "Device not a stream"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_connected, "Transport endpoint is not connected"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_enough_memory, "Cannot allocate memory"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(not_supported, "Operation not supported"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(operation_canceled, "Operation canceled"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(operation_in_progress, "Operation now in progress"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(operation_not_permitted, "Operation not permitted"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(operation_not_supported, "Operation not supported"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(operation_would_block, "Resource temporarily unavailable"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(owner_dead, "Owner died"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(permission_denied, "Permission denied"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(protocol_error, "Protocol error"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(protocol_not_supported, "Protocol not supported"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(read_only_file_system, "Read-only file system"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(resource_deadlock_would_occur, "Resource deadlock avoided"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(resource_unavailable_try_again, "Resource temporarily unavailable"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(result_out_of_range, "Numerical result out of range"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(state_not_recoverable, "State not recoverable"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(stream_timeout, "Timer expired"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(text_file_busy, "Text file busy"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(timed_out, "Connection timed out"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(too_many_files_open, "Too many open files"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(too_many_files_open_in_system, "Too many open files in system"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(too_many_links, "Too many links"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(too_many_symbolic_link_levels, "Too many levels of symbolic links"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(value_too_large, "Value too large for defined data type"),
+      SYSTEM_ERROR2_GENERIC_CODE_ENTRY(wrong_protocol_type, "Protocol wrong type for socket"),
+    };
+  };
+  template <class T> constexpr generic_code_entry generic_code_source<T>::entries[generic_code_source<T>::count];
+#undef SYSTEM_ERROR2_GENERIC_CODE_ENTRY
+
+  constexpr inline int generic_code_max_value(size_t n = 0, int acc = 0) noexcept
+  {
+    return (n == generic_code_source<>::count) ?
+           acc :
+           generic_code_max_value(n + 1, (static_cast<int>(generic_code_source<>::entries[n].value) > acc) ? static_cast<int>(generic_code_source<>::entries[n].value) : acc);
+  }
+  static_assert(generic_code_max_value() < 4096, "errno values are too sparse for a dense table");
+  constexpr inline generic_code_entry generic_code_entry_for(int value, size_t n = 0) noexcept
+  {
+    return (value == 0) ? generic_code_entry{"Success", 7, "success", 7, errc::success} :
+           (n == generic_code_source<>::count)           ? generic_code_entry{"unknown", 7, "unknown", 7, errc::unknown} :
+           (static_cast<int>(generic_code_source<>::entries[n].value) == value) ? generic_code_source<>::entries[n] :
+                                                                                   generic_code_entry_for(value, n + 1);
+  }
+
+  // C++ 11 substitute for std::index_sequence, generated with logarithmic recursion depth
+  template <size_t... I> struct index_sequence
+  {
+  };
+  template <class A, class B> struct index_sequence_concat;
+  template <size_t... A, size_t... B> struct index_sequence_concat<index_sequence<A...>, index_sequence<B...>>
+  {
+    using type = index_sequence<A..., (sizeof...(A) + B)...>;
+  };
+  template <size_t N> struct make_index_sequence
+  {
+    using type = typename index_sequence_concat<typename make_index_sequence<N / 2>::type, typename make_index_sequence<N - N / 2>::type>::type;
+  };
+  template <> struct make_index_sequence<0>
+  {
+    using type = index_sequence<>;
+  };
+  template <> struct make_index_sequence<1>
+  {
+    using type = index_sequence<0>;
+  };
+
+  /* Every value from zero to the largest errno in `errc`, plus a trailing entry for
+  `errc::unknown` which all other values are clamped to.
+  */
+  template <class Seq> struct generic_code_table;
+  template <size_t... I> struct generic_code_table<index_sequence<I...>>
+  {
+    static constexpr size_t size = sizeof...(I);
+    static constexpr generic_code_entry entries[sizeof...(I) + 1] = {generic_code_entry_for(static_cast<int>(I))...,
+                                                            generic_code_entry{"unknown", 7, "unknown", 7, errc::unknown}};
+  };
+  template <size_t... I> constexpr generic_code_entry generic_code_table<index_sequence<I...>>::entries[sizeof...(I) + 1];
+  using generic_code_dense_table = generic_code_table<typename make_index_sequence<generic_code_max_value() + 1>::type>;
+
+  // Branch free lookup of the table entry for any value
+  constexpr inline const generic_code_entry &generic_code_lookup(errc code) noexcept
+  {
+    return generic_code_dense_table::entries[(static_cast<unsigned>(code) < generic_code_dense_table::size) ? static_cast<unsigned>(code) :
+                                                                                                                generic_code_dense_table::size];
+  }
+  constexpr inline const char *generic_code_message(errc code) noexcept { return generic_code_lookup(code).message; }
+  inline status_code_domain::string_ref generic_code_message_ref(errc code) noexcept
+  {
+    const generic_code_entry &e = generic_code_lookup(code);
+    return status_code_domain::string_ref(e.message, e.message_length);
+  }
+
+  constexpr inline int generic_code_name_compare(const char *a, const char *b) noexcept
+  {
+    return (*a != *b || *a == 0) ? (static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b)) : generic_code_name_compare(a + 1, b + 1);
+  }
+  constexpr inline bool generic_code_names_sorted(size_t n = 1) noexcept
+  {
+    return (n >= generic_code_source<>::count) ?
+           true :
+           (generic_code_name_compare(generic_code_source<>::entries[n - 1].name, generic_code_source<>::entries[n].name) < 0 && generic_code_names_sorted(n + 1));
+  }
+  static_assert(generic_code_names_sorted(), "generic_code_source must be sorted by name");
+
+  /* The entries of generic_code_source whose message is their value's message, sorted by message
+  length, then message, then value, so that errc_from_message() can binary search them. Ordering
+  by length first means few messages are compared character by character at compile time. Each
+  entry's position is its rank, the number of entries ordered before it.
+  */
+  constexpr inline bool generic_code_value_is_first(size_t k, size_t j = 0) noexcept
+  {
+    return (j == k) ? true : (generic_code_source<>::entries[j].value != generic_code_source<>::entries[k].value && generic_code_value_is_first(k, j + 1));
+  }
+  template <class Seq> struct generic_code_value_firsts;
+  template <size_t... I> struct generic_code_value_firsts<index_sequence<I...>>
+  {
+    static constexpr bool entries[sizeof...(I)] = {generic_code_value_is_first(I)...};
+  };
+  template <size_t... I> constexpr bool generic_code_value_firsts<index_sequence<I...>>::entries[sizeof...(I)];
+  using generic_code_value_first_table = generic_code_value_firsts<typename make_index_sequence<generic_code_source<>::count>::type>;
+  constexpr inline bool generic_code_message_less(size_t a, size_t b, int cmp) noexcept
+  {
+    return cmp < 0 || (cmp == 0 && static_cast<int>(generic_code_source<>::entries[a].value) < static_cast<int>(generic_code_source<>::entries[b].value));
+  }
+  constexpr inline bool generic_code_message_less(size_t a, size_t b) noexcept
+  {
+    return (generic_code_source<>::entries[a].message_length != generic_code_source<>::entries[b].message_length) ?
+           (generic_code_source<>::entries[a].message_length < generic_code_source<>::entries[b].message_length) :
+           generic_code_message_less(a, b, generic_code_name_compare(generic_code_source<>::entries[a].message, generic_code_source<>::entries[b].message));
   }
+  constexpr inline size_t generic_code_message_rank(size_t k, size_t lo = 0, size_t hi = generic_code_source<>::count) noexcept
+  {
+    return (hi - lo == 1) ? ((generic_code_value_first_table::entries[lo] && generic_code_message_less(lo, k)) ? 1 : 0) :
+                            generic_code_message_rank(k, lo, lo + (hi - lo) / 2) + generic_code_message_rank(k, lo + (hi - lo) / 2, hi);
+  }
+  constexpr inline size_t generic_code_message_count(size_t lo = 0, size_t hi = generic_code_source<>::count) noexcept
+  {
+    return (hi - lo == 1) ? (generic_code_value_first_table::entries[lo] ? 1 : 0) :
+                            generic_code_message_count(lo, lo + (hi - lo) / 2) + generic_code_message_count(lo + (hi - lo) / 2, hi);
+  }
+  template <class Seq> struct generic_code_message_ranks;
+  template <size_t... I> struct generic_code_message_ranks<index_sequence<I...>>
+  {
+    static constexpr unsigned char entries[sizeof...(I)] = {static_cast<unsigned char>(generic_code_value_first_table::entries[I] ? generic_code_message_rank(I) : 0xff)...};
+  };
+  template <size_t... I> constexpr unsigned char generic_code_message_ranks<index_sequence<I...>>::entries[sizeof...(I)];
+  using generic_code_message_rank_table = generic_code_message_ranks<typename make_index_sequence<generic_code_source<>::count>::type>;
+  // The entry whose rank is `rank`
+  constexpr inline unsigned char generic_code_message_ranked(size_t rank, size_t lo = 0, size_t hi = generic_code_source<>::count) noexcept
+  {
+    return (hi - lo == 1) ? ((generic_code_message_rank_table::entries[lo] == rank) ? static_cast<unsigned char>(lo) : 0) :
+                            static_cast<unsigned char>(generic_code_message_ranked(rank, lo, lo + (hi - lo) / 2) |
+                                                       generic_code_message_ranked(rank, lo + (hi - lo) / 2, hi));
+  }
+  template <class Seq> struct generic_code_message_sorted;
+  template <size_t... I> struct generic_code_message_sorted<index_sequence<I...>>
+  {
+    static constexpr size_t count = sizeof...(I);
+    static constexpr unsigned char entries[sizeof...(I)] = {generic_code_message_ranked(I)...};
+  };
+  template <size_t... I> constexpr unsigned char generic_code_message_sorted<index_sequence<I...>>::entries[sizeof...(I)];
+  using generic_code_message_index = generic_code_message_sorted<typename make_index_sequence<generic_code_message_count()>::type>;
+  static_assert(generic_code_source<>::count < 256, "generic_code_message_index holds entry indices in bytes");
 }  // namespace detail
 
+/*! A constexpr set of `errc` values, for testing a status code against many of them at once
+with `status_code<void>::matches()` or `classify()`. Held as a bitmask indexed by value,
+so `errc::unknown` is never a member.
+*/
+class errc_set
+{
+public:
+  //! The number of 64 bit words needed to hold a bit for every `errc` value on this platform.
+  static constexpr size_t words = static_cast<size_t>(detail::generic_code_max_value()) / 64 + 1;
+
+private:
+  uint64_t _words[words];
+
+  static constexpr uint64_t _bit(size_t word, errc e) noexcept
+  {
+    return (static_cast<unsigned>(e) <= static_cast<unsigned>(detail::generic_code_max_value()) && static_cast<unsigned>(e) / 64 == word) ?
+           (uint64_t(1) << (static_cast<unsigned>(e) % 64)) :
+           0;
+  }
+  static constexpr uint64_t _word(size_t /*unused*/) noexcept { return 0; }
+  template <class... Args> static constexpr uint64_t _word(size_t word, errc e, Args... es) noexcept { return _bit(word, e) | _word(word, es...); }
+  template <size_t... I, class... Args>
+  constexpr errc_set(detail::index_sequence<I...> /*unused*/, Args... es) noexcept
+      : _words{_word(I, es...)...}
+  {
+  }
+  struct _union
+  {
+  };
+  struct _intersection
+  {
+  };
+  template <size_t... I>
+  constexpr errc_set(detail::index_sequence<I...> /*unused*/, _union /*unused*/, const errc_set &a, const errc_set &b) noexcept
+      : _words{(a._words[I] | b._words[I])...}
+  {
+  }
+  template <size_t... I>
+  constexpr errc_set(detail::index_sequence<I...> /*unused*/, _intersection /*unused*/, const errc_set &a, const errc_set &b) noexcept
+      : _words{(a._words[I] & b._words[I])...}
+  {
+  }
+  constexpr bool _empty(size_t n = 0) const noexcept { return n == words || (_words[n] == 0 && _empty(n + 1)); }
+
+public:
+  //! Constructs an empty set.
+  constexpr errc_set() noexcept
+      : _words{}
+  {
+  }
+  //! Constructs a set of the values given.
+  template <class... Args>
+  constexpr errc_set(errc e, Args... es) noexcept  // NOLINT
+      : errc_set(typename detail::make_index_sequence<words>::type(), e, es...)
+  {
+  }
+
+  //! True if `e` is in the set.
+  constexpr bool contains(errc e) const noexcept
+  {
+    return static_cast<unsigned>(e) <= static_cast<unsigned>(detail::generic_code_max_value()) &&
+           ((_words[static_cast<unsigned>(e) / 64] >> (static_cast<unsigned>(e) % 64)) & 1) != 0;
+  }
+  //! True if the set has no members.
+  constexpr bool empty() const noexcept { return _empty(); }
+  //! The union of two sets.
+  constexpr errc_set operator|(const errc_set &o) const noexcept { return errc_set(typename detail::make_index_sequence<words>::type(), _union(), *this, o); }
+  //! The intersection of two sets.
+  constexpr errc_set operator&(const errc_set &o) const noexcept
+  {
+    return errc_set(typename detail::make_index_sequence<words>::type(), _intersection(), *this, o);
+  }
+};
+
+//! Commonly wanted sets of `errc` values.
+namespace errc_sets
+{
+  //! Failures which may well not recur if the operation is retried, perhaps after a delay.
+  constexpr errc_set transient{errc::resource_unavailable_try_again,
+                               errc::operation_would_block,
+                               errc::interrupted,
+                               errc::timed_out,
+                               errc::stream_timeout,
+                               errc::device_or_resource_busy,
+                               errc::no_buffer_space,
+                               errc::connection_aborted,
+                               errc::connection_refused,
+                               errc::connection_reset,
+                               errc::host_unreachable,
+                               errc::network_down,
+                               errc::network_reset,
+                               errc::network_unreachable};
+  //! Failures because the thing named does not exist.
+  constexpr errc_set not_found{errc::no_such_file_or_directory, errc::no_such_device, errc::no_such_device_or_address, errc::no_such_process};
+  //! Failures because the caller is not allowed to do what was asked.
+  constexpr errc_set permission{errc::permission_denied, errc::operation_not_permitted, errc::read_only_file_system};
+}  // namespace errc_sets
+
 /*! The implementation of the domain for generic status codes, those mapped by `errc` (POSIX).
  */
 class _generic_code_domain : public status_code_domain
@@ -350,8 +519,15 @@ protected:
   {
     assert(code.domain() == *this);                           // NOLINT
     const auto &c = static_cast<const generic_code &>(code);  // NOLINT
-    return string_ref(detail::generic_code_message(c.value()));
+    return detail::generic_code_message_ref(c.value());
+  }
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);                           // NOLINT
+    const auto &c = static_cast<const generic_code &>(code);  // NOLINT
+    return set.contains(c.value());
   }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
   {
@@ -369,53 +545,282 @@ inline constexpr const _generic_code_domain &_generic_code_domain::get()
 {
   return generic_code_domain;
 }
+
+namespace traits
+{
+  template <> struct is_trivially_erasable<_generic_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 // Enable implicit construction of generic_code from errc
 SYSTEM_ERROR2_CONSTEXPR14 inline generic_code make_status_code(errc c) noexcept
 {
   return generic_code(in_place, c);
 }
 
+/*! Returns the `errc` whose enumerator is named `name`, e.g. `"timed_out"`, or
+`errc::unknown` if there is none. Useful for parsing logs.
+*/
+inline errc errc_from_name(const char *name, size_t length = static_cast<size_t>(-1)) noexcept
+{
+  using source = detail::generic_code_source<>;
+  if(length == static_cast<size_t>(-1))
+  {
+    length = strlen(name);
+  }
+  if(length == 7 && memcmp(name, "success", 7) == 0)
+  {
+    return errc::success;
+  }
+  size_t lo = 0, hi = source::count;
+  while(lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    const detail::generic_code_entry &e = source::entries[mid];
+    int cmp = memcmp(e.name, name, (e.name_length < length) ? e.name_length : length);
+    if(cmp == 0)
+    {
+      cmp = (e.name_length < length) ? -1 : ((e.name_length > length) ? 1 : 0);
+    }
+    if(cmp == 0)
+    {
+      return e.value;
+    }
+    if(cmp < 0)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return errc::unknown;
+}
+
+/*! Returns the `errc` whose message is `message`, as returned by `generic_code::message()`,
+or `errc::unknown` if there is none. Where values share a message, the lowest is returned.
+Useful for parsing logs. Binary searches a constexpr index of the messages, like `errc_from_name()`.
+*/
+inline errc errc_from_message(const char *message, size_t length = static_cast<size_t>(-1)) noexcept
+{
+  using source = detail::generic_code_source<>;
+  using index = detail::generic_code_message_index;
+  if(length == static_cast<size_t>(-1))
+  {
+    length = strlen(message);
+  }
+  if(length == 7 && memcmp(message, "Success", 7) == 0)
+  {
+    return errc::success;
+  }
+  // Find the first entry not ordered before the message, which is the lowest value with that message
+  size_t lo = 0, hi = index::count;
+  while(lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    const detail::generic_code_entry &e = source::entries[index::entries[mid]];
+    const int cmp = (e.message_length != length) ? ((e.message_length < length) ? -1 : 1) : memcmp(e.message, message, length);
+    if(cmp < 0)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  if(lo < index::count)
+  {
+    const detail::generic_code_entry &e = source::entries[index::entries[lo]];
+    if(e.message_length == length && memcmp(e.message, message, length) == 0)
+    {
+      return e.value;
+    }
+  }
+  return errc::unknown;
+}
+
+/*! Writes the message of each of the `count` generic codes in `codes` into `messages`,
+and its length into `lengths`. Each is one indexed load, without branching.
+*/
+inline void generic_code_messages(const generic_code *codes, size_t count, const char **messages, size_t *lengths) noexcept
+{
+  for(size_t n = 0; n < count; n++)
+  {
+    const detail::generic_code_entry &e = detail::generic_code_lookup(codes[n].value());
+    messages[n] = e.message;
+    lengths[n] = e.message_length;
+  }
+}
+
 
 /*************************************************************************************************************/
 
 
+namespace detail
+{
+  inline SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 generic_code instrumented_dispatch::generic_code_of(const status_code_domain &domain,
+                                                                                              const status_code<void> &code) noexcept
+  {
+    SYSTEM_ERROR2_INSTRUMENT_CALL(domain, generic_code);
+    return domain._generic_code(code);
+  }
+}  // namespace detail
+
 template <class T> inline SYSTEM_ERROR2_CONSTEXPR14 bool status_code<void>::equivalent(const status_code<T> &o) const noexcept
 {
   if(_domain && o._domain)
   {
-    if(_domain->_do_equivalent(*this, o))
+    using detail::instrumented_dispatch;
+    if(instrumented_dispatch::do_equivalent(*_domain, *this, o))
     {
+      SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(*_domain, *o._domain, forward);
       return true;
     }
-    if(o._domain->_do_equivalent(o, *this))
+    if(instrumented_dispatch::do_equivalent(*o._domain, o, *this))
     {
+      SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(*_domain, *o._domain, reverse);
       return true;
     }
-    generic_code c1 = o._domain->_generic_code(o);
-    if(c1.value() != errc::unknown && _domain->_do_equivalent(*this, c1))
+    generic_code c1 = instrumented_dispatch::generic_code_of(*o._domain, o);
+    if(c1.value() != errc::unknown && instrumented_dispatch::do_equivalent(*_domain, *this, c1))
     {
+      SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(*_domain, *o._domain, via_second_generic);
       return true;
     }
-    generic_code c2 = _domain->_generic_code(*this);
-    if(c2.value() != errc::unknown && o._domain->_do_equivalent(o, c2))
+    generic_code c2 = instrumented_dispatch::generic_code_of(*_domain, *this);
+    if(c2.value() != errc::unknown && instrumented_dispatch::do_equivalent(*o._domain, o, c2))
     {
+      SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(*_domain, *o._domain, via_first_generic);
       return true;
     }
+    SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(*_domain, *o._domain, none);
   }
   // If we are both empty, we are equivalent, otherwise not equivalent
   return (!_domain && !o._domain);
 }
+inline bool status_code_domain::_do_matches(const status_code<void> &code, const errc_set &set) const noexcept
+{
+  const errc closest = _generic_code(code).value();
+  if(set.contains(closest))
+  {
+    return true;
+  }
+  for(int n = 0; n <= detail::generic_code_max_value(); n++)
+  {
+    const auto e = static_cast<errc>(n);
+    if(e != closest && set.contains(e) && _do_equivalent(code, generic_code(e)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+inline bool status_code<void>::matches(const errc_set &set) const noexcept
+{
+  return _domain != nullptr && _domain->_do_matches(*this, set);
+}
+/*! Returns the index of the first of `sets` which `code` matches, or `sets.size()` if it matches
+none of them. A code matching none costs a single call into its domain.
+*/
+inline size_t classify(const status_code<void> &code, std::initializer_list<errc_set> sets) noexcept
+{
+  errc_set all;
+  for(const auto &set : sets)
+  {
+    all = all | set;
+  }
+  if(!code.matches(all))
+  {
+    return sets.size();
+  }
+  size_t n = 0;
+  for(const auto &set : sets)
+  {
+    if(code.matches(set))
+    {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+/*! Customisation point for comparing a `status_code<DomainType1>` with a `status_code<DomainType2>`
+when both domains are known at compile time. A specialisation provides
+`static bool equivalent(const status_code<DomainType1> &, const status_code<DomainType2> &) noexcept`,
+which is only called when neither code is empty, and which must return exactly what
+`equivalent()` would. The comparison operators then skip the virtual calls of `equivalent()`.
+A specialisation for one order of domains is also used for the other. When `SYSTEM_ERROR2_INSTRUMENT`
+is enabled, specialisations are ignored so that every comparison is recorded.
+*/
+template <class DomainType1, class DomainType2> struct equivalence_traits
+{
+};
+template <> struct equivalence_traits<_generic_code_domain, _generic_code_domain>
+{
+  static constexpr bool equivalent(const generic_code &a, const generic_code &b) noexcept { return a.value() == b.value(); }
+};
+
+namespace detail
+{
+  template <class DomainType1, class DomainType2> struct has_equivalence_traits
+  {
+    template <class T>
+    static auto test(int) -> decltype(T::equivalent(std::declval<const status_code<DomainType1> &>(), std::declval<const status_code<DomainType2> &>()),
+                                      std::true_type());
+    template <class T> static std::false_type test(...);
+    static constexpr bool value = decltype(test<equivalence_traits<DomainType1, DomainType2>>(0))::value;
+  };
+  // 1 if equivalence_traits<DomainType1, DomainType2> is specialised, 2 if only the reverse is, otherwise 0
+  template <class DomainType1, class DomainType2,
+#if SYSTEM_ERROR2_INSTRUMENT
+            int = 0>
+#else
+            int = has_equivalence_traits<DomainType1, DomainType2>::value ? 1 : (has_equivalence_traits<DomainType2, DomainType1>::value ? 2 : 0)>
+#endif
+  struct typed_equivalence
+  {
+    static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
+    {
+      return a.equivalent(b);
+    }
+  };
+  template <class DomainType1, class DomainType2> struct typed_equivalence<DomainType1, DomainType2, 1>
+  {
+    static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
+    {
+      return (a.empty() || b.empty()) ? (a.empty() && b.empty()) : equivalence_traits<DomainType1, DomainType2>::equivalent(a, b);
+    }
+  };
+  template <class DomainType1, class DomainType2> struct typed_equivalence<DomainType1, DomainType2, 2>
+  {
+    static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
+    {
+      return (a.empty() || b.empty()) ? (a.empty() && b.empty()) : equivalence_traits<DomainType2, DomainType1>::equivalent(b, a);
+    }
+  };
+  template <class DomainType1, class DomainType2>
+  SYSTEM_ERROR2_CONSTEXPR14 inline bool typed_equivalent(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
+  {
+    return typed_equivalence<DomainType1, DomainType2>::equivalent(a, b);
+  }
+}  // namespace detail
+
 //! True if the status code's are semantically equal via `equivalent()`.
 template <class DomainType1, class DomainType2>
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator==(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
 {
-  return a.equivalent(b);
+  return detail::typed_equivalent(a, b);
 }
 //! True if the status code's are not semantically equal via `equivalent()`.
 template <class DomainType1, class DomainType2>
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator!=(const status_code<DomainType1> &a, const status_code<DomainType2> &b) noexcept
 {
-  return !a.equivalent(b);
+  return !detail::typed_equivalent(a, b);
 }
 //! True if the status code's are semantically equal via `equivalent()` to `make_status_code(T)`.
 SYSTEM_ERROR2_TEMPLATE(class DomainType1, class T,  //
@@ -424,7 +829,7 @@ SYSTEM_ERROR2_TEMPLATE(class DomainType1, class T,  //
 SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<MakeStatusCodeResult>::value))   // ADL makes a status code
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator==(const status_code<DomainType1> &a, const T &b)
 {
-  return a.equivalent(make_status_code(b));
+  return detail::typed_equivalent(a, make_status_code(b));
 }
 //! True if the status code's are semantically equal via `equivalent()` to `make_status_code(T)`.
 SYSTEM_ERROR2_TEMPLATE(class T, class DomainType1,  //
@@ -433,7 +838,7 @@ SYSTEM_ERROR2_TEMPLATE(class T, class DomainType1,  //
 SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<MakeStatusCodeResult>::value))   // ADL makes a status code
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator==(const T &a, const status_code<DomainType1> &b)
 {
-  return b.equivalent(make_status_code(a));
+  return detail::typed_equivalent(b, make_status_code(a));
 }
 //! True if the status code's are not semantically equal via `equivalent()` to `make_status_code(T)`.
 SYSTEM_ERROR2_TEMPLATE(class DomainType1, class T,  //
@@ -442,7 +847,7 @@ SYSTEM_ERROR2_TEMPLATE(class DomainType1, class T,  //
 SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<MakeStatusCodeResult>::value))   // ADL makes a status code
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator!=(const status_code<DomainType1> &a, const T &b)
 {
-  return !a.equivalent(make_status_code(b));
+  return !detail::typed_equivalent(a, make_status_code(b));
 }
 //! True if the status code's are semantically equal via `equivalent()` to `make_status_code(T)`.
 SYSTEM_ERROR2_TEMPLATE(class T, class DomainType1,  //
@@ -451,7 +856,7 @@ SYSTEM_ERROR2_TEMPLATE(class T, class DomainType1,  //
 SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(is_status_code<MakeStatusCodeResult>::value))   // ADL makes a status code
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator!=(const T &a, const status_code<DomainType1> &b)
 {
-  return !b.equivalent(make_status_code(a));
+  return !detail::typed_equivalent(b, make_status_code(a));
 }
 //! True if the status code's are semantically equal via `equivalent()` to `quick_status_code_from_enum<T>::code_type(b)`.
 template <class DomainType1, class T,                                                     //
@@ -459,7 +864,7 @@ template <class DomainType1, class T,
           >
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator==(const status_code<DomainType1> &a, const T &b)
 {
-  return a.equivalent(QuickStatusCodeType(b));
+  return detail::typed_equivalent(a, QuickStatusCodeType(b));
 }
 //! True if the status code's are semantically equal via `equivalent()` to `quick_status_code_from_enum<T>::code_type(a)`.
 template <class T, class DomainType1,                                                     //
@@ -467,7 +872,7 @@ template <class T, class DomainType1,
           >
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator==(const T &a, const status_code<DomainType1> &b)
 {
-  return b.equivalent(QuickStatusCodeType(a));
+  return detail::typed_equivalent(b, QuickStatusCodeType(a));
 }
 //! True if the status code's are not semantically equal via `equivalent()` to `quick_status_code_from_enum<T>::code_type(b)`.
 template <class DomainType1, class T,                                                     //
@@ -475,7 +880,7 @@ template <class DomainType1, class T,
           >
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator!=(const status_code<DomainType1> &a, const T &b)
 {
-  return !a.equivalent(QuickStatusCodeType(b));
+  return !detail::typed_equivalent(a, QuickStatusCodeType(b));
 }
 //! True if the status code's are not semantically equal via `equivalent()` to `quick_status_code_from_enum<T>::code_type(a)`.
 template <class T, class DomainType1,                                                     //
@@ -483,7 +888,7 @@ template <class T, class DomainType1,
           >
 SYSTEM_ERROR2_CONSTEXPR14 inline bool operator!=(const T &a, const status_code<DomainType1> &b)
 {
-  return !b.equivalent(QuickStatusCodeType(a));
+  return !detail::typed_equivalent(b, QuickStatusCodeType(a));
 }
 
 
@@ -132,6 +132,12 @@ protected:
       return errc::unknown;
     }
   }
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);  // NOLINT
+    return set.contains(_generic_code(code).value());
+  }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);                               // NOLINT
@@ -154,6 +160,14 @@ inline constexpr const _getaddrinfo_code_domain &_getaddrinfo_code_domain::get()
   return getaddrinfo_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_getaddrinfo_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 SYSTEM_ERROR2_NAMESPACE_END
 
 #endif
@@ -25,7 +25,9 @@ http://www.boost.org/LICENSE_1_0.txt)
 #ifndef SYSTEM_ERROR2_HTTP_STATUS_CODE_HPP
 #define SYSTEM_ERROR2_HTTP_STATUS_CODE_HPP
 
-#include "status_code.hpp"
+#include "generic_code.hpp"
+
+#include <cstdint>  // for uint64_t
 
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
@@ -52,6 +54,167 @@ namespace mixins
   };
 }  // namespace mixins
 
+namespace detail
+{
+  enum http_status_class : unsigned char
+  {
+    http_class_informational = 1,
+    http_class_success = 2,
+    http_class_redirection = 4,
+    http_class_client_error = 8,
+    http_class_server_error = 16
+  };
+  struct http_status_entry
+  {
+    const char *message;
+    unsigned short message_length;
+    unsigned char class_bits;
+    errc generic;
+  };
+  struct http_status_message_source
+  {
+    int value;
+    const char *message;
+    unsigned short message_length;
+  };
+  struct http_status_generic_source
+  {
+    int value;
+    errc generic;
+  };
+  // The known HTTP status codes with their messages, and those with a generic mapping
+  template <class T = void> struct http_status_source
+  {
+    static constexpr size_t message_count = 63;
+    static constexpr http_status_message_source messages[message_count] = {
+      {100, "Continue", sizeof("Continue") - 1},
+      {101, "Switching Protocols", sizeof("Switching Protocols") - 1},
+      {102, "Processing", sizeof("Processing") - 1},
+      {103, "Early Hints", sizeof("Early Hints") - 1},
+      {200, "OK", sizeof("OK") - 1},
+      {201, "Created", sizeof("Created") - 1},
+      {202, "Accepted", sizeof("Accepted") - 1},
+      {203, "Non-Authoritative Information", sizeof("Non-Authoritative Information") - 1},
+      {204, "No Content", sizeof("No Content") - 1},
+      {205, "Reset Content", sizeof("Reset Content") - 1},
+      {206, "Partial Content", sizeof("Partial Content") - 1},
+      {207, "Multi-Status", sizeof("Multi-Status") - 1},
+      {208, "Already Reported", sizeof("Already Reported") - 1},
+      {209, "IM Used", sizeof("IM Used") - 1},
+      {300, "Multiple Choices", sizeof("Multiple Choices") - 1},
+      {301, "Moved Permanently", sizeof("Moved Permanently") - 1},
+      {302, "Found", sizeof("Found") - 1},
+      {303, "See Other", sizeof("See Other") - 1},
+      {304, "Not Modified", sizeof("Not Modified") - 1},
+      {305, "Use Proxy", sizeof("Use Proxy") - 1},
+      {306, "Switch Proxy", sizeof("Switch Proxy") - 1},
+      {307, "Temporary Redirect", sizeof("Temporary Redirect") - 1},
+      {308, "Permanent Redirect", sizeof("Permanent Redirect") - 1},
+      {400, "Bad Request", sizeof("Bad Request") - 1},
+      {401, "Unauthorized", sizeof("Unauthorized") - 1},
+      {402, "Payment Required", sizeof("Payment Required") - 1},
+      {403, "Forbidden", sizeof("Forbidden") - 1},
+      {404, "Not Found", sizeof("Not Found") - 1},
+      {405, "Method Not Allowed", sizeof("Method Not Allowed") - 1},
+      {406, "Not Acceptable", sizeof("Not Acceptable") - 1},
+      {407, "Proxy Authentication Required", sizeof("Proxy Authentication Required") - 1},
+      {408, "Request Timeout", sizeof("Request Timeout") - 1},
+      {409, "Conflict", sizeof("Conflict") - 1},
+      {410, "Gone", sizeof("Gone") - 1},
+      {411, "Length Required", sizeof("Length Required") - 1},
+      {412, "Precondition Failed", sizeof("Precondition Failed") - 1},
+      {413, "Payload Too Large", sizeof("Payload Too Large") - 1},
+      {414, "URI Too Long", sizeof("URI Too Long") - 1},
+      {415, "Unsupported Media Type", sizeof("Unsupported Media Type") - 1},
+      {416, "Range Not Satisfiable", sizeof("Range Not Satisfiable") - 1},
+      {417, "Expectation Failed", sizeof("Expectation Failed") - 1},
+      {418, "I'm a teapot", sizeof("I'm a teapot") - 1},
+      {421, "Misdirected Request", sizeof("Misdirected Request") - 1},
+      {422, "Unprocessable Entity", sizeof("Unprocessable Entity") - 1},
+      {423, "Locked", sizeof("Locked") - 1},
+      {424, "Failed Dependency", sizeof("Failed Dependency") - 1},
+      {425, "Too Early", sizeof("Too Early") - 1},
+      {426, "Upgrade Required", sizeof("Upgrade Required") - 1},
+      {428, "Precondition Required", sizeof("Precondition Required") - 1},
+      {429, "Too Many Requests", sizeof("Too Many Requests") - 1},
+      {431, "Request Header Fields Too Large", sizeof("Request Header Fields Too Large") - 1},
+      {451, "Unavailable For Legal Reasons", sizeof("Unavailable For Legal Reasons") - 1},
+      {500, "Internal Server Error", sizeof("Internal Server Error") - 1},
+      {501, "Not Implemented", sizeof("Not Implemented") - 1},
+      {502, "Bad Gateway", sizeof("Bad Gateway") - 1},
+      {503, "Service Unavailable", sizeof("Service Unavailable") - 1},
+      {504, "Gateway Timeout", sizeof("Gateway Timeout") - 1},
+      {505, "HTTP Version Not Supported", sizeof("HTTP Version Not Supported") - 1},
+      {506, "Variant Also Negotiates", sizeof("Variant Also Negotiates") - 1},
+      {507, "Insufficient Storage", sizeof("Insufficient Storage") - 1},
+      {508, "Loop Detected", sizeof("Loop Detected") - 1},
+      {510, "Not Extended", sizeof("Not Extended") - 1},
+      {511, "Network Authentication Required", sizeof("Network Authentication Required") - 1},
+    };
+    static constexpr size_t generic_count = 16;
+    static constexpr http_status_generic_source generics[generic_count] = {
+      {102, errc::operation_in_progress},
+      {202, errc::operation_in_progress},
+      {400, errc::invalid_argument},
+      {401, errc::operation_not_permitted},
+      {403, errc::permission_denied},
+      {404, errc::no_such_file_or_directory},
+      {405, errc::operation_not_supported},
+      {406, errc::protocol_not_supported},
+      {408, errc::timed_out},
+      {410, errc::no_such_file_or_directory},
+      {413, errc::result_out_of_range},
+      {418, errc::operation_not_supported},
+      {501, errc::not_supported},
+      {503, errc::resource_unavailable_try_again},
+      {504, errc::timed_out},
+      {507, errc::no_space_on_device},
+    };
+  };
+  template <class T> constexpr http_status_message_source http_status_source<T>::messages[http_status_source<T>::message_count];
+  template <class T> constexpr http_status_generic_source http_status_source<T>::generics[http_status_source<T>::generic_count];
+
+  constexpr inline http_status_message_source http_status_message_for(int value, size_t n = 0) noexcept
+  {
+    return (n == http_status_source<>::message_count)          ? http_status_message_source{value, "Unknown", 7} :
+           (http_status_source<>::messages[n].value == value) ? http_status_source<>::messages[n] :
+                                                                  http_status_message_for(value, n + 1);
+  }
+  constexpr inline errc http_status_generic_for(int value, size_t n = 0) noexcept
+  {
+    return (n == http_status_source<>::generic_count)          ? errc::unknown :
+           (http_status_source<>::generics[n].value == value) ? http_status_source<>::generics[n].generic :
+                                                                  http_status_generic_for(value, n + 1);
+  }
+  constexpr inline http_status_entry http_status_entry_for(int value) noexcept
+  {
+    return http_status_entry{http_status_message_for(value).message, http_status_message_for(value).message_length,
+                             static_cast<unsigned char>(1u << (value / 100 - 1)), http_status_generic_for(value)};
+  }
+
+  /* Every value from 100 to 599, plus a trailing entry with no class bits for all
+  other values, which are clamped to it.
+  */
+  template <class Seq> struct http_status_table;
+  template <size_t... I> struct http_status_table<index_sequence<I...>>
+  {
+    static constexpr int first = 100;
+    static constexpr size_t size = sizeof...(I);
+    static constexpr http_status_entry entries[sizeof...(I) + 1] = {http_status_entry_for(first + static_cast<int>(I))...,
+                                                                   http_status_entry{"Unknown", 7, 0, errc::unknown}};
+  };
+  template <size_t... I> constexpr http_status_entry http_status_table<index_sequence<I...>>::entries[sizeof...(I) + 1];
+  using http_status_dense_table = http_status_table<typename make_index_sequence<500>::type>;
+
+  // Branch free lookup of the table entry for any value
+  constexpr inline const http_status_entry &http_status_lookup(int value) noexcept
+  {
+    return http_status_dense_table::entries[(static_cast<unsigned>(value - http_status_dense_table::first) < http_status_dense_table::size) ?
+                                            static_cast<unsigned>(value - http_status_dense_table::first) :
+                                            http_status_dense_table::size];
+  }
+}  // namespace detail
+
 /*! The implementation of the domain for HTTP status codes.
  */
 class _http_status_code_domain : public status_code_domain
@@ -108,180 +271,21 @@ protected:
   {
     assert(code.domain() == *this);                               // NOLINT
     const auto &c = static_cast<const http_status_code &>(code);  // NOLINT
-    switch(c.value())
-    {
-    case 102:
-    case 202:
-      return errc::operation_in_progress;
-    case 400:
-      return errc::invalid_argument;
-    case 401:
-      return errc::operation_not_permitted;
-    case 403:
-      return errc::permission_denied;
-    case 404:
-    case 410:
-      return errc::no_such_file_or_directory;
-    case 405:
-    case 418:
-      return errc::operation_not_supported;
-    case 406:
-      return errc::protocol_not_supported;
-    case 408:
-      return errc::timed_out;
-    case 413:
-      return errc::result_out_of_range;
-    case 501:
-      return errc::not_supported;
-    case 503:
-      return errc::resource_unavailable_try_again;
-    case 504:
-      return errc::timed_out;
-    case 507:
-      return errc::no_space_on_device;
-    default:
-      return errc::unknown;
-    }
+    return detail::http_status_lookup(c.value()).generic;
+  }
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);                               // NOLINT
+    const auto &c = static_cast<const http_status_code &>(code);  // NOLINT
+    return set.contains(detail::http_status_lookup(c.value()).generic);
   }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);                               // NOLINT
     const auto &c = static_cast<const http_status_code &>(code);  // NOLINT
-    return string_ref(
-    [&]() -> const char *
-    {
-      switch(c.value())
-      {
-      case 100:
-        return "Continue";
-      case 101:
-        return "Switching Protocols";
-      case 102:
-        return "Processing";
-      case 103:
-        return "Early Hints";
-      case 200:
-        return "OK";
-      case 201:
-        return "Created";
-      case 202:
-        return "Accepted";
-      case 203:
-        return "Non-Authoritative Information";
-      case 204:
-        return "No Content";
-      case 205:
-        return "Reset Content";
-      case 206:
-        return "Partial Content";
-      case 207:
-        return "Multi-Status";
-      case 208:
-        return "Already Reported";
-      case 209:
-        return "IM Used";
-      case 300:
-        return "Multiple Choices";
-      case 301:
-        return "Moved Permanently";
-      case 302:
-        return "Found";
-      case 303:
-        return "See Other";
-      case 304:
-        return "Not Modified";
-      case 305:
-        return "Use Proxy";
-      case 306:
-        return "Switch Proxy";
-      case 307:
-        return "Temporary Redirect";
-      case 308:
-        return "Permanent Redirect";
-      case 400:
-        return "Bad Request";
-      case 401:
-        return "Unauthorized";
-      case 402:
-        return "Payment Required";
-      case 403:
-        return "Forbidden";
-      case 404:
-        return "Not Found";
-      case 405:
-        return "Method Not Allowed";
-      case 406:
-        return "Not Acceptable";
-      case 407:
-        return "Proxy Authentication Required";
-      case 408:
-        return "Request Timeout";
-      case 409:
-        return "Conflict";
-      case 410:
-        return "Gone";
-      case 411:
-        return "Length Required";
-      case 412:
-        return "Precondition Failed";
-      case 413:
-        return "Payload Too Large";
-      case 414:
-        return "URI Too Long";
-      case 415:
-        return "Unsupported Media Type";
-      case 416:
-        return "Range Not Satisfiable";
-      case 417:
-        return "Expectation Failed";
-      case 418:
-        return "I'm a teapot";
-      case 421:
-        return "Misdirected Request";
-      case 422:
-        return "Unprocessable Entity";
-      case 423:
-        return "Locked";
-      case 424:
-        return "Failed Dependency";
-      case 425:
-        return "Too Early";
-      case 426:
-        return "Upgrade Required";
-      case 428:
-        return "Precondition Required";
-      case 429:
-        return "Too Many Requests";
-      case 431:
-        return "Request Header Fields Too Large";
-      case 451:
-        return "Unavailable For Legal Reasons";
-      case 500:
-        return "Internal Server Error";
-      case 501:
-        return "Not Implemented";
-      case 502:
-        return "Bad Gateway";
-      case 503:
-        return "Service Unavailable";
-      case 504:
-        return "Gateway Timeout";
-      case 505:
-        return "HTTP Version Not Supported";
-      case 506:
-        return "Variant Also Negotiates";
-      case 507:
-        return "Insufficient Storage";
-      case 508:
-        return "Loop Detected";
-      case 510:
-        return "Not Extended";
-      case 511:
-        return "Network Authentication Required";
-      default:
-        return "Unknown";
-      }
-    }());
+    const detail::http_status_entry &e = detail::http_status_lookup(c.value());
+    return string_ref(e.message, e.message_length);
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
@@ -299,35 +303,114 @@ inline constexpr const _http_status_code_domain &_http_status_code_domain::get()
   return http_status_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_http_status_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 namespace mixins
 {
   template <class Base> inline bool mixin<Base, _http_status_code_domain>::is_http_informational() const noexcept
   {
     const auto &c = static_cast<const http_status_code *>(this)->value();
-    return c >= 100 && c < 200;
+    return (detail::http_status_lookup(c).class_bits & detail::http_class_informational) != 0;
   }
   template <class Base> inline bool mixin<Base, _http_status_code_domain>::is_http_success() const noexcept
   {
     const auto &c = static_cast<const http_status_code *>(this)->value();
-    return c >= 200 && c < 300;
+    return (detail::http_status_lookup(c).class_bits & detail::http_class_success) != 0;
   }
   template <class Base> inline bool mixin<Base, _http_status_code_domain>::is_http_redirection() const noexcept
   {
     const auto &c = static_cast<const http_status_code *>(this)->value();
-    return c >= 300 && c < 400;
+    return (detail::http_status_lookup(c).class_bits & detail::http_class_redirection) != 0;
   }
   template <class Base> inline bool mixin<Base, _http_status_code_domain>::is_http_client_error() const noexcept
   {
     const auto &c = static_cast<const http_status_code *>(this)->value();
-    return c >= 400 && c < 500;
+    return (detail::http_status_lookup(c).class_bits & detail::http_class_client_error) != 0;
   }
   template <class Base> inline bool mixin<Base, _http_status_code_domain>::is_http_server_error() const noexcept
   {
     const auto &c = static_cast<const http_status_code *>(this)->value();
-    return c >= 500 && c < 600;
+    return (detail::http_status_lookup(c).class_bits & detail::http_class_server_error) != 0;
   }
 }  // namespace mixins
 
+namespace detail
+{
+  // Matches "HTTP/1.x" in eight bytes, and three ASCII digits after a space in four, a SIMD within a register at a time
+  inline bool http_status_line_prefix(const char *p, int &value) noexcept
+  {
+    static constexpr const char pattern[8] = {'H', 'T', 'T', 'P', '/', '1', '.', '0'};
+    static constexpr const unsigned char mask[8] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe};  // '0' and '1' differ in the lowest bit
+    uint64_t word, patternword, maskword;
+    memcpy(&word, p, 8);
+    memcpy(&patternword, pattern, 8);
+    memcpy(&maskword, mask, 8);
+    // The fourth byte is padded with an ASCII digit. As every byte is checked alike, byte order does not matter
+    const char digits[4] = {p[9], p[10], p[11], '0'};
+    uint32_t d;
+    memcpy(&d, digits, 4);
+    const bool ok = ((word & maskword) == patternword) & (p[8] == ' ') & ((d & 0xf0f0f0f0) == 0x30303030) & (((d + 0x06060606) & 0xf0f0f0f0) == 0x30303030);
+    value = (digits[0] - '0') * 100 + (digits[1] - '0') * 10 + (digits[2] - '0');
+    return ok;
+  }
+}  // namespace detail
+
+/*! Parses the HTTP/1.x status line at the start of the `length` bytes at `buffer`,
+such as `HTTP/1.1 404 Not Found\r\n`, into `code`. Returns the length of the status
+line including its line ending, or zero if the bytes do not start with a complete
+well formed status line of a code between 100 and 599, in which case `code` is not
+changed. Never allocates.
+*/
+inline size_t parse_http_status_line(http_status_code &code, const char *buffer, size_t length) noexcept
+{
+  int value = 0;
+  if(length < 13 || !detail::http_status_line_prefix(buffer, value) || value < 100 || value > 599 ||
+     (buffer[12] != ' ' && buffer[12] != '\r' && buffer[12] != '\n'))
+  {
+    return 0;
+  }
+  const auto *eol = static_cast<const char *>(memchr(buffer + 12, '\n', length - 12));
+  if(eol == nullptr)
+  {
+    return 0;
+  }
+  code = http_status_code(value);
+  return static_cast<size_t>(eol - buffer) + 1;
+}
+
+/*! Parses consecutive HTTP/1.x status lines in the `length` bytes at `buffer` into
+up to `max` codes at `codes`, as `parse_http_status_line()` would. Lines which are not
+well formed status lines yield empty codes. Returns the number of lines parsed, which
+excludes any incomplete final line.
+*/
+inline size_t parse_http_status_lines(http_status_code *codes, size_t max, const char *buffer, size_t length) noexcept
+{
+  size_t count = 0;
+  while(count < max && length > 0)
+  {
+    size_t consumed = parse_http_status_line(codes[count], buffer, length);
+    if(consumed == 0)
+    {
+      const auto *eol = static_cast<const char *>(memchr(buffer, '\n', length));
+      if(eol == nullptr)
+      {
+        break;
+      }
+      codes[count].clear();
+      consumed = static_cast<size_t>(eol - buffer) + 1;
+    }
+    buffer += consumed;
+    length -= consumed;
+    count++;
+  }
+  return count;
+}
 
 SYSTEM_ERROR2_NAMESPACE_END
 
@@ -0,0 +1,320 @@
+/* Instrumentation of SG14 status_code domain dispatch
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_INSTRUMENTATION_HPP
+#define SYSTEM_ERROR2_INSTRUMENTATION_HPP
+
+#include "status_code_domain.hpp"
+
+#if SYSTEM_ERROR2_INSTRUMENT_TIMING
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>  // for __rdtsc
+#elif !(defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)))
+#include <chrono>
+#endif
+#endif
+
+#ifndef SYSTEM_ERROR2_INSTRUMENT_DOMAINS
+//! The number of distinct domains whose operations can be counted. Can be overriden via predefinition, must be a power of two.
+#define SYSTEM_ERROR2_INSTRUMENT_DOMAINS 256
+#endif
+#ifndef SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS
+//! The number of distinct pairs of domains whose `equivalent()` stages can be counted. Can be overriden via predefinition, must be a power of two.
+#define SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS 1024
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+//! The operations of `status_code_domain` which are instrumented.
+enum class domain_operation : unsigned char
+{
+  failure,         //!< `_do_failure()`
+  equivalent,      //!< `_do_equivalent()`
+  generic_code,    //!< `_generic_code()`
+  message,         //!< `_do_message()`
+  message_into,    //!< `_do_message_into()`
+  erased_copy,     //!< `_do_erased_copy()`
+  erased_destroy,  //!< `_do_erased_destroy()`
+  _count
+};
+
+//! The stage of `status_code<void>::equivalent()` which produced the answer.
+enum class equivalence_stage : unsigned char
+{
+  none,               //!< No stage found equivalence
+  forward,            //!< The first domain's `_do_equivalent()` with the second code
+  reverse,            //!< The second domain's `_do_equivalent()` with the first code
+  via_second_generic, //!< The first domain's `_do_equivalent()` with the second code's generic code
+  via_first_generic,  //!< The second domain's `_do_equivalent()` with the first code's generic code
+  _count
+};
+
+//! The counts of calls of each operation upon a domain.
+struct domain_operation_stats
+{
+  //! The domain.
+  const status_code_domain *domain{nullptr};
+  //! The number of calls of each operation, indexed by `domain_operation`.
+  unsigned long long calls[static_cast<size_t>(domain_operation::_count)]{};
+  //! The cycles (or ticks) spent in each operation if `SYSTEM_ERROR2_INSTRUMENT_TIMING` is enabled, otherwise zero.
+  unsigned long long cycles[static_cast<size_t>(domain_operation::_count)]{};
+};
+
+//! The counts of the stages which answered `equivalent()` for an ordered pair of domains.
+struct equivalence_stage_stats
+{
+  //! The domain of the code upon which `equivalent()` was called.
+  const status_code_domain *first{nullptr};
+  //! The domain of the code passed to `equivalent()`.
+  const status_code_domain *second{nullptr};
+  //! The number of answers from each stage, indexed by `equivalence_stage`.
+  unsigned long long answers[static_cast<size_t>(equivalence_stage::_count)]{};
+};
+
+namespace detail
+{
+  static_assert((SYSTEM_ERROR2_INSTRUMENT_DOMAINS & (SYSTEM_ERROR2_INSTRUMENT_DOMAINS - 1)) == 0, "SYSTEM_ERROR2_INSTRUMENT_DOMAINS must be a power of two");
+  static_assert((SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS & (SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS - 1)) == 0,
+                "SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS must be a power of two");
+
+  /* Insert-only open addressing tables shared by all threads. A slot is claimed by
+  CASing its state from empty to busy, its key is written, and then its state is released
+  as ready, after which its key never changes.
+  */
+  struct instrumented_domain_slot
+  {
+    std::atomic<unsigned> state;  // 0 = empty, 1 = key being written, 2 = ready
+    const status_code_domain *domain;
+    unsigned long long id;
+    std::atomic<unsigned long long> calls[static_cast<size_t>(domain_operation::_count)];
+    std::atomic<unsigned long long> cycles[static_cast<size_t>(domain_operation::_count)];
+  };
+  struct instrumented_domain_pair_slot
+  {
+    std::atomic<unsigned> state;  // 0 = empty, 1 = key being written, 2 = ready
+    const status_code_domain *first, *second;
+    unsigned long long id1, id2;
+    std::atomic<unsigned long long> answers[static_cast<size_t>(equivalence_stage::_count)];
+  };
+  struct instrumentation_state
+  {
+    instrumented_domain_slot domains[SYSTEM_ERROR2_INSTRUMENT_DOMAINS];
+    instrumented_domain_pair_slot pairs[SYSTEM_ERROR2_INSTRUMENT_DOMAIN_PAIRS];
+  };
+  inline instrumentation_state &instrumentation() noexcept
+  {
+    static instrumentation_state v;
+    return v;
+  }
+
+  // Finds or inserts the slot whose key matches, returning null if the table is full
+  template <class Slot, size_t N, class Match, class Init> inline Slot *find_or_insert_instrumented(Slot (&slots)[N], unsigned hash, Match &&match, Init &&init) noexcept
+  {
+    for(size_t n = 0; n < N; n++)
+    {
+      Slot &s = slots[(hash + n) & (N - 1)];
+      unsigned state = s.state.load(std::memory_order_acquire);
+      if(state == 0 && s.state.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_acquire))
+      {
+        init(s);
+        s.state.store(2, std::memory_order_release);
+        return &s;
+      }
+      while(state == 1)
+      {
+        state = s.state.load(std::memory_order_acquire);
+      }
+      if(match(s))
+      {
+        return &s;
+      }
+    }
+    return nullptr;
+  }
+  inline instrumented_domain_slot *instrumented_domain(const status_code_domain &domain) noexcept
+  {
+    const unsigned long long id = domain.id();
+    return find_or_insert_instrumented(
+    instrumentation().domains, static_cast<unsigned>((id * 0x9e3779b97f4a7c15ULL) >> 40), [id](const instrumented_domain_slot &s) { return s.id == id; },
+    [&](instrumented_domain_slot &s)
+    {
+      s.domain = &domain;
+      s.id = id;
+    });
+  }
+
+  //! \exclude Returns a timestamp if timing is enabled.
+  inline unsigned long long instrument_begin() noexcept
+  {
+#if SYSTEM_ERROR2_INSTRUMENT_TIMING
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    unsigned long long ret;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(ret));
+    return ret;
+#else
+    return static_cast<unsigned long long>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+#else
+    return 0;
+#endif
+  }
+  //! \exclude Counts a call of `op` upon `domain` which began at `start`.
+  inline void instrument_end(const status_code_domain &domain, domain_operation op, unsigned long long start) noexcept
+  {
+#if SYSTEM_ERROR2_INSTRUMENT_TIMING
+    const unsigned long long elapsed = instrument_begin() - start;
+#endif
+    if(instrumented_domain_slot *s = instrumented_domain(domain))
+    {
+      s->calls[static_cast<size_t>(op)].fetch_add(1, std::memory_order_relaxed);
+#if SYSTEM_ERROR2_INSTRUMENT_TIMING
+      s->cycles[static_cast<size_t>(op)].fetch_add(elapsed, std::memory_order_relaxed);
+#else
+      (void) start;
+#endif
+    }
+  }
+  //! \exclude Counts, and if enabled times, a call of `op` upon `domain` lasting the lifetime of this object.
+  class instrumented_call
+  {
+    const status_code_domain &_domain;
+    domain_operation _op;
+    unsigned long long _start;
+
+  public:
+    instrumented_call(const status_code_domain &domain, domain_operation op) noexcept
+        : _domain(domain)
+        , _op(op)
+        , _start(instrument_begin())
+    {
+    }
+    instrumented_call(const instrumented_call &) = delete;
+    instrumented_call(instrumented_call &&) = delete;
+    instrumented_call &operator=(const instrumented_call &) = delete;
+    instrumented_call &operator=(instrumented_call &&) = delete;
+    ~instrumented_call() { instrument_end(_domain, _op, _start); }
+  };
+  //! \exclude Counts an answer from `stage` for `equivalent()` between codes of `first` and `second`.
+  inline void instrument_equivalence_stage(const status_code_domain &first, const status_code_domain &second, equivalence_stage stage) noexcept
+  {
+    const unsigned long long id1 = first.id(), id2 = second.id();
+    instrumented_domain_pair_slot *s = find_or_insert_instrumented(
+    instrumentation().pairs, static_cast<unsigned>(((id1 * 0x9e3779b97f4a7c15ULL) ^ (id2 * 0xff51afd7ed558ccdULL)) >> 40),
+    [id1, id2](const instrumented_domain_pair_slot &s) { return s.id1 == id1 && s.id2 == id2; },
+    [&](instrumented_domain_pair_slot &s)
+    {
+      s.first = &first;
+      s.second = &second;
+      s.id1 = id1;
+      s.id2 = id2;
+    });
+    if(s != nullptr)
+    {
+      s->answers[static_cast<size_t>(stage)].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}  // namespace detail
+
+/*! Copies the operation counts of up to `max` domains into `out`, returning the
+number of domains instrumented, which may exceed `max`. Counts are only ever made
+when `SYSTEM_ERROR2_INSTRUMENT` is enabled.
+*/
+inline size_t snapshot_domain_operations(domain_operation_stats *out, size_t max) noexcept
+{
+  size_t n = 0;
+  for(auto &s : detail::instrumentation().domains)
+  {
+    if(s.state.load(std::memory_order_acquire) != 2)
+    {
+      continue;
+    }
+    if(n < max)
+    {
+      out[n].domain = s.domain;
+      for(size_t op = 0; op < static_cast<size_t>(domain_operation::_count); op++)
+      {
+        out[n].calls[op] = s.calls[op].load(std::memory_order_relaxed);
+        out[n].cycles[op] = s.cycles[op].load(std::memory_order_relaxed);
+      }
+    }
+    n++;
+  }
+  return n;
+}
+
+/*! Copies the `equivalent()` stage counts of up to `max` ordered domain pairs into
+`out`, returning the number of pairs instrumented, which may exceed `max`. Pairs often
+answered by the generic code stages, or not at all, are candidates for a fast path.
+*/
+inline size_t snapshot_equivalence_stages(equivalence_stage_stats *out, size_t max) noexcept
+{
+  size_t n = 0;
+  for(auto &s : detail::instrumentation().pairs)
+  {
+    if(s.state.load(std::memory_order_acquire) != 2)
+    {
+      continue;
+    }
+    if(n < max)
+    {
+      out[n].first = s.first;
+      out[n].second = s.second;
+      for(size_t stage = 0; stage < static_cast<size_t>(equivalence_stage::_count); stage++)
+      {
+        out[n].answers[stage] = s.answers[stage].load(std::memory_order_relaxed);
+      }
+    }
+    n++;
+  }
+  return n;
+}
+
+//! Resets all instrumentation counts to zero.
+inline void reset_instrumentation() noexcept
+{
+  detail::instrumentation_state &state = detail::instrumentation();
+  for(auto &s : state.domains)
+  {
+    for(size_t op = 0; op < static_cast<size_t>(domain_operation::_count); op++)
+    {
+      s.calls[op].store(0, std::memory_order_relaxed);
+      s.cycles[op].store(0, std::memory_order_relaxed);
+    }
+  }
+  for(auto &s : state.pairs)
+  {
+    for(auto &a : s.answers)
+    {
+      a.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
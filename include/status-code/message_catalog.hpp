@@ -0,0 +1,287 @@
+/* Memory mapped message catalogs for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_MESSAGE_CATALOG_HPP
+#define SYSTEM_ERROR2_MESSAGE_CATALOG_HPP
+
+#include "generic_code.hpp"
+
+#include <cstdint>  // for uint64_t
+
+#if !defined(_WIN32) && !defined(SYSTEM_ERROR2_NOT_POSIX)
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#endif
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  /* A catalog is a header, followed by entries sorted by domain id then value, followed
+  by a blob of null terminated strings which the entries index. All integers are in the
+  byte order of the machine which compiled the catalog, so a catalog from a machine of
+  the other byte order fails the version check.
+  */
+  struct message_catalog_header
+  {
+    char magic[8];  // "SE2MCAT" plus null terminator
+    uint32_t version;
+    uint32_t count;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+  };
+  struct message_catalog_entry
+  {
+    uint64_t domain;
+    int64_t value;
+    uint64_t offset;  // into the strings blob
+    uint64_t length;  // excluding the null terminator
+  };
+  static constexpr const char message_catalog_magic[8] = "SE2MCAT";
+  static constexpr uint32_t message_catalog_version = 1;
+}  // namespace detail
+
+/*! A read only catalog of messages keyed by status code domain id and value, usually
+memory mapped from a file compiled by `utils/compile-message-catalog.cpp`.
+
+Opening a catalog validates its header only, so is O(1) in the size of the catalog.
+Lookups are a binary search of the index, returning pointers into the catalog's
+memory, so they never copy nor allocate. Messages returned remain valid for the
+lifetime of the catalog.
+
+If `SYSTEM_ERROR2_MESSAGE_CATALOGS` is enabled, the `message()` and `message_into()`
+of `posix_code` and of status codes from `quick_status_code_from_enum` look up the
+catalog installed with `install_message_catalog()` first, falling back to their
+usual messages if the catalog has none.
+*/
+class message_catalog
+{
+  const char *_data{nullptr};
+  size_t _size{0};
+  bool _mapped{false};
+  const detail::message_catalog_entry *_entries{nullptr};
+  size_t _count{0};
+  const char *_strings{nullptr};
+  size_t _strings_size{0};
+
+  bool _attach(const char *data, size_t size) noexcept
+  {
+    detail::message_catalog_header header;
+    if(size < sizeof(header))
+    {
+      return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if(memcmp(header.magic, detail::message_catalog_magic, sizeof(header.magic)) != 0 || header.version != detail::message_catalog_version)
+    {
+      return false;
+    }
+    const uint64_t entries_end = sizeof(header) + static_cast<uint64_t>(header.count) * sizeof(detail::message_catalog_entry);
+    if(entries_end > size || header.strings_offset < entries_end || header.strings_offset > size || header.strings_size > size - header.strings_offset)
+    {
+      return false;
+    }
+    if(reinterpret_cast<uintptr_t>(data) % alignof(detail::message_catalog_entry) != 0)  // NOLINT
+    {
+      return false;
+    }
+    _data = data;
+    _size = size;
+    _entries = reinterpret_cast<const detail::message_catalog_entry *>(data + sizeof(header));  // NOLINT
+    _count = header.count;
+    _strings = data + header.strings_offset;
+    _strings_size = static_cast<size_t>(header.strings_size);
+    return true;
+  }
+  void _reset() noexcept
+  {
+#if !defined(_WIN32) && !defined(SYSTEM_ERROR2_NOT_POSIX)
+    if(_mapped)
+    {
+      ::munmap(const_cast<char *>(_data), _size);  // NOLINT
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+    _entries = nullptr;
+    _count = 0;
+    _strings = nullptr;
+    _strings_size = 0;
+  }
+
+public:
+  //! Constructs an empty catalog
+  constexpr message_catalog() noexcept {}
+  /*! Constructs a catalog over `size` bytes of compiled catalog at `data`, which must
+  be suitably aligned and outlive this catalog. Check `empty()` for whether the catalog
+  was valid.
+  */
+  message_catalog(const void *data, size_t size) noexcept
+  {
+    if(!_attach(static_cast<const char *>(data), size))
+    {
+      _reset();
+    }
+  }
+  message_catalog(const message_catalog &) = delete;
+  message_catalog(message_catalog &&o) noexcept
+      : _data(o._data)
+      , _size(o._size)
+      , _mapped(o._mapped)
+      , _entries(o._entries)
+      , _count(o._count)
+      , _strings(o._strings)
+      , _strings_size(o._strings_size)
+  {
+    o._mapped = false;
+    o._reset();
+  }
+  message_catalog &operator=(const message_catalog &) = delete;
+  message_catalog &operator=(message_catalog &&o) noexcept
+  {
+    if(this != &o)
+    {
+      this->~message_catalog();
+      new(this) message_catalog(static_cast<message_catalog &&>(o));
+    }
+    return *this;
+  }
+  ~message_catalog() { _reset(); }
+
+#if !defined(_WIN32) && !defined(SYSTEM_ERROR2_NOT_POSIX)
+  /*! Memory maps the compiled catalog at `path`, replacing any catalog currently held.
+  Returns `errc::bad_message` if the file is not a valid catalog.
+  */
+  generic_code open(const char *path) noexcept
+  {
+    _reset();
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);  // NOLINT
+    if(fd == -1)
+    {
+      return generic_code(static_cast<errc>(errno));
+    }
+    struct stat s;
+    if(::fstat(fd, &s) == -1)
+    {
+      const int code = errno;
+      ::close(fd);
+      return generic_code(static_cast<errc>(code));
+    }
+    if(s.st_size <= 0)
+    {
+      ::close(fd);
+      return generic_code(errc::bad_message);
+    }
+    void *p = ::mmap(nullptr, static_cast<size_t>(s.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    const int code = errno;
+    ::close(fd);
+    if(p == MAP_FAILED)  // NOLINT
+    {
+      return generic_code(static_cast<errc>(code));
+    }
+    if(!_attach(static_cast<const char *>(p), static_cast<size_t>(s.st_size)))
+    {
+      ::munmap(p, static_cast<size_t>(s.st_size));
+      _reset();
+      return generic_code(errc::bad_message);
+    }
+    _mapped = true;
+    return generic_code(errc::success);
+  }
+#endif
+
+  //! True if the catalog holds no messages
+  SYSTEM_ERROR2_NODISCARD bool empty() const noexcept { return _count == 0; }
+  //! The number of messages in the catalog
+  size_t size() const noexcept { return _count; }
+
+  /*! Returns the null terminated message for `value` in the domain with id `domain`,
+  setting `length` to its length, or returns null if there is none.
+  */
+  const char *find(status_code_domain::unique_id_type domain, int64_t value, size_t &length) const noexcept
+  {
+    size_t lo = 0, hi = _count;
+    while(lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+      const detail::message_catalog_entry &e = _entries[mid];
+      if(e.domain < domain || (e.domain == domain && e.value < value))
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+    if(lo == _count || _entries[lo].domain != domain || _entries[lo].value != value)
+    {
+      return nullptr;
+    }
+    // Entries are validated upon lookup rather than when opening
+    const detail::message_catalog_entry &e = _entries[lo];
+    if(e.offset >= _strings_size || e.length >= _strings_size - e.offset || _strings[e.offset + e.length] != 0)
+    {
+      return nullptr;
+    }
+    length = static_cast<size_t>(e.length);
+    return _strings + e.offset;
+  }
+};
+
+namespace detail
+{
+  inline std::atomic<const message_catalog *> &installed_message_catalog_storage() noexcept
+  {
+    static std::atomic<const message_catalog *> v(nullptr);
+    return v;
+  }
+  // Returns the message of the installed catalog, or null if there is none
+  inline const char *find_catalog_message(status_code_domain::unique_id_type domain, int64_t value, size_t &length) noexcept
+  {
+    const message_catalog *catalog = installed_message_catalog_storage().load(std::memory_order_acquire);
+    return (catalog != nullptr) ? catalog->find(domain, value, length) : nullptr;
+  }
+}  // namespace detail
+
+/*! Installs `catalog` as the catalog consulted by domains for messages, or uninstalls
+any catalog if null. The catalog must outlive both its installation and any messages
+returned from it.
+*/
+inline void install_message_catalog(const message_catalog *catalog) noexcept
+{
+  detail::installed_message_catalog_storage().store(catalog, std::memory_order_release);
+}
+//! Returns the installed catalog, if any.
+inline const message_catalog *installed_message_catalog() noexcept
+{
+  return detail::installed_message_catalog_storage().load(std::memory_order_acquire);
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
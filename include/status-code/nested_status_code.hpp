@@ -110,12 +110,24 @@ namespace detail
       const auto &c = static_cast<const _mycode &>(code);  // NOLINT
       return typename StatusCode::domain_type()._generic_code(c.value()->sc);
     }
+    virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code);  // NOLINT
+      return typename StatusCode::domain_type()._do_matches(c.value()->sc, set);
+    }
     virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
     {
       assert(code.domain() == *this);
       const auto &c = static_cast<const _mycode &>(code);  // NOLINT
       return typename StatusCode::domain_type()._do_message(c.value()->sc);
     }
+    virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+    {
+      assert(code.domain() == *this);
+      const auto &c = static_cast<const _mycode &>(code);  // NOLINT
+      return typename StatusCode::domain_type()._do_message_into(c.value()->sc, buffer, length);
+    }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
     SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
     {
@@ -176,7 +188,8 @@ namespace detail
 }  // namespace detail
 
 /*! Make an erased status code which indirects to a dynamically allocated status code,
-using the allocator `alloc`.
+using the allocator `alloc`. If `SYSTEM_ERROR2_REALTIME` is enabled, `alloc` must not
+be a `std::allocator`.
 
 This is useful for shoehorning a rich status code with large value type into a small
 erased status code like `system_code`, with which the status code generated by this
@@ -188,6 +201,10 @@ inline status_code<detail::erased<typename std::add_pointer<typename std::decay<
 {
   using status_code_type = typename std::decay<T>::type;
   using domain_type = detail::indirecting_domain<status_code_type, typename std::decay<Alloc>::type>;
+#if SYSTEM_ERROR2_REALTIME
+  static_assert(!std::is_same<typename std::allocator_traits<typename std::decay<Alloc>::type>::template rebind_alloc<char>, std::allocator<char>>::value,
+                "SYSTEM_ERROR2_REALTIME requires nested status codes to be made with an allocator which does not call malloc()");
+#endif
   using payload_allocator_traits = typename domain_type::payload_allocator_traits;
   typename payload_allocator_traits::template rebind_alloc<typename domain_type::payload_type> payload_alloc(alloc);
   auto *p = payload_allocator_traits::allocate(payload_alloc, 1);
@@ -196,6 +213,12 @@ inline status_code<detail::erased<typename std::add_pointer<typename std::decay<
 #endif
   {
     payload_allocator_traits::construct(payload_alloc, p, static_cast<T &&>(v), static_cast<Alloc &&>(alloc));
+#if SYSTEM_ERROR2_USDT
+    if(!p->sc.empty())
+    {
+      SYSTEM_ERROR2_USDT_PROBE(nested_code_made, p->sc.domain().id(), detail::error_counter_value(p->sc.value()));
+    }
+#endif
     return status_code<domain_type>(in_place, p);
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
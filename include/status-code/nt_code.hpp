@@ -68,29 +68,10 @@ class _nt_code_domain : public status_code_domain
   template <class StatusCode, class Allocator> friend class detail::indirecting_domain;
   friend class _com_code_domain;
   using _base = status_code_domain;
-  static int _nt_code_to_errno(win32::NTSTATUS c)
-  {
-    if(c >= 0)
-    {
-      return 0;  // success
-    }
-    switch(static_cast<unsigned>(c))
-    {
-#include "detail/nt_code_to_generic_code.ipp"
-    }
-    return -1;
-  }
+  static int _nt_code_to_errno(win32::NTSTATUS c) { return static_cast<int>(errc_from_nt_code(static_cast<uint32_t>(c))); }
   static win32::DWORD _nt_code_to_win32_code(win32::NTSTATUS c)  // NOLINT
   {
-    if(c >= 0)
-    {
-      return 0;  // success
-    }
-    switch(static_cast<unsigned>(c))
-    {
-#include "detail/nt_code_to_win32_code.ipp"
-    }
-    return static_cast<win32::DWORD>(-1);
+    return static_cast<win32::DWORD>(win32_code_from_nt_code(static_cast<uint32_t>(c)));
   }
   //! Construct from a NT error code
   static _base::string_ref _make_string_ref(win32::NTSTATUS c) noexcept
@@ -201,11 +182,32 @@ protected:
     const auto &c = static_cast<const nt_code &>(code);  // NOLINT
     return generic_code(static_cast<errc>(_nt_code_to_errno(c.value())));
   }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);
     const auto &c = static_cast<const nt_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    // Fetching messages from the system may allocate and take locks
+    return detail::generic_code_message_ref(static_cast<errc>(_nt_code_to_errno(c.value())));
+#else
     return _make_string_ref(c.value());
+#endif
+  }
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);
+    const auto &c = static_cast<const nt_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    return detail::message_copy(buffer, length, detail::generic_code_message(static_cast<errc>(_nt_code_to_errno(c.value()))));
+#else
+    wchar_t wbuffer[32768];
+    static win32::HMODULE ntdll = win32::GetModuleHandleW(L"NTDLL.DLL");
+    win32::DWORD wlen =
+    win32::FormatMessageW(0x00000800 /*FORMAT_MESSAGE_FROM_HMODULE*/ | 0x00001000 /*FORMAT_MESSAGE_FROM_SYSTEM*/ | 0x00000200 /*FORMAT_MESSAGE_IGNORE_INSERTS*/,
+                          ntdll, c.value(), (1 << 10) /*MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT)*/, wbuffer, 32768, nullptr);
+    return detail::win32_message_into(wbuffer, wlen, buffer, length);
+#endif
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
@@ -223,6 +225,14 @@ inline constexpr const _nt_code_domain &_nt_code_domain::get()
   return nt_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_nt_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 SYSTEM_ERROR2_NAMESPACE_END
 
 #endif
@@ -74,14 +74,13 @@ class _posix_code_domain : public status_code_domain
   template <class StatusCode, class Allocator> friend class detail::indirecting_domain;
   using _base = status_code_domain;
 
-  static _base::string_ref _make_string_ref(int c) noexcept
+  static void _fill_buffer(int c, char (&buffer)[1024]) noexcept
   {
-    char buffer[1024] = "";
 #ifdef _WIN32
     strerror_s(buffer, sizeof(buffer), c);
 #elif defined(__gnu_linux__) && !defined(__ANDROID__)  // handle glibc's weird strerror_r()
     char *s = detail::avoid_string_include::strerror_r(c, buffer, sizeof(buffer));  // NOLINT
-    if(s != nullptr)
+    if(s != nullptr && s != buffer)
     {
       strncpy(buffer, s, sizeof(buffer) - 1);  // NOLINT
       buffer[1023] = 0;
@@ -91,6 +90,15 @@ class _posix_code_domain : public status_code_domain
 #else
     strerror_r(c, buffer, sizeof(buffer));
 #endif
+  }
+  static _base::string_ref _make_string_ref(int c) noexcept
+  {
+#if SYSTEM_ERROR2_REALTIME
+    // strerror_r() may take locks to load localised messages
+    return detail::generic_code_message_ref(static_cast<errc>(c));
+#else
+    char buffer[1024] = "";
+    _fill_buffer(c, buffer);
     size_t length = strlen(buffer);                     // NOLINT
     auto *p = static_cast<char *>(malloc(length + 1));  // NOLINT
     if(p == nullptr)
@@ -99,6 +107,7 @@ class _posix_code_domain : public status_code_domain
     }
     memcpy(p, buffer, length + 1);  // NOLINT
     return _base::atomic_refcounted_string_ref(p, length);
+#endif
   }
 
 public:
@@ -159,12 +168,47 @@ protected:
     const auto &c = static_cast<const posix_code &>(code);  // NOLINT
     return generic_code(static_cast<errc>(c.value()));
   }
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);                         // NOLINT
+    const auto &c = static_cast<const posix_code &>(code);  // NOLINT
+    return set.contains(static_cast<errc>(c.value()));
+  }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);                         // NOLINT
     const auto &c = static_cast<const posix_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_MESSAGE_CATALOGS
+    size_t length = 0;
+    const char *msg = detail::find_catalog_message(this->id(), c.value(), length);
+    if(msg != nullptr)
+    {
+      return string_ref(msg, length);
+    }
+#endif
     return _make_string_ref(c.value());
   }
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);                         // NOLINT
+    const auto &c = static_cast<const posix_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_MESSAGE_CATALOGS
+    size_t cataloglen = 0;
+    const char *catalogmsg = detail::find_catalog_message(this->id(), c.value(), cataloglen);
+    if(catalogmsg != nullptr)
+    {
+      return detail::message_copy(buffer, length, catalogmsg, cataloglen);
+    }
+#endif
+#if SYSTEM_ERROR2_REALTIME
+    return detail::message_copy(buffer, length, detail::generic_code_message(static_cast<errc>(c.value())));
+#else
+    char msg[1024] = "";
+    _fill_buffer(c.value(), msg);
+    return detail::message_copy(buffer, length, msg);
+#endif
+  }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
   {
@@ -181,6 +225,39 @@ inline constexpr const _posix_code_domain &_posix_code_domain::get()
   return posix_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_posix_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
+//! Compares POSIX codes with one another.
+template <> struct equivalence_traits<_posix_code_domain, _posix_code_domain>
+{
+  static constexpr bool equivalent(const posix_code &a, const posix_code &b) noexcept { return a.value() == b.value(); }
+};
+//! Compares POSIX codes with generic codes.
+template <> struct equivalence_traits<_posix_code_domain, _generic_code_domain>
+{
+  static constexpr bool equivalent(const posix_code &a, const generic_code &b) noexcept { return a.value() == static_cast<int>(b.value()); }
+};
+//! Compares POSIX codes with quick status codes, which neither domain knows of so are only equivalent via generic codes.
+template <class Enum> struct equivalence_traits<_posix_code_domain, _quick_status_code_from_enum_domain<Enum>>
+{
+  using _generic = equivalence_traits<_quick_status_code_from_enum_domain<Enum>, _generic_code_domain>;
+  static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const posix_code &a, const quick_status_code_from_enum_code<Enum> &b) noexcept
+  {
+    const errc b_errc = _generic::first_mapping(b.value());
+    if(b_errc != errc::unknown && a.value() == static_cast<int>(b_errc))
+    {
+      return true;
+    }
+    return static_cast<errc>(a.value()) != errc::unknown && _generic::maps_to(b.value(), static_cast<errc>(a.value()));
+  }
+};
+
 namespace mixins
 {
   template <class Base> inline posix_code mixin<Base, _posix_code_domain>::current() noexcept
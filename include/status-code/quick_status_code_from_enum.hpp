@@ -26,6 +26,9 @@ http://www.boost.org/LICENSE_1_0.txt)
 #define SYSTEM_ERROR2_QUICK_STATUS_CODE_FROM_ENUM_HPP
 
 #include "generic_code.hpp"
+#if SYSTEM_ERROR2_MESSAGE_CATALOGS
+#include "message_catalog.hpp"
+#endif
 
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
@@ -64,6 +67,7 @@ template <class Enum> class _quick_status_code_from_enum_domain : public status_
 {
   template <class DomainType> friend class status_code;
   template <class StatusCode, class Allocator> friend class detail::indirecting_domain;
+  template <class DomainType1, class DomainType2> friend struct equivalence_traits;
   using _base = status_code_domain;
   using _src = quick_status_code_from_enum<Enum>;
 
@@ -174,9 +178,36 @@ protected:
     }
     return errc::unknown;
   }
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept override
+  {
+    assert(code.domain() == *this);  // NOLINT
+    const auto *mapping = _find_mapping(static_cast<const quick_status_code_from_enum_code<value_type> &>(code).value());
+    assert(mapping != nullptr);
+    if(mapping != nullptr)
+    {
+      for(errc ec : mapping->code_mappings)
+      {
+        if(set.contains(ec))
+        {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override
   {
     assert(code.domain() == *this);  // NOLINT
+#if SYSTEM_ERROR2_MESSAGE_CATALOGS
+    size_t length = 0;
+    const char *msg =
+    detail::find_catalog_message(this->id(), static_cast<int64_t>(static_cast<const quick_status_code_from_enum_code<value_type> &>(code).value()), length);
+    if(msg != nullptr)
+    {
+      return string_ref(msg, length);
+    }
+#endif
     const auto *mapping = _find_mapping(static_cast<const quick_status_code_from_enum_code<value_type> &>(code).value());
     assert(mapping != nullptr);
     if(mapping != nullptr)
@@ -203,6 +234,65 @@ template <class Enum> inline constexpr const _quick_status_code_from_enum_domain
 }
 #endif
 
+namespace traits
+{
+  template <class Enum> struct is_trivially_erasable<_quick_status_code_from_enum_domain<Enum>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
+//! Compares quick status codes with generic codes using the mapping table directly.
+template <class Enum> struct equivalence_traits<_quick_status_code_from_enum_domain<Enum>, _generic_code_domain>
+{
+  using _domain = _quick_status_code_from_enum_domain<Enum>;
+  //! True if `v` maps onto `ec`, as in the domain's `_do_equivalent()`.
+  static SYSTEM_ERROR2_CONSTEXPR14 bool maps_to(Enum v, errc ec) noexcept
+  {
+    const auto *mapping = _domain::_find_mapping(v);
+    if(mapping != nullptr)
+    {
+      for(errc i : mapping->code_mappings)
+      {
+        if(i == ec)
+        {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+  //! The first `errc` which `v` maps onto, as returned by the domain's `_generic_code()`.
+  static SYSTEM_ERROR2_CONSTEXPR14 errc first_mapping(Enum v) noexcept
+  {
+    const auto *mapping = _domain::_find_mapping(v);
+    return (mapping != nullptr && mapping->code_mappings.size() > 0) ? *mapping->code_mappings.begin() : errc::unknown;
+  }
+  static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const quick_status_code_from_enum_code<Enum> &a, const generic_code &b) noexcept
+  {
+    return maps_to(a.value(), b.value());
+  }
+};
+//! Compares quick status codes of the same enumeration, which are also equivalent if either's first `errc` is mapped by the other.
+template <class Enum> struct equivalence_traits<_quick_status_code_from_enum_domain<Enum>, _quick_status_code_from_enum_domain<Enum>>
+{
+  using _generic = equivalence_traits<_quick_status_code_from_enum_domain<Enum>, _generic_code_domain>;
+  static SYSTEM_ERROR2_CONSTEXPR14 bool equivalent(const quick_status_code_from_enum_code<Enum> &a, const quick_status_code_from_enum_code<Enum> &b) noexcept
+  {
+    if(a.value() == b.value())
+    {
+      return true;
+    }
+    const errc b_errc = _generic::first_mapping(b.value());
+    if(b_errc != errc::unknown && _generic::maps_to(a.value(), b_errc))
+    {
+      return true;
+    }
+    const errc a_errc = _generic::first_mapping(a.value());
+    return a_errc != errc::unknown && _generic::maps_to(b.value(), a_errc);
+  }
+};
+
 namespace mixins
 {
   template <class Base, class Enum>
@@ -27,6 +27,16 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 #include "status_code_domain.hpp"
 
+#if SYSTEM_ERROR2_ERROR_COUNTERS
+#include "error_counters.hpp"
+#endif
+#if SYSTEM_ERROR2_INSTRUMENT
+#include "instrumentation.hpp"
+#endif
+#if SYSTEM_ERROR2_USDT
+#include "usdt.hpp"
+#endif
+
 #if(__cplusplus >= 201700 || _HAS_CXX17) && !defined(SYSTEM_ERROR2_DISABLE_STD_IN_PLACE)
 // 0.26
 #include <utility>  // for in_place
@@ -206,6 +216,61 @@ template <class T> struct is_status_code
   detail::is_status_code<typename std::decay<T>::type>::value || detail::is_erased_status_code<typename std::decay<T>::type>::value;
 };
 
+// Hooks recording domain operations and equivalence stages, which expand to nothing unless instrumenting
+#if SYSTEM_ERROR2_INSTRUMENT
+#define SYSTEM_ERROR2_INSTRUMENT_CALL(domain, op) const detail::instrumented_call _instrumented_call((domain), domain_operation::op)
+#define SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(first, second, stage) detail::instrument_equivalence_stage((first), (second), equivalence_stage::stage)
+#define SYSTEM_ERROR2_DISPATCH_CONSTEXPR20
+#else
+#define SYSTEM_ERROR2_INSTRUMENT_CALL(domain, op)
+#define SYSTEM_ERROR2_INSTRUMENT_EQUIVALENCE_STAGE(first, second, stage)
+#define SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 SYSTEM_ERROR2_CONSTEXPR20
+#endif
+
+namespace detail
+{
+  /* Every call status_code makes into its domain goes through here. If SYSTEM_ERROR2_INSTRUMENT
+  is enabled each call is counted, and optionally timed, otherwise each is a plain forward.
+  */
+  struct instrumented_dispatch
+  {
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 bool do_failure(const status_code_domain &domain, const status_code<void> &code) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, failure);
+      return domain._do_failure(code);
+    }
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 bool do_equivalent(const status_code_domain &domain, const status_code<void> &code1,
+                                                                 const status_code<void> &code2) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, equivalent);
+      return domain._do_equivalent(code1, code2);
+    }
+    // Defined in generic_code.hpp, as generic_code is incomplete here
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 generic_code generic_code_of(const status_code_domain &domain, const status_code<void> &code) noexcept;
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 status_code_domain::string_ref do_message(const status_code_domain &domain, const status_code<void> &code) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, message);
+      return domain._do_message(code);
+    }
+    static size_t do_message_into(const status_code_domain &domain, const status_code<void> &code, char *buffer, size_t length) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, message_into);
+      return domain._do_message_into(code, buffer, length);
+    }
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 bool do_erased_copy(const status_code_domain &domain, status_code<void> &dst, const status_code<void> &src,
+                                                                  status_code_domain::payload_info_t dstinfo) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, erased_copy);
+      return domain._do_erased_copy(dst, src, dstinfo);
+    }
+    static SYSTEM_ERROR2_DISPATCH_CONSTEXPR20 void do_erased_destroy(const status_code_domain &domain, status_code<void> &code, size_t bytes) noexcept
+    {
+      SYSTEM_ERROR2_INSTRUMENT_CALL(domain, erased_destroy);
+      domain._do_erased_destroy(code, bytes);
+    }
+  };
+}  // namespace detail
+
 /*! A type erased lightweight status code reflecting empty, success, or failure.
 Differs from `status_code<erased<>>` by being always available irrespective of
 the domain's value type, but cannot be copied, moved, nor destructed. Thus one
@@ -261,14 +326,45 @@ public:
     // Avoid MSVC's buggy ternary operator for expensive to destruct things
     if(_domain != nullptr)
     {
-      return _domain->_do_message(*this);
+      return detail::instrumented_dispatch::do_message(*_domain, *this);
     }
     return string_ref("(empty)");
   }
+  /*! Write the text representing a code into `buffer` of `length` bytes without allocating
+  memory (for the built-in domains), returning the length of the full message excluding
+  the null terminator. If the return value is not less than `length`, the message was
+  truncated, as with `snprintf()`.
+  */
+  size_t message_into(char *buffer, size_t length) const noexcept
+  {
+    if(_domain != nullptr)
+    {
+      return detail::instrumented_dispatch::do_message_into(*_domain, *this, buffer, length);
+    }
+    return detail::message_copy(buffer, length, "(empty)", 7);
+  }
+  /*! Return a reference to a string textually representing a code, allocated from `resource`
+  which is typically a `std::pmr::memory_resource`. The string is returned to `resource` when
+  the last reference to it is destroyed. The message is composed by `message_into()`, so
+  domains which allocate must override `_do_message_into()` for nothing else to be allocated.
+  */
+  SYSTEM_ERROR2_TEMPLATE(class MemoryResource)
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TEXPR(std::declval<MemoryResource &>().allocate((size_t) 1, (size_t) 1)))
+  string_ref message(MemoryResource &resource) const noexcept
+  {
+    using resource_string_ref = status_code_domain::memory_resource_string_ref<MemoryResource>;
+    char buffer[256];
+    const size_t len = message_into(buffer, sizeof(buffer));
+    if(len < sizeof(buffer))
+    {
+      return resource_string_ref(resource, len, [&buffer, len](char *p, size_t /*unused*/) { memcpy(p, buffer, len + 1); });
+    }
+    return resource_string_ref(resource, len, [this](char *p, size_t n) { message_into(p, n); });
+  }
   //! True if code means success.
-  SYSTEM_ERROR2_CONSTEXPR20 bool success() const noexcept { return (_domain != nullptr) ? !_domain->_do_failure(*this) : false; }
+  SYSTEM_ERROR2_CONSTEXPR20 bool success() const noexcept { return (_domain != nullptr) ? !detail::instrumented_dispatch::do_failure(*_domain, *this) : false; }
   //! True if code means failure.
-  SYSTEM_ERROR2_CONSTEXPR20 bool failure() const noexcept { return (_domain != nullptr) ? _domain->_do_failure(*this) : false; }
+  SYSTEM_ERROR2_CONSTEXPR20 bool failure() const noexcept { return (_domain != nullptr) ? detail::instrumented_dispatch::do_failure(*_domain, *this) : false; }
   /*! True if code is strictly (and potentially non-transitively) semantically equivalent to another code in another domain.
   Note that usually non-semantic i.e. pure value comparison is used when the other status code has the same domain.
   As `equivalent()` will try mapping to generic code, this usually captures when two codes have the same semantic
@@ -278,7 +374,7 @@ public:
   {
     if(_domain && o._domain)
     {
-      return _domain->_do_equivalent(*this, o);
+      return detail::instrumented_dispatch::do_equivalent(*_domain, *this, o);
     }
     // If we are both empty, we are equivalent
     if(!_domain && !o._domain)
@@ -293,10 +389,20 @@ public:
   for the equivalent generic code and those are compared.
   */
   template <class T> SYSTEM_ERROR2_CONSTEXPR14 inline bool equivalent(const status_code<T> &o) const noexcept;
+  /*! True if code is equivalent to any of the `errc` values in `set`, as if each had been compared
+  using `equivalent()`, but with a single call into the domain.
+  */
+  inline bool matches(const errc_set &set) const noexcept;
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   //! Throw a code as a C++ exception.
   SYSTEM_ERROR2_NORETURN void throw_exception() const
   {
+#if SYSTEM_ERROR2_ERROR_COUNTERS
+    detail::count_error_event(*_domain, detail::erased_error_counter_value(*this), error_event::thrown);
+#endif
+#if SYSTEM_ERROR2_USDT
+    SYSTEM_ERROR2_USDT_PROBE(error_thrown, _domain->id(), detail::erased_error_counter_value(*this));
+#endif
     _domain->_do_throw_exception(*this);
     abort();  // suppress buggy GCC warning
   }
@@ -305,6 +411,29 @@ public:
 
 namespace detail
 {
+  /* Accumulates text into a caller supplied buffer in the manner of `_do_message_into()`,
+  counting the full length even once the buffer has been filled.
+  */
+  struct message_writer
+  {
+    char *buffer;
+    size_t length;
+    size_t written;
+
+    void append(const char *str, size_t len) noexcept
+    {
+      if(written < length)
+      {
+        message_copy(buffer + written, length - written, str, len);
+      }
+      written += len;
+    }
+    void append(const status_code<void> &code) noexcept
+    {
+      written += (written < length) ? code.message_into(buffer + written, length - written) : code.message_into(nullptr, 0);
+    }
+  };
+
   template <class DomainType> struct get_domain_value_type
   {
     using domain_type = DomainType;
@@ -413,6 +542,15 @@ namespace detail
 
 namespace traits
 {
+  /*! Specialise to true for a domain whose `_is_trivially_erasable()` returns true, which is to say
+  that its erased codes are copied by copying their bits and need nothing doing to destroy them.
+  Only codes of such domains can be held by a `trivial_erased_status_code`.
+  */
+  template <class DomainType> struct is_trivially_erasable
+  {
+    static constexpr bool value = false;
+  };
+
   //! Determines whether the mixin contained in `StatusCode` contains non-static member variables.
   template <class StatusCode> using has_stateful_mixin = detail::has_stateful_mixin<typename detail::remove_cvref<StatusCode>::type::value_type>;
 
@@ -422,6 +560,20 @@ namespace traits
   detail::domain_value_type_erasure_is_safe<typename detail::remove_cvref<To>::type::domain_type, typename detail::remove_cvref<From>::type::domain_type>;
 }  // namespace traits
 
+namespace detail
+{
+  template <class ErasedType, class DomainType> struct domain_value_type_trivial_erasure_is_safe
+  {
+    static constexpr bool value = traits::is_trivially_erasable<DomainType>::value                                                  //
+                                  && std::is_trivially_copyable<typename get_domain_value_type<DomainType>::value_type>::value  //
+                                  && domain_value_type_erasure_is_safe<erased<ErasedType>, DomainType>::value;
+  };
+  template <class ErasedType> struct domain_value_type_trivial_erasure_is_safe<ErasedType, void>
+  {
+    static constexpr bool value = false;
+  };
+}  // namespace detail
+
 /*! A lightweight, typed, status code reflecting empty, success, or failure.
 This is the main workhorse of the system_error2 library. Its characteristics reflect the value type
 set by its domain type, so if that value type is move-only or trivial, so is this.
@@ -468,6 +620,7 @@ public:
   SYSTEM_ERROR2_CONSTEXPR14 status_code clone() const { return *this; }
 
   /***** KEEP THESE IN SYNC WITH ERRORED_STATUS_CODE *****/
+  using status_code<void>::message;
   //! Implicit construction from any type where an ADL discovered `make_status_code(T, Args ...)` returns a `status_code`.
   SYSTEM_ERROR2_TEMPLATE(
   class T, class... Args,  //
@@ -532,7 +685,7 @@ public:
     // Avoid MSVC's buggy ternary operator for expensive to destruct things
     if(this->_domain != nullptr)
     {
-      return string_ref(this->domain()._do_message(*this));
+      return string_ref(detail::instrumented_dispatch::do_message(this->domain(), *this));
     }
     return string_ref("(empty)");
   }
@@ -586,7 +739,7 @@ public:
   {
     if(nullptr != this->_domain)
     {
-      this->_domain->_do_erased_destroy(*this, sizeof(*this));
+      detail::instrumented_dispatch::do_erased_destroy(*this->_domain, *this, sizeof(*this));
     }
   }
 
@@ -598,7 +751,7 @@ public:
       return {};
     }
     status_code x;
-    if(!this->_domain->_do_erased_copy(x, *this, this->_domain->payload_info()))
+    if(!detail::instrumented_dispatch::do_erased_copy(*this->_domain, x, *this, this->_domain->payload_info()))
     {
       abort();  // should not be possible
     }
@@ -645,6 +798,11 @@ public:
       : status_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
   {
   }
+  //! Implicit construction from a trivial erased status code of the same erased type, which is always lossless.
+  constexpr status_code(const trivial_erased_status_code<ErasedType> &v) noexcept  // NOLINT
+      : _base(typename _base::_value_type_constructor{}, v._domain_ptr(), v.value())
+  {
+  }
 
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   //! Explicit copy construction from an unknown status code. Note that this will throw an exception if its value type is not trivially copyable or would not
@@ -653,7 +811,7 @@ public:
       : _base(typename _base::_value_type_constructor{}, v._domain_ptr(), value_type{})
   {
     status_code_domain::payload_info_t info{sizeof(value_type), sizeof(status_code), alignof(status_code)};
-    if(this->_domain->_do_erased_copy(*this, v, info))
+    if(detail::instrumented_dispatch::do_erased_copy(*this->_domain, *this, v, info))
     {
       return;
     }
@@ -674,7 +832,7 @@ public:
 #endif
     {
       status_code_domain::payload_info_t info{sizeof(value_type), sizeof(status_code), alignof(status_code)};
-      if(this->_domain->_do_erased_copy(*this, v, info))
+      if(detail::instrumented_dispatch::do_erased_copy(*this->_domain, *this, v, info))
       {
         return;
       }
@@ -708,6 +866,96 @@ namespace traits
   };
 }  // namespace traits
 
+/*! A type erased status code like `erased_status_code<ErasedType>`, but which can only hold codes of
+domains which are trivially erasable (see `traits::is_trivially_erasable`), which is checked at compile
+time. In exchange it is trivially copyable and trivially destructible, so unlike `erased_status_code`
+it is passed and returned in registers by every compiler, not just those supporting `[[clang::trivial_abi]]`.
+
+It converts implicitly and losslessly into the `erased_status_code` of the same erased type. The
+reverse conversion is explicit, and yields an empty code if the code's domain is not trivially erasable.
+*/
+template <class ErasedType> class SYSTEM_ERROR2_TRIVIAL_ABI trivial_erased_status_code : public status_code<void>
+{
+  template <class T> friend class status_code;
+  using _base = status_code<void>;
+
+protected:
+  ErasedType _value{};
+
+public:
+  //! The type of the domain (void, as it is erased).
+  using domain_type = void;
+  //! The type of the erased status code.
+  using value_type = ErasedType;
+  //! The type of a reference to a message string.
+  using string_ref = typename _base::string_ref;
+
+  //! Default construction to empty
+  trivial_erased_status_code() = default;
+  //! Copy constructor
+  trivial_erased_status_code(const trivial_erased_status_code &) = default;
+  //! Move constructor
+  trivial_erased_status_code(trivial_erased_status_code &&) = default;  // NOLINT
+  //! Copy assignment
+  trivial_erased_status_code &operator=(const trivial_erased_status_code &) = default;
+  //! Move assignment
+  trivial_erased_status_code &operator=(trivial_erased_status_code &&) = default;  // NOLINT
+  ~trivial_erased_status_code() = default;
+
+  //! Implicit construction from any status code of a trivially erasable domain whose value type would fit into our storage.
+  SYSTEM_ERROR2_TEMPLATE(class DomainType)  //
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(detail::domain_value_type_trivial_erasure_is_safe<ErasedType, DomainType>::value))
+  constexpr trivial_erased_status_code(const status_code<DomainType> &v) noexcept  // NOLINT
+      : _base(v.empty() ? nullptr : &v.domain())
+      , _value(detail::erasure_cast<value_type>(v.value()))
+  {
+  }
+  //! Implicit construction from any type where an ADL discovered `make_status_code(T, Args ...)` returns a `status_code`.
+  SYSTEM_ERROR2_TEMPLATE(
+  class T, class... Args,  //
+  class MakeStatusCodeResult =
+  typename detail::safe_get_make_status_code_result<T, Args...>::type)  // Safe ADL lookup of make_status_code(), returns void if not found
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(!std::is_same<typename std::decay<T>::type, trivial_erased_status_code>::value       // not copy/move of self
+                                              && !std::is_same<typename std::decay<T>::type, value_type>::value                    // not copy/move of value type
+                                              && is_status_code<MakeStatusCodeResult>::value                                       // ADL makes a status code
+                                              && std::is_constructible<trivial_erased_status_code, MakeStatusCodeResult>::value))  // ADLed status code is compatible
+  constexpr trivial_erased_status_code(T &&v, Args &&...args) noexcept(noexcept(make_status_code(std::declval<T>(), std::declval<Args>()...)))  // NOLINT
+      : trivial_erased_status_code(make_status_code(static_cast<T &&>(v), static_cast<Args &&>(args)...))
+  {
+  }
+  //! Implicit construction from any `quick_status_code_from_enum<Enum>` enumerated type.
+  SYSTEM_ERROR2_TEMPLATE(class Enum,                                                                                               //
+                         class QuickStatusCodeType = typename quick_status_code_from_enum<Enum>::code_type)                        // Enumeration has been activated
+  SYSTEM_ERROR2_TREQUIRES(SYSTEM_ERROR2_TPRED(std::is_constructible<trivial_erased_status_code, QuickStatusCodeType>::value))      // Its status code is compatible
+  constexpr trivial_erased_status_code(Enum &&v) noexcept(std::is_nothrow_constructible<trivial_erased_status_code, QuickStatusCodeType>::value)  // NOLINT
+      : trivial_erased_status_code(QuickStatusCodeType(static_cast<Enum &&>(v)))
+  {
+  }
+  //! Explicit construction from an erased status code of the same erased type. This will be empty if its domain is not trivially erasable.
+  explicit trivial_erased_status_code(const status_code<detail::erased<ErasedType>> &v) noexcept
+      : _base((v.empty() || !v.domain()._is_trivially_erasable()) ? nullptr : &v.domain())
+      , _value((this->_domain != nullptr) ? v.value() : value_type{})
+  {
+  }
+
+  //! Reset the code to empty.
+  SYSTEM_ERROR2_CONSTEXPR14 void clear() noexcept
+  {
+    this->_domain = nullptr;
+    _value = value_type{};
+  }
+  //! Return the erased `value_type` by value.
+  constexpr value_type value() const noexcept { return _value; }
+};
+
+namespace traits
+{
+  template <class ErasedType> struct is_move_bitcopying<trivial_erased_status_code<ErasedType>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 SYSTEM_ERROR2_NAMESPACE_END
 
 #endif
@@ -0,0 +1,311 @@
+/* A columnar container of SG14 status codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_STATUS_CODE_COLUMNS_HPP
+#define SYSTEM_ERROR2_STATUS_CODE_COLUMNS_HPP
+
+#include "compact_code.hpp"
+
+#include <vector>
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  inline unsigned popcount64(uint64_t v) noexcept
+  {
+#if defined(__POPCNT__) && (defined(__GNUC__) || defined(__clang__))
+    return static_cast<unsigned>(__builtin_popcountll(v));
+#else
+    // Without the instruction the builtin is a library call, which this beats
+    v = v - ((v >> 1U) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2U) & 0x3333333333333333ULL);
+    v = (v + (v >> 4U)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<unsigned>((v * 0x0101010101010101ULL) >> 56U);
+#endif
+  }
+  // v must not be zero
+  inline unsigned countr_zero64(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#else
+    unsigned ret = 0;
+    for(; (v & 1U) == 0; v >>= 1U)
+    {
+      ret++;
+    }
+    return ret;
+#endif
+  }
+
+  // The closest errc of each distinct domain index and value seen, for domains whose values are not errc.
+  // Keyed per value rather than per domain, as `_generic_code()` maps only one value per call.
+  class closest_errc_memo
+  {
+    std::vector<uint64_t> _keys;  // index << 32 | value, zero if unused as index zero is empty
+    std::vector<errc> _errcs;
+    size_t _used{0};
+
+    static size_t _hash(uint64_t key) noexcept { return static_cast<size_t>((key * 0x9e3779b97f4a7c15ULL) >> 32U); }
+    size_t _find(uint64_t key) const noexcept
+    {
+      const size_t mask = _keys.size() - 1;
+      size_t n = _hash(key) & mask;
+      while(_keys[n] != key && _keys[n] != 0)
+      {
+        n = (n + 1) & mask;
+      }
+      return n;
+    }
+    void _grow()
+    {
+      std::vector<uint64_t> keys(_keys.empty() ? 16 : _keys.size() * 2);
+      std::vector<errc> errcs(keys.size());
+      keys.swap(_keys);
+      errcs.swap(_errcs);
+      for(size_t n = 0; n < keys.size(); n++)
+      {
+        if(keys[n] != 0)
+        {
+          const size_t idx = _find(keys[n]);
+          _keys[idx] = keys[n];
+          _errcs[idx] = errcs[n];
+        }
+      }
+    }
+
+  public:
+    errc get(uint16_t index, uint32_t value, errc (*generic_errc)(uint32_t))
+    {
+      if((_used + 1) * 2 > _keys.size())
+      {
+        _grow();
+      }
+      const uint64_t key = (static_cast<uint64_t>(index) << 32U) | value;
+      const size_t n = _find(key);
+      if(_keys[n] == 0)
+      {
+        _keys[n] = key;
+        _errcs[n] = generic_errc(value);
+        _used++;
+      }
+      return _errcs[n];
+    }
+  };
+}  // namespace detail
+
+/*! A container of many status codes, such as the outcomes of a batch of a million syscalls,
+stored as columns rather than as a `std::vector<system_code>`.
+
+Each code is stored as the domain index and value of its `compact_code`, each in its own
+column, plus one bit saying whether it is a failure. Codes are added as `compact_code`s, so only
+codes which a `compact_code` can hold can be added, and whether each is a failure is decided then.
+
+The bulk operations work on whole columns rather than on codes:
+
+- `count_failures()` and `first_failure()` examine the failure bits sixty four at a time, and
+never call into a domain.
+- `group_by_domain()` counts the domain index column, and never calls into a domain.
+- `histogram_by_errc()` reads generic and POSIX values as the `errc` they are. For any other
+domain it calls into the domain once for each distinct value of that domain, not once per code.
+It cannot call only once per domain, as a domain offers no way to map all its values at once,
+and its values need not be few or dense enough to tabulate.
+*/
+class status_code_columns
+{
+public:
+  //! The type of a domain index.
+  using index_type = compact_code_domain_registry::index_type;
+  //! The type of a raw value.
+  using value_type = compact_code::value_type;
+  //! The type of an index into the container.
+  using size_type = size_t;
+
+  //! The number of codes, and how many of them are failures, of one domain.
+  struct domain_group
+  {
+    //! The domain.
+    const status_code_domain *domain;
+    //! The domain's index in `compact_code_domain_registry`.
+    index_type index;
+    //! The number of codes of the domain.
+    size_t count;
+    //! The number of those codes which are failures.
+    size_t failures;
+  };
+
+  //! The number of codes whose closest `errc` is each `errc`.
+  class errc_histogram
+  {
+    friend class status_code_columns;
+    static constexpr size_t _buckets = static_cast<size_t>(detail::generic_code_max_value()) + 2;  // the last is errc::unknown
+    size_t _counts[_buckets];
+
+    static constexpr size_t _bucket(uint32_t v) noexcept { return (v < _buckets - 1) ? v : _buckets - 1; }
+
+  public:
+    //! Constructs a histogram of no codes.
+    errc_histogram() noexcept
+        : _counts{}
+    {
+    }
+    //! Returns the number of codes whose closest `errc` is `e`.
+    size_t operator[](errc e) const noexcept { return _counts[_bucket(detail::erasure_cast<uint32_t>(e))]; }
+  };
+
+private:
+  std::vector<index_type> _indices;
+  std::vector<value_type> _values;
+  std::vector<uint64_t> _failures;  // one bit per code
+
+public:
+  //! Default construction to empty
+  status_code_columns() = default;
+
+  //! Returns the number of codes.
+  size_type size() const noexcept { return _indices.size(); }
+  //! True if there are no codes.
+  bool empty() const noexcept { return _indices.empty(); }
+  //! Reserves storage for `n` codes.
+  void reserve(size_type n)
+  {
+    _indices.reserve(n);
+    _values.reserve(n);
+    _failures.reserve((n + 63) / 64);
+  }
+  //! Removes all codes.
+  void clear() noexcept
+  {
+    _indices.clear();
+    _values.clear();
+    _failures.clear();
+  }
+
+  //! Appends a code.
+  void push_back(const compact_code &c)
+  {
+    const size_type n = size();
+    if(n % 64 == 0)
+    {
+      _failures.push_back(0);
+    }
+    _indices.push_back(c._index);
+    _values.push_back(c._value);
+    _failures.back() |= static_cast<uint64_t>(c.failure()) << (n % 64);
+  }
+  //! Appends an erased code such as `system_code`, which is added empty if a `compact_code` would be.
+  template <class ErasedType> void push_back(const status_code<detail::erased<ErasedType>> &c) { push_back(compact_code(c)); }
+
+  //! Returns the code at `n`.
+  compact_code operator[](size_type n) const noexcept
+  {
+    compact_code ret;
+    ret._set(_indices[n], _values[n], ((_failures[n / 64] >> (n % 64)) & 1U) != 0);
+    return ret;
+  }
+  //! Returns the domain index column.
+  const std::vector<index_type> &indices() const noexcept { return _indices; }
+  //! Returns the value column.
+  const std::vector<value_type> &values() const noexcept { return _values; }
+
+  //! Returns the number of codes which are failures.
+  size_type count_failures() const noexcept
+  {
+    size_type ret = 0;
+    for(const uint64_t word : _failures)
+    {
+      ret += detail::popcount64(word);
+    }
+    return ret;
+  }
+  //! Returns the index of the first code which is a failure, or `size()` if none are.
+  size_type first_failure() const noexcept
+  {
+    for(size_type n = 0; n < _failures.size(); n++)
+    {
+      if(_failures[n] != 0)
+      {
+        return n * 64 + detail::countr_zero64(_failures[n]);
+      }
+    }
+    return size();
+  }
+  //! Returns the number of codes, and of failures, of each domain in order of domain index. Empty codes are not counted.
+  std::vector<domain_group> group_by_domain() const
+  {
+    const compact_code_domain_registry &registry = compact_code_domain_registry::get();
+    const size_type width = registry.size() + 1;
+    // Runs of one domain would make each count wait on the last, so four sets of counts are interleaved
+    std::vector<size_type> counts(4 * width), failures(width);
+    for(size_type n = 0; n < size(); n++)
+    {
+      counts[(n % 4) * width + _indices[n]]++;
+    }
+    for(size_type word = 0; word < _failures.size(); word++)
+    {
+      for(uint64_t bits = _failures[word]; bits != 0; bits &= bits - 1)
+      {
+        failures[_indices[word * 64 + detail::countr_zero64(bits)]]++;
+      }
+    }
+    std::vector<domain_group> ret;
+    for(size_type idx = 1; idx < width; idx++)
+    {
+      const size_type count = counts[idx] + counts[width + idx] + counts[2 * width + idx] + counts[3 * width + idx];
+      if(count != 0)
+      {
+        ret.push_back({registry._rows[idx].domain, static_cast<index_type>(idx), count, failures[idx]});
+      }
+    }
+    return ret;
+  }
+  //! Returns the number of codes whose closest `errc` is each `errc`. Empty codes are not counted.
+  errc_histogram histogram_by_errc() const
+  {
+    const compact_code_domain_registry &registry = compact_code_domain_registry::get();
+    std::vector<uint8_t> value_is_errc(registry.size() + 1);
+    for(size_type idx = 1; idx < value_is_errc.size(); idx++)
+    {
+      value_is_errc[idx] = registry._rows[idx].value_is_errc ? 1 : 0;
+    }
+    errc_histogram ret;
+    detail::closest_errc_memo memo;
+    for(size_type n = 0; n < size(); n++)
+    {
+      const index_type idx = _indices[n];
+      if(idx == 0)
+      {
+        continue;
+      }
+      const value_type v = _values[n];
+      ret._counts[errc_histogram::_bucket(value_is_errc[idx] ? v : detail::erasure_cast<uint32_t>(memo.get(idx, v, registry._rows[idx].generic_errc)))]++;
+    }
+    return ret;
+  }
+};
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -37,17 +37,25 @@ SYSTEM_ERROR2_NAMESPACE_BEGIN
 Be careful of placing these into containers! Equality and inequality operators are
 *semantic* not exact. Therefore two distinct items will test true! To help prevent
 surprise on this, `operator<` and `std::hash<>` are NOT implemented in order to
-trap potential incorrectness. Define your own custom comparison functions for your
-container which perform exact comparisons.
+trap potential incorrectness. Use `exact_hash` and `exact_equal` from "exact_hash.hpp",
+or `status_code_flat_map`, for containers which perform exact comparisons.
 */
 template <class DomainType> class status_code;
+template <class ErasedType> class trivial_erased_status_code;
 class _generic_code_domain;
 //! The generic code is a status code with the generic code domain, which is that of `errc` (POSIX).
 using generic_code = status_code<_generic_code_domain>;
+class errc_set;
+struct generic_key;
 
 namespace detail
 {
   template <class StatusCode, class Allocator> class indirecting_domain;
+  template <class StatusCode> class backtraced_domain;
+  template <class StatusCode> class context_domain;
+  class chain_domain;
+  struct instrumented_dispatch;
+  template <class DomainType> struct compact_code_domain_functions;
   /* We are severely limited by needing to retain C++ 11 compatibility when doing
   constexpr string parsing. MSVC lets you throw exceptions within a constexpr
   evaluation context when exceptions are globally disabled, but won't let you
@@ -97,6 +105,21 @@ namespace detail
 #endif
   static constexpr unsigned long long test_uuid_parse = parse_uuid_from_array("430f1201-94fc-06c7-430f-120194fc06c7");
   // static constexpr unsigned long long test_uuid_parse2 = parse_uuid_from_array("x30f1201-94fc-06c7-430f-120194fc06c7");
+
+  /* Copies as much of `str` as fits into `buffer` of `length` bytes, always null
+  terminating if `length` is not zero, and returns `len` in the manner of `snprintf()`.
+  */
+  inline size_t message_copy(char *buffer, size_t length, const char *str, size_t len) noexcept
+  {
+    if(length > 0)
+    {
+      const size_t tocopy = (len < length) ? len : (length - 1);
+      memcpy(buffer, str, tocopy);
+      buffer[tocopy] = 0;
+    }
+    return len;
+  }
+  inline size_t message_copy(char *buffer, size_t length, const char *str) noexcept { return message_copy(buffer, length, str, strlen(str)); }
 }  // namespace detail
 
 /*! Abstract base class for a coding domain of a status code.
@@ -105,6 +128,13 @@ class status_code_domain
 {
   template <class DomainType> friend class status_code;
   template <class StatusCode, class Allocator> friend class indirecting_domain;
+  template <class StatusCode> friend class detail::backtraced_domain;
+  template <class StatusCode> friend class detail::context_domain;
+  friend class detail::chain_domain;
+  friend struct detail::instrumented_dispatch;
+  template <class ErasedType> friend class trivial_erased_status_code;
+  template <class DomainType> friend struct detail::compact_code_domain_functions;
+  friend struct generic_key;
 
 public:
   //! Type of the unique id for this domain.
@@ -346,6 +376,194 @@ public:
     }
   };
 
+  /*! A reference counted reference to a message string, which is NOT threadsafe. All
+  copies must remain on the thread which made the original, which avoids the cost of
+  atomic reference counting on every copy. Call `share()` to obtain an
+  `atomic_refcounted_string_ref` before a message crosses threads.
+  */
+  class local_refcounted_string_ref : public string_ref
+  {
+    struct _allocated_msg
+    {
+      unsigned count{1};
+    };
+    _allocated_msg *&_msg() noexcept { return reinterpret_cast<_allocated_msg *&>(this->_state[0]); }                  // NOLINT
+    const _allocated_msg *_msg() const noexcept { return reinterpret_cast<const _allocated_msg *>(this->_state[0]); }  // NOLINT
+
+    static SYSTEM_ERROR2_CONSTEXPR20 void _local_refcounted_string_thunk(string_ref *_dest, const string_ref *_src, _thunk_op op) noexcept
+    {
+      auto dest = static_cast<local_refcounted_string_ref *>(_dest);      // NOLINT
+      auto src = static_cast<const local_refcounted_string_ref *>(_src);  // NOLINT
+      (void) src;
+      assert(dest->_thunk == _local_refcounted_string_thunk);                   // NOLINT
+      assert(src == nullptr || src->_thunk == _local_refcounted_string_thunk);  // NOLINT
+      switch(op)
+      {
+      case _thunk_op::copy:
+      {
+        if(dest->_msg() != nullptr)
+        {
+          assert(dest->_msg()->count != 0);  // NOLINT
+          ++dest->_msg()->count;
+        }
+        return;
+      }
+      case _thunk_op::move:
+      {
+        assert(src);                                                 // NOLINT
+        auto msrc = const_cast<local_refcounted_string_ref *>(src);  // NOLINT
+        msrc->_begin = msrc->_end = nullptr;
+        msrc->_state[0] = msrc->_state[1] = msrc->_state[2] = nullptr;
+        return;
+      }
+      case _thunk_op::destruct:
+      {
+        if(dest->_msg() != nullptr && --dest->_msg()->count == 0)
+        {
+          free((void *) dest->_begin);  // NOLINT
+          delete dest->_msg();          // NOLINT
+        }
+      }
+      }
+    }
+
+  public:
+    //! Construct from a C string literal allocated using `malloc()`.
+    explicit local_refcounted_string_ref(const char *str, size_type len = static_cast<size_type>(-1), void *state1 = nullptr, void *state2 = nullptr) noexcept
+        : string_ref(str, len, new(std::nothrow) _allocated_msg, state1, state2, _local_refcounted_string_thunk)
+    {
+      if(_msg() == nullptr)
+      {
+        free((void *) this->_begin);  // NOLINT
+        _msg() = nullptr;             // disabled
+        this->_begin = "failed to get message from system";
+        this->_end = strchr(this->_begin, 0);
+        return;
+      }
+    }
+
+    //! Returns a threadsafe reference to a copy of this message, which may be passed to other threads.
+    atomic_refcounted_string_ref share() const & noexcept
+    {
+      const size_type length = this->size();
+      auto *p = static_cast<char *>(malloc(length + 1));  // NOLINT
+      if(p == nullptr)
+      {
+        return atomic_refcounted_string_ref(nullptr, 0);
+      }
+      memcpy(p, this->_begin, length);
+      p[length] = 0;
+      return atomic_refcounted_string_ref(p, length);
+    }
+    //! Returns a threadsafe reference to this message, without copying it if this is the only reference.
+    atomic_refcounted_string_ref share() && noexcept
+    {
+      if(_msg() == nullptr || _msg()->count != 1)
+      {
+        return static_cast<const local_refcounted_string_ref &>(*this).share();
+      }
+      const char *p = this->_begin;
+      const size_type length = this->size();
+      delete _msg();  // NOLINT
+      this->_begin = this->_end = nullptr;
+      _msg() = nullptr;
+      return atomic_refcounted_string_ref(p, length);
+    }
+  };
+
+  /*! A reference counted, threadsafe reference to a message string allocated from a
+  `std::pmr::memory_resource`, or any other type with the same `allocate()` and `deallocate()`,
+  to which it is returned when the last reference is destroyed. The memory resource must
+  outlive all references.
+  */
+  template <class MemoryResource> class memory_resource_string_ref : public string_ref
+  {
+    struct _allocated_msg
+    {
+      mutable std::atomic<unsigned> count;
+      MemoryResource *resource;
+      size_t bytes;
+    };
+    _allocated_msg *&_msg() noexcept { return reinterpret_cast<_allocated_msg *&>(this->_state[0]); }  // NOLINT
+
+    static void _memory_resource_string_thunk(string_ref *_dest, const string_ref *_src, _thunk_op op) noexcept
+    {
+      auto dest = static_cast<memory_resource_string_ref *>(_dest);      // NOLINT
+      auto src = static_cast<const memory_resource_string_ref *>(_src);  // NOLINT
+      (void) src;
+      assert(dest->_thunk == _memory_resource_string_thunk);                   // NOLINT
+      assert(src == nullptr || src->_thunk == _memory_resource_string_thunk);  // NOLINT
+      switch(op)
+      {
+      case _thunk_op::copy:
+      {
+        if(dest->_msg() != nullptr)
+        {
+          auto count = dest->_msg()->count.fetch_add(1, std::memory_order_relaxed);
+          (void) count;
+          assert(count != 0);  // NOLINT
+        }
+        return;
+      }
+      case _thunk_op::move:
+      {
+        assert(src);                                                // NOLINT
+        auto msrc = const_cast<memory_resource_string_ref *>(src);  // NOLINT
+        msrc->_begin = msrc->_end = nullptr;
+        msrc->_state[0] = msrc->_state[1] = msrc->_state[2] = nullptr;
+        return;
+      }
+      case _thunk_op::destruct:
+      {
+        _allocated_msg *msg = dest->_msg();
+        if(msg != nullptr && 1 == msg->count.fetch_sub(1, std::memory_order_release))
+        {
+          std::atomic_thread_fence(std::memory_order_acquire);
+          MemoryResource *resource = msg->resource;
+          const size_t bytes = msg->bytes;
+          msg->~_allocated_msg();
+          resource->deallocate(msg, bytes, alignof(_allocated_msg));
+        }
+      }
+      }
+    }
+
+  public:
+    /*! Allocate `len + 1` characters from `resource`, and call `write(char *buffer, size_t length)`
+    to fill them with a null terminated message of `len` characters.
+    */
+    template <class Writer>
+    memory_resource_string_ref(MemoryResource &resource, size_type len, Writer &&write) noexcept
+        : string_ref(_memory_resource_string_thunk)
+    {
+      const size_t bytes = sizeof(_allocated_msg) + len + 1;
+      void *p = nullptr;
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+      try
+#endif
+      {
+        p = resource.allocate(bytes, alignof(_allocated_msg));
+      }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+      catch(...)
+      {
+      }
+#endif
+      if(p == nullptr)
+      {
+        this->_begin = "failed to allocate message";
+        this->_end = strchr(this->_begin, 0);
+        return;
+      }
+      auto *msg = new(p) _allocated_msg{{1}, &resource, bytes};
+      auto *text = reinterpret_cast<char *>(msg + 1);  // NOLINT
+      write(text, len + 1);
+      _msg() = msg;
+      this->_begin = text;
+      this->_end = text + strlen(text);
+    }
+  };
+
 private:
   unique_id_type _id;
 
@@ -451,6 +669,29 @@ protected:
     (void) code;
     (void) bytes;
   }
+  /*! True if erased codes of this domain are copied by copying their bits, and need nothing doing to destroy them,
+  so may be held by a `trivial_erased_status_code`. Default implementation returns false. Domains returning true
+  must override neither `_do_erased_copy()` nor `_do_erased_destroy()`, and should also specialise
+  `traits::is_trivially_erasable` to say so at compile time.
+  */
+  virtual bool _is_trivially_erasable() const noexcept { return false; }
+  /*! Write the text representing a code into `buffer` of `length` bytes, returning the length of the full
+  message excluding the null terminator in the manner of `snprintf()`. If the return value is not less than
+  `length`, the message did not fit and `buffer` holds a null terminated, possibly empty, prefix of it.
+  Default implementation copies the string returned by `_do_message()`. Domains whose `_do_message()`
+  allocates should override this with an implementation which does not.
+  */
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept  // NOLINT
+  {
+    const string_ref msg(_do_message(code));
+    return detail::message_copy(buffer, length, msg.data(), msg.size());
+  }
+  /*! True if code is equivalent to any of the `errc` values in `set`, exactly as if each had been
+  compared using `equivalent()`. Default implementation tests the result of `_generic_code()`, then
+  asks `_do_equivalent()` about each remaining value. Domains which know which `errc` values their
+  codes are equivalent to should override this with a direct test of the set.
+  */
+  virtual bool _do_matches(const status_code<void> &code, const errc_set &set) const noexcept;  // defined in generic_code.hpp
 };
 
 SYSTEM_ERROR2_NAMESPACE_END
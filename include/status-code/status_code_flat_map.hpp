@@ -0,0 +1,331 @@
+/* An open addressing hash map keyed by SG14 status codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_STATUS_CODE_FLAT_MAP_HPP
+#define SYSTEM_ERROR2_STATUS_CODE_FLAT_MAP_HPP
+
+#include "system_code.hpp"
+
+#include <iterator>  // for forward_iterator_tag
+#include <utility>   // for pair
+#include <vector>
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+//! Key policy of `status_code_flat_map` which keeps keys as they are, so a key is found only by an exactly equal code.
+struct exact_key
+{
+  //! Returns `code` unchanged.
+  trivial_system_code operator()(const trivial_system_code &code) const noexcept { return code; }
+};
+
+/*! Key policy of `status_code_flat_map` which replaces each key by the generic code it is closest
+to, so a key is found by any code with the same closest `errc`. For example, `posix_code(ENOENT)`
+and `http_status_code(404)` then find the same entry. Keys with no closest `errc` are kept as they
+are. This costs a call into the domain of each key not already a generic code.
+*/
+struct generic_key
+{
+  //! Returns the generic code closest to `code`, or `code` if there is none.
+  trivial_system_code operator()(const trivial_system_code &code) const noexcept
+  {
+    if(code.empty() || code.domain() == generic_code_domain)
+    {
+      return code;
+    }
+    const errc closest = detail::instrumented_dispatch::generic_code_of(code.domain(), code).value();
+    return (closest != errc::unknown) ? trivial_system_code(generic_code(closest)) : code;
+  }
+};
+
+/*! A hash map from status codes to `Mapped`, for error metrics and caches.
+
+Keys are `trivial_system_code`s, which are two words, and are compared exactly: both the domain's
+unique id and the erased value must match. Every key is first passed through `KeyPolicy`, so
+semantic lookup can be opted into with `generic_key`. Keys are hashed from the domain's unique id
+and the erased value without calling into the domain, and are stored inline with their mapped
+values in a single array probed linearly, which is kept at most three quarters full.
+
+This is not the exactness of `exact_hash` and `exact_equal`, which compare as many payload bytes
+as the domain's `payload_info()` says, at the cost of a virtual call per hash and per comparison.
+Every key here is already erased into one word, so the whole erased value is compared instead,
+with no call into the domain. Codes which `exact_equal` finds equal erase to equal values, so
+they find the same entry.
+
+`Mapped` must be default constructible and move assignable. Unlike `std::unordered_map`, inserting
+or erasing may move other entries, invalidating pointers and iterators to them.
+*/
+template <class Mapped, class KeyPolicy = exact_key> class status_code_flat_map
+{
+public:
+  //! The type of a key.
+  using key_type = trivial_system_code;
+  //! The type of a mapped value.
+  using mapped_type = Mapped;
+  //! The type of an entry.
+  using value_type = std::pair<key_type, mapped_type>;
+  //! The type of a count.
+  using size_type = size_t;
+
+private:
+  std::vector<value_type> _slots;  // a power of two of them, plus one at the end for the empty key
+  size_type _size{0};              // excluding the empty key
+  bool _has_empty{false};
+  unsigned _shift{64};
+  KeyPolicy _policy;
+
+  size_type _capacity() const noexcept { return _slots.empty() ? 0 : _slots.size() - 1; }
+  // Fibonacci hashing, whose top bits depend on every bit of the id and value
+  size_type _home(const key_type &key) const noexcept
+  {
+    return static_cast<size_type>(((key.domain().id() ^ static_cast<uint64_t>(key.value())) * 0x9e3779b97f4a7c15ULL) >> _shift);
+  }
+  static bool _equal(const key_type &a, const key_type &b) noexcept
+  {
+    return a.value() == b.value() && (&a.domain() == &b.domain() || a.domain() == b.domain());
+  }
+  bool _occupied(size_type idx) const noexcept { return (idx == _capacity()) ? _has_empty : !_slots[idx].first.empty(); }
+  // Returns the slot holding `key`, or the empty slot where it would go. `key` must not be empty.
+  size_type _find(const key_type &key) const noexcept
+  {
+    const size_type mask = _capacity() - 1;
+    size_type idx = _home(key);
+    while(!_slots[idx].first.empty() && !_equal(_slots[idx].first, key))
+    {
+      idx = (idx + 1) & mask;
+    }
+    return idx;
+  }
+  void _rehash(size_type capacity)
+  {
+    std::vector<value_type> old(capacity + 1);
+    old.swap(_slots);
+    _shift = 64;
+    for(size_type n = capacity; n > 1; n >>= 1U)
+    {
+      _shift--;
+    }
+    if(!old.empty())
+    {
+      _slots.back().second = std::move(old.back().second);
+      for(size_type n = 0; n + 1 < old.size(); n++)
+      {
+        if(!old[n].first.empty())
+        {
+          _slots[_find(old[n].first)] = std::move(old[n]);
+        }
+      }
+    }
+  }
+
+public:
+  //! Iterates over the entries, in no particular order.
+  class const_iterator
+  {
+    friend class status_code_flat_map;
+    const status_code_flat_map *_map{nullptr};
+    size_type _idx{0};
+
+    const_iterator(const status_code_flat_map *map, size_type idx) noexcept
+        : _map(map)
+        , _idx(idx)
+    {
+      _skip();
+    }
+    void _skip() noexcept
+    {
+      while(_idx < _map->_slots.size() && !_map->_occupied(_idx))
+      {
+        _idx++;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename status_code_flat_map::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    const_iterator() = default;
+    reference operator*() const noexcept { return _map->_slots[_idx]; }
+    pointer operator->() const noexcept { return &_map->_slots[_idx]; }
+    const_iterator &operator++() noexcept
+    {
+      _idx++;
+      _skip();
+      return *this;
+    }
+    const_iterator operator++(int) noexcept
+    {
+      const_iterator ret(*this);
+      ++*this;
+      return ret;
+    }
+    bool operator==(const const_iterator &o) const noexcept { return _idx == o._idx; }
+    bool operator!=(const const_iterator &o) const noexcept { return _idx != o._idx; }
+  };
+
+  //! Default construction to empty, without allocating.
+  status_code_flat_map() = default;
+  //! Construction with a key policy.
+  explicit status_code_flat_map(KeyPolicy policy)
+      : _policy(static_cast<KeyPolicy &&>(policy))
+  {
+  }
+
+  //! Returns the number of entries.
+  size_type size() const noexcept { return _size + (_has_empty ? 1 : 0); }
+  //! True if there are no entries.
+  bool empty() const noexcept { return size() == 0; }
+  //! Makes room for `n` entries without rehashing.
+  void reserve(size_type n)
+  {
+    size_type capacity = 16;
+    while(capacity * 3 < n * 4)
+    {
+      capacity *= 2;
+    }
+    if(capacity > _capacity())
+    {
+      _rehash(capacity);
+    }
+  }
+  //! Removes all entries, keeping the storage.
+  void clear()
+  {
+    for(auto &slot : _slots)
+    {
+      slot = value_type();
+    }
+    _size = 0;
+    _has_empty = false;
+  }
+
+  //! Returns an iterator to the first entry.
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  //! Returns an iterator past the last entry.
+  const_iterator end() const noexcept { return const_iterator(this, _slots.size()); }
+
+  //! Returns a pointer to the value mapped to `k`, or null if there is none.
+  mapped_type *find(const key_type &k) noexcept
+  {
+    const key_type key = _policy(k);
+    if(key.empty())
+    {
+      return _has_empty ? &_slots.back().second : nullptr;
+    }
+    if(_size == 0)
+    {
+      return nullptr;
+    }
+    value_type &slot = _slots[_find(key)];
+    return slot.first.empty() ? nullptr : &slot.second;
+  }
+  //! \overload
+  const mapped_type *find(const key_type &k) const noexcept { return const_cast<status_code_flat_map *>(this)->find(k); }
+  //! True if there is a value mapped to `k`.
+  bool contains(const key_type &k) const noexcept { return find(k) != nullptr; }
+
+  /*! Maps `k` to a value constructed from `args` if `k` is not mapped already. Returns a pointer
+  to the value mapped to `k`, and whether it was inserted.
+  */
+  template <class... Args> std::pair<mapped_type *, bool> try_emplace(const key_type &k, Args &&...args)
+  {
+    const key_type key = _policy(k);
+    if(_slots.empty())
+    {
+      _rehash(16);
+    }
+    if(key.empty())
+    {
+      const bool inserted = !_has_empty;
+      if(inserted)
+      {
+        _slots.back().second = mapped_type(static_cast<Args &&>(args)...);
+        _has_empty = true;
+      }
+      return {&_slots.back().second, inserted};
+    }
+    size_type idx = _find(key);
+    if(!_slots[idx].first.empty())
+    {
+      return {&_slots[idx].second, false};
+    }
+    if((_size + 1) * 4 > _capacity() * 3)
+    {
+      _rehash(_capacity() * 2);
+      idx = _find(key);
+    }
+    value_type &slot = _slots[idx];
+    slot.first = key;
+    slot.second = mapped_type(static_cast<Args &&>(args)...);
+    _size++;
+    return {&slot.second, true};
+  }
+  //! Returns the value mapped to `k`, mapping a default constructed value to it first if there is none.
+  mapped_type &operator[](const key_type &k) { return *try_emplace(k).first; }
+
+  //! Removes the value mapped to `k`, returning true if there was one.
+  bool erase(const key_type &k)
+  {
+    const key_type key = _policy(k);
+    if(key.empty())
+    {
+      if(!_has_empty)
+      {
+        return false;
+      }
+      _slots.back().second = mapped_type();
+      _has_empty = false;
+      return true;
+    }
+    if(_size == 0)
+    {
+      return false;
+    }
+    size_type idx = _find(key);
+    if(_slots[idx].first.empty())
+    {
+      return false;
+    }
+    // Shift back each following entry which may, so no tombstone is needed
+    const size_type mask = _capacity() - 1;
+    for(size_type next = (idx + 1) & mask; !_slots[next].first.empty(); next = (next + 1) & mask)
+    {
+      if(((next - _home(_slots[next].first)) & mask) >= ((next - idx) & mask))
+      {
+        _slots[idx] = std::move(_slots[next]);
+        idx = next;
+      }
+    }
+    _slots[idx] = value_type();
+    _size--;
+    return true;
+  }
+};
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,141 @@
+/* A non-owning reference to a SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_STATUS_CODE_REF_HPP
+#define SYSTEM_ERROR2_STATUS_CODE_REF_HPP
+
+#include "generic_code.hpp"
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  // What an empty status_code_ref refers to
+  inline const status_code<void> &empty_status_code() noexcept
+  {
+    static const generic_code v;
+    return v;
+  }
+}  // namespace detail
+
+/*! A non-owning, trivially copyable reference to a status code of any domain, such as an erased
+`system_code` which cannot be copied. It is two pointers, one to the code and one to its domain,
+and offers the read only API of `status_code<void>`.
+
+Unlike a `const status_code<void> &`, it can be stored, say in a queue of codes to be logged, and
+unlike `clone()` it costs neither a virtual call nor, for nested codes, an allocation. It is valid
+only until the status code it refers to is destroyed or assigned to, as with `string_view`.
+*/
+class status_code_ref
+{
+  const status_code_domain *_domain{nullptr};
+  const status_code<void> *_code{&detail::empty_status_code()};
+
+public:
+  //! The type of a reference to a message string.
+  using string_ref = typename status_code_domain::string_ref;
+
+  //! Constructs an empty reference.
+  status_code_ref() = default;
+  //! Constructs a reference to `code`.
+  status_code_ref(const status_code<void> &code) noexcept  // NOLINT
+      : _domain(code.empty() ? nullptr : &code.domain())
+      , _code(&code)
+  {
+  }
+
+  //! Return the status code referred to.
+  const status_code<void> &get() const noexcept { return *_code; }
+  //! Return the status code domain.
+  constexpr const status_code_domain &domain() const noexcept { return *_domain; }
+  //! True if the status code referred to is empty.
+  SYSTEM_ERROR2_NODISCARD constexpr bool empty() const noexcept { return _domain == nullptr; }
+
+  //! Return a reference to a string textually representing the code.
+  string_ref message() const noexcept { return _code->message(); }
+  //! Write the text representing the code into `buffer`, as `status_code<void>::message_into()`.
+  size_t message_into(char *buffer, size_t length) const noexcept { return _code->message_into(buffer, length); }
+  //! True if code means success.
+  bool success() const noexcept { return _code->success(); }
+  //! True if code means failure.
+  bool failure() const noexcept { return _code->failure(); }
+  //! True if code is strictly (and potentially non-transitively) semantically equivalent to another code in another domain.
+  template <class T> bool strictly_equivalent(const status_code<T> &o) const noexcept { return _code->strictly_equivalent(o); }
+  //! True if code is equivalent, by any means, to another code in another domain.
+  template <class T> bool equivalent(const status_code<T> &o) const noexcept { return _code->equivalent(o); }
+  //! \overload
+  bool equivalent(status_code_ref o) const noexcept { return _code->equivalent(*o._code); }
+  //! True if code is equivalent to any of the `errc` values in `set`.
+  bool matches(const errc_set &set) const noexcept { return _code->matches(set); }
+
+  //! If the code referred to is a `StatusCode`, return a pointer to it. Otherwise return null.
+  template <class StatusCode> const StatusCode *get_if() const noexcept
+  {
+    return (_domain != nullptr && _domain->id() == typename StatusCode::domain_type().id()) ? static_cast<const StatusCode *>(_code) : nullptr;  // NOLINT
+  }
+};
+static_assert(sizeof(status_code_ref) == 2 * sizeof(void *), "status_code_ref is not two pointers!");
+#if !defined(__GNUC__) || __GNUC__ >= 5
+static_assert(std::is_trivially_copyable<status_code_ref>::value, "status_code_ref is not trivially copyable!");
+#endif
+
+//! True if the referenced status codes are semantically equal via `equivalent()`.
+inline bool operator==(status_code_ref a, status_code_ref b) noexcept
+{
+  return a.get() == b.get();
+}
+//! True if the referenced status codes are not semantically equal via `equivalent()`.
+inline bool operator!=(status_code_ref a, status_code_ref b) noexcept
+{
+  return a.get() != b.get();
+}
+// Status codes convert to status_code_ref, so these must be kept from matching them
+//! True if the referenced status code is semantically equal to `b`, as if the status code itself were compared.
+template <class R, class T, typename std::enable_if<std::is_same<R, status_code_ref>::value, bool>::type = true>
+inline auto operator==(const R &a, const T &b) -> decltype(a.get() == b)
+{
+  return a.get() == b;
+}
+//! True if the referenced status code is semantically equal to `a`, as if the status code itself were compared.
+template <class T, class R, typename std::enable_if<std::is_same<R, status_code_ref>::value, bool>::type = true>
+inline auto operator==(const T &a, const R &b) -> decltype(b.get() == a)
+{
+  return b.get() == a;
+}
+//! True if the referenced status code is not semantically equal to `b`, as if the status code itself were compared.
+template <class R, class T, typename std::enable_if<std::is_same<R, status_code_ref>::value, bool>::type = true>
+inline auto operator!=(const R &a, const T &b) -> decltype(a.get() != b)
+{
+  return a.get() != b;
+}
+//! True if the referenced status code is not semantically equal to `a`, as if the status code itself were compared.
+template <class T, class R, typename std::enable_if<std::is_same<R, status_code_ref>::value, bool>::type = true>
+inline auto operator!=(const T &a, const R &b) -> decltype(b.get() != a)
+{
+  return b.get() != a;
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
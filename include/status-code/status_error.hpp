@@ -86,6 +86,12 @@ public:
       : _code(static_cast<status_code<DomainType> &&>(code))
       , _msgref(_code.message())
   {
+#if SYSTEM_ERROR2_USDT
+    if(!_code.empty())
+    {
+      SYSTEM_ERROR2_USDT_PROBE(status_error_constructed, _code.domain().id(), detail::error_counter_value(_code.value()));
+    }
+#endif
   }
 
   //! Return an explanatory string
@@ -121,6 +127,12 @@ public:
       : _code(static_cast<status_code<detail::erased<ErasedType>> &&>(code))
       , _msgref(_code.message())
   {
+#if SYSTEM_ERROR2_USDT
+    if(!_code.empty())
+    {
+      SYSTEM_ERROR2_USDT_PROBE(status_error_constructed, _code.domain().id(), detail::error_counter_value(_code.value()));
+    }
+#endif
   }
 
   //! Return an explanatory string
@@ -49,14 +49,26 @@ For Windows, these might be:
 
 For POSIX, `posix_code` is possible.
 
-You are guaranteed that `system_code` can be transported by the compiler
-in exactly two CPU registers.
+`system_code` is exactly two pointers in size, and is transported by the
+compiler in two CPU registers where `[[clang::trivial_abi]]` is supported.
+Elsewhere, including on GCC, its destructor makes it passed and returned in
+memory. Use `trivial_system_code` if that matters.
 */
 using system_code = erased_status_code<intptr_t>;
 
+/*! A `system_code` which can only hold codes of trivially erasable domains,
+which include all the system code domains, but not nested nor chained codes.
+It is trivially copyable and destructible, so every compiler transports it
+in exactly two CPU registers. It converts implicitly into `system_code`.
+*/
+using trivial_system_code = trivial_erased_status_code<intptr_t>;
+
 #ifndef NDEBUG
 static_assert(sizeof(system_code) == 2 * sizeof(void *), "system_code is not exactly two pointers in size!");
 static_assert(traits::is_move_bitcopying<system_code>::value, "system_code is not move bitcopying!");
+static_assert(sizeof(trivial_system_code) == 2 * sizeof(void *), "trivial_system_code is not exactly two pointers in size!");
+static_assert(std::is_trivially_copyable<trivial_system_code>::value, "trivial_system_code is not trivially copyable!");
+static_assert(std::is_trivially_destructible<trivial_system_code>::value, "trivial_system_code is not trivially destructible!");
 #endif
 
 SYSTEM_ERROR2_NAMESPACE_END
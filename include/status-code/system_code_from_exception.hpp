@@ -35,114 +35,131 @@ http://www.boost.org/LICENSE_1_0.txt)
 
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
-/*! A utility function which returns the closest matching system_code to a supplied
-exception ptr.
-*/
-inline system_code system_code_from_exception(std::exception_ptr &&ep = std::current_exception(), system_code not_matched = generic_code(errc::resource_unavailable_try_again)) noexcept
+namespace detail
 {
-  if(!ep)
+  inline system_code system_code_from_exception(std::exception_ptr &&ep, system_code not_matched) noexcept
   {
-    return generic_code(errc::success);
-  }
-  try
-  {
-    try
+    if(!ep)
     {
-      std::rethrow_exception(ep);
+      return generic_code(errc::success);
     }
-    catch(const status_error<void> &e)
+    try
     {
       try
       {
-        system_code erased(e.code());
-        if(!erased.empty())
+        std::rethrow_exception(ep);
+      }
+      catch(const status_error<void> &e)
+      {
+        try
+        {
+          system_code erased(e.code());
+          if(!erased.empty())
+          {
+            return erased;
+          }
+        }
+        catch(...)
         {
-          return erased;
+          // Source status code's do_erased_copy() routine refused to copy the original
+          // Process instead as if the source were not a status_error
         }
+        throw;
       }
       catch(...)
       {
-        // Source status code's do_erased_copy() routine refused to copy the original
-        // Process instead as if the source were not a status_error
+        throw;
       }
-      throw;
     }
-    catch(...)
+    catch(const std::invalid_argument & /*unused*/)
     {
-      throw;
+      ep = std::exception_ptr();
+      return generic_code(errc::invalid_argument);
     }
-  }
-  catch(const std::invalid_argument & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::invalid_argument);
-  }
-  catch(const std::domain_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::argument_out_of_domain);
-  }
-  catch(const std::length_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::argument_list_too_long);
-  }
-  catch(const std::out_of_range & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::result_out_of_range);
-  }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::invalid_argument);
-  }
-  catch(const std::system_error &e) /* also catches ios::failure */
-  {
-    ep = std::exception_ptr();
-    if(e.code().category() == std::generic_category())
+    catch(const std::domain_error & /*unused*/)
     {
-      return generic_code(static_cast<errc>(static_cast<int>(e.code().value())));
+      ep = std::exception_ptr();
+      return generic_code(errc::argument_out_of_domain);
     }
-    if(e.code().category() == std::system_category())
+    catch(const std::length_error & /*unused*/)
     {
-#ifdef _WIN32
-      return win32_code(e.code().value());
-#else
-#ifndef SYSTEM_ERROR2_NOT_POSIX
-      return posix_code(e.code().value());
-#else
-      return generic_code(static_cast<errc>(e.code().value()));
-#endif
-#endif
+      ep = std::exception_ptr();
+      return generic_code(errc::argument_list_too_long);
     }
-    // Don't know this error code category, can't wrap it into std_error_code
-    // as its payload won't fit into system_code, so fall through.
-  }
-  catch(const std::overflow_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::value_too_large);
-  }
-  catch(const std::range_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::result_out_of_range);
-  }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::resource_unavailable_try_again);
-  }
-  catch(const std::bad_alloc & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::not_enough_memory);
+    catch(const std::out_of_range & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      ep = std::exception_ptr();
+      if(e.code().category() == std::generic_category())
+      {
+        return generic_code(static_cast<errc>(static_cast<int>(e.code().value())));
+      }
+      if(e.code().category() == std::system_category())
+      {
+  #ifdef _WIN32
+        return win32_code(e.code().value());
+  #else
+  #ifndef SYSTEM_ERROR2_NOT_POSIX
+        return posix_code(e.code().value());
+  #else
+        return generic_code(static_cast<errc>(e.code().value()));
+  #endif
+  #endif
+      }
+      // Don't know this error code category, can't wrap it into std_error_code
+      // as its payload won't fit into system_code, so fall through.
+    }
+    catch(const std::overflow_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::not_enough_memory);
+    }
+    catch(...)
+    {
+    }
+    return not_matched;
   }
-  catch(...)
+}  // namespace detail
+
+/*! A utility function which returns the closest matching system_code to a supplied
+exception ptr.
+*/
+inline system_code system_code_from_exception(std::exception_ptr &&ep = std::current_exception(), system_code not_matched = generic_code(errc::resource_unavailable_try_again)) noexcept
+{
+#if SYSTEM_ERROR2_USDT
+  system_code ret = detail::system_code_from_exception(static_cast<std::exception_ptr &&>(ep), static_cast<system_code &&>(not_matched));
+  if(!ret.empty())
   {
+    SYSTEM_ERROR2_USDT_PROBE(code_from_exception, ret.domain().id(), ret.value());
   }
-  return not_matched;
+  return ret;
+#else
+  return detail::system_code_from_exception(static_cast<std::exception_ptr &&>(ep), static_cast<system_code &&>(not_matched));
+#endif
 }
 
 SYSTEM_ERROR2_NAMESPACE_END
@@ -0,0 +1,96 @@
+/* USDT probes for SG14 status_code
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_USDT_HPP
+#define SYSTEM_ERROR2_USDT_HPP
+
+#include "error_counters.hpp"  // for error_counter_value
+
+/*! \def SYSTEM_ERROR2_USDT_PROBE(name, domain_id, value)
+\brief Places a USDT probe of provider `system_error2` named `name`, with arguments
+the unsigned 64 bit domain id and the signed 64 bit raw value of a status code.
+
+When `SYSTEM_ERROR2_USDT` is enabled, probes are placed at:
+
+- `error_constructed`: an errored status code was constructed.
+- `error_thrown`: `throw_exception()` was called upon a status code.
+- `status_error_constructed`: a `status_error` was constructed.
+- `code_from_exception`: `system_code_from_exception()` returned a code.
+- `nested_code_made`: `make_nested_status_code()` nested a status code.
+
+Each probe is a single `nop` instruction plus the loading of its arguments unless
+a tracer such as bpftrace or perf attaches to it, for example:
+
+\code
+bpftrace -e 'usdt:./app:system_error2:error_thrown { @[arg0, arg1] = count(); }'
+\endcode
+
+If `<sys/sdt.h>` is available it is used, otherwise on x86-64 and AArch64 ELF
+targets the `.note.stapsdt` ELF note is emitted directly. On other targets probes
+expand to nothing.
+*/
+#if !SYSTEM_ERROR2_USDT
+#define SYSTEM_ERROR2_USDT_PROBE(name, domain_id, value)
+#else
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define SYSTEM_ERROR2_USDT_PROBE(name, domain_id, value)                                                                                                       \
+  STAP_PROBE2(system_error2, name, static_cast<unsigned long long>(domain_id), static_cast<long long>(value))
+#endif
+#endif
+#if !defined(SYSTEM_ERROR2_USDT_PROBE) && defined(__ELF__) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+// This emits the same ELF note as <sys/sdt.h> does, version 3 of the format
+#define SYSTEM_ERROR2_USDT_PROBE(name, domain_id, value)                                                                                                       \
+  __asm__ __volatile__("990: nop\n"                                                                                                                            \
+                       ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                                                                           \
+                       ".balign 4\n"                                                                                                                           \
+                       ".4byte 992f-991f, 994f-993f, 3\n"                                                                                                      \
+                       "991: .asciz \"stapsdt\"\n"                                                                                                             \
+                       "992: .balign 4\n"                                                                                                                      \
+                       "993: .8byte 990b\n"                                                                                                                    \
+                       ".8byte _.stapsdt.base\n"                                                                                                               \
+                       ".8byte 0\n"                                                                                                                            \
+                       ".asciz \"system_error2\"\n"                                                                                                            \
+                       ".asciz \"" #name "\"\n"                                                                                                                \
+                       ".asciz \"8@%0 -8@%1\"\n"                                                                                                               \
+                       "994: .balign 4\n"                                                                                                                      \
+                       ".popsection\n"                                                                                                                         \
+                       ".ifndef _.stapsdt.base\n"                                                                                                              \
+                       ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"                                                                 \
+                       ".weak _.stapsdt.base\n"                                                                                                                \
+                       ".hidden _.stapsdt.base\n"                                                                                                              \
+                       "_.stapsdt.base: .space 1\n"                                                                                                            \
+                       ".size _.stapsdt.base, 1\n"                                                                                                             \
+                       ".popsection\n"                                                                                                                         \
+                       ".endif\n"                                                                                                                              \
+                       :                                                                                                                                       \
+                       : "nor"(static_cast<unsigned long long>(domain_id)), "nor"(static_cast<long long>(value)))
+#endif
+#ifndef SYSTEM_ERROR2_USDT_PROBE
+#define SYSTEM_ERROR2_USDT_PROBE(name, domain_id, value)
+#endif
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+/* Dispatch of erased status codes to handlers for their typed codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_VISIT_HPP
+#define SYSTEM_ERROR2_VISIT_HPP
+
+#include "generic_code.hpp"
+
+#include <utility>  // for declval
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  using visit_id_type = status_code_domain::unique_id_type;
+  template <class Code> constexpr inline visit_id_type visit_id() noexcept { return typename Code::domain_type().id(); }
+
+  template <size_t I, class... Codes> struct visit_type_at;
+  template <class Code, class... Codes> struct visit_type_at<0, Code, Codes...>
+  {
+    using type = Code;
+  };
+  template <size_t I, class Code, class... Codes> struct visit_type_at<I, Code, Codes...> : visit_type_at<I - 1, Codes...>
+  {
+  };
+
+  // The candidates' domain ids in the order given, and where each goes when sorted
+  template <class... Codes> struct visit_order
+  {
+    static constexpr size_t count = sizeof...(Codes);
+    static constexpr visit_id_type ids[count + 1] = {visit_id<Codes>()..., 0};  // not zero length when there are no candidates
+    static constexpr size_t rank(size_t i, size_t j = 0) noexcept { return (j == count) ? 0 : ((ids[j] < ids[i]) ? 1 : 0) + rank(i, j + 1); }
+    static constexpr size_t with_rank(size_t k, size_t i = 0) noexcept { return (i == count || rank(i) == k) ? i : with_rank(k, i + 1); }
+    static constexpr bool unique_from(size_t i, size_t j) noexcept { return j >= count || (ids[i] != ids[j] && unique_from(i, j + 1)); }
+    static constexpr bool unique(size_t i = 0) noexcept { return i >= count || (unique_from(i, i + 1) && unique(i + 1)); }
+  };
+  template <class... Codes> constexpr visit_id_type visit_order<Codes...>::ids[visit_order<Codes...>::count + 1];
+
+  template <class Visitor> using visit_result = decltype(std::declval<Visitor &>()(std::declval<const status_code<void> &>()));
+
+  // Few candidates are fastest as an unrolled chain of compares
+  template <class... Codes> struct visit_chain
+  {
+    template <class Visitor> static visit_result<Visitor> invoke(Visitor &visitor, const status_code<void> &code, visit_id_type /*unused*/)
+    {
+      return visitor(code);
+    }
+  };
+  template <class Code, class... Codes> struct visit_chain<Code, Codes...>
+  {
+    template <class Visitor> static visit_result<Visitor> invoke(Visitor &visitor, const status_code<void> &code, visit_id_type id)
+    {
+      if(id == visit_id<Code>())
+      {
+        return visitor(static_cast<const Code &>(code));  // NOLINT
+      }
+      return visit_chain<Codes...>::invoke(visitor, code, id);
+    }
+  };
+
+  // Many candidates are fastest as an unrolled binary search of their ids sorted at compile time
+  template <class... Codes> struct visit_tree
+  {
+    static constexpr size_t count = sizeof...(Codes);
+    template <size_t K> using code_with_rank = typename visit_type_at<visit_order<Codes...>::with_rank(K), Codes...>::type;
+
+    template <size_t... K> struct sorted_source
+    {
+      static constexpr visit_id_type ids[count] = {visit_id<code_with_rank<K>>()...};
+    };
+    template <size_t... K> static sorted_source<K...> make_sorted(index_sequence<K...> /*unused*/);
+    using sorted = decltype(make_sorted(typename make_index_sequence<count>::type()));
+
+    template <size_t Lo, size_t Hi, bool Leaf = (Hi - Lo == 1)> struct node
+    {
+      template <class Visitor> static visit_result<Visitor> invoke(Visitor &visitor, const status_code<void> &code, visit_id_type id)
+      {
+        if(id < sorted::ids[(Lo + Hi) / 2])
+        {
+          return node<Lo, (Lo + Hi) / 2>::invoke(visitor, code, id);
+        }
+        return node<(Lo + Hi) / 2, Hi>::invoke(visitor, code, id);
+      }
+    };
+    template <size_t Lo, size_t Hi> struct node<Lo, Hi, true>
+    {
+      template <class Visitor> static visit_result<Visitor> invoke(Visitor &visitor, const status_code<void> &code, visit_id_type id)
+      {
+        if(id == sorted::ids[Lo])
+        {
+          return visitor(static_cast<const code_with_rank<Lo> &>(code));  // NOLINT
+        }
+        return visitor(code);
+      }
+    };
+    template <class Visitor> static visit_result<Visitor> invoke(Visitor &visitor, const status_code<void> &code, visit_id_type id)
+    {
+      return node<0, count>::invoke(visitor, code, id);
+    }
+  };
+  template <class... Codes>
+  template <size_t... K>
+  constexpr visit_id_type visit_tree<Codes...>::sorted_source<K...>::ids[visit_tree<Codes...>::count];
+
+  // An if-chain is quicker until somewhere between 8 and 16 candidates
+  template <class... Codes> using visit_dispatch = typename std::conditional<(sizeof...(Codes) <= 8), visit_chain<Codes...>, visit_tree<Codes...>>::type;
+}  // namespace detail
+
+/*! Calls `visitor` with `code` as whichever of the status code types `Codes` shares its domain,
+or with `code` itself as a `const status_code<void> &` if none do or it is empty. Handlers
+receive a reference to `code`, so nothing is copied, and all must return something convertible
+to what the default handler for `const status_code<void> &` returns.
+
+This replaces comparing `code.domain()` against each candidate domain in turn. Up to eight
+candidates are still compared in turn; more are found by a binary search over their domain
+ids, sorted at compile time and unrolled into a tree of compares. Either way the handlers
+can be inlined. The domains of `Codes` must have constexpr default constructors, and be
+distinct.
+
+\code
+visit<posix_code, http_status_code>(sc, overloaded{
+  [](const posix_code &c) { ... },
+  [](const http_status_code &c) { ... },
+  [](const status_code<void> &c) { ... }});
+\endcode
+*/
+template <class... Codes, class Visitor> inline detail::visit_result<Visitor> visit(const status_code<void> &code, Visitor &&visitor)
+{
+  static_assert(detail::visit_order<Codes...>::unique(), "visit() needs status code types of distinct domains");
+  if(code.empty())
+  {
+    return visitor(code);
+  }
+  return detail::visit_dispatch<Codes...>::invoke(visitor, code, code.domain().id());
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
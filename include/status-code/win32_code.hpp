@@ -30,6 +30,7 @@ http://www.boost.org/LICENSE_1_0.txt)
 #endif
 
 #include "quick_status_code_from_enum.hpp"
+#include "windows_code_mappings.hpp"
 
 SYSTEM_ERROR2_NAMESPACE_BEGIN
 
@@ -64,6 +65,37 @@ namespace win32
 #endif
 }  // namespace win32
 
+namespace detail
+{
+  // Converts a message from `FormatMessageW()`, less trailing newlines, to UTF-8 in the manner of `_do_message_into()`
+  inline size_t win32_message_into(const wchar_t *wbuffer, win32::DWORD wlen, char *buffer, size_t length) noexcept
+  {
+    while(wlen > 0 && (wbuffer[wlen - 1] == 10 || wbuffer[wlen - 1] == 13))
+    {
+      --wlen;
+    }
+    if(wlen == 0)
+    {
+      return message_copy(buffer, length, "failed to get message from system");
+    }
+    const int bytes = win32::WideCharToMultiByte(65001 /*CP_UTF8*/, 0, wbuffer, (int) wlen, nullptr, 0, nullptr, nullptr);
+    if(bytes <= 0)
+    {
+      return message_copy(buffer, length, "failed to get message from system");
+    }
+    if(static_cast<size_t>(bytes) < length)
+    {
+      win32::WideCharToMultiByte(65001 /*CP_UTF8*/, 0, wbuffer, (int) wlen, buffer, bytes, nullptr, nullptr);
+      buffer[bytes] = 0;
+    }
+    else if(length > 0)
+    {
+      buffer[0] = 0;  // don't truncate part way through a UTF-8 sequence
+    }
+    return static_cast<size_t>(bytes);
+  }
+}  // namespace detail
+
 class _win32_code_domain;
 class _com_code_domain;
 //! (Windows only) A Win32 error code, those returned by `GetLastError()`.
@@ -90,16 +122,7 @@ class _win32_code_domain : public status_code_domain
   template <class StatusCode, class Allocator> friend class detail::indirecting_domain;
   friend class _com_code_domain;
   using _base = status_code_domain;
-  static int _win32_code_to_errno(win32::DWORD c)
-  {
-    switch(c)
-    {
-    case 0:
-      return 0;
-#include "detail/win32_code_to_generic_code.ipp"
-    }
-    return -1;
-  }
+  static int _win32_code_to_errno(win32::DWORD c) { return static_cast<int>(errc_from_win32_code(static_cast<uint32_t>(c))); }
   //! Construct from a Win32 error code
   static _base::string_ref _make_string_ref(win32::DWORD c) noexcept
   {
@@ -199,11 +222,30 @@ protected:
     const auto &c = static_cast<const win32_code &>(code);  // NOLINT
     return generic_code(static_cast<errc>(_win32_code_to_errno(c.value())));
   }
+  virtual bool _is_trivially_erasable() const noexcept override { return true; }  // NOLINT
   virtual string_ref _do_message(const status_code<void> &code) const noexcept override  // NOLINT
   {
     assert(code.domain() == *this);
     const auto &c = static_cast<const win32_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    // Fetching messages from the system may allocate and take locks
+    return detail::generic_code_message_ref(static_cast<errc>(_win32_code_to_errno(c.value())));
+#else
     return _make_string_ref(c.value());
+#endif
+  }
+  virtual size_t _do_message_into(const status_code<void> &code, char *buffer, size_t length) const noexcept override  // NOLINT
+  {
+    assert(code.domain() == *this);
+    const auto &c = static_cast<const win32_code &>(code);  // NOLINT
+#if SYSTEM_ERROR2_REALTIME
+    return detail::message_copy(buffer, length, detail::generic_code_message(static_cast<errc>(_win32_code_to_errno(c.value()))));
+#else
+    wchar_t wbuffer[32768];
+    win32::DWORD wlen = win32::FormatMessageW(0x00001000 /*FORMAT_MESSAGE_FROM_SYSTEM*/ | 0x00000200 /*FORMAT_MESSAGE_IGNORE_INSERTS*/, nullptr, c.value(), 0,
+                                              wbuffer, 32768, nullptr);
+    return detail::win32_message_into(wbuffer, wlen, buffer, length);
+#endif
   }
 #if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
   SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override  // NOLINT
@@ -221,6 +263,14 @@ inline constexpr const _win32_code_domain &_win32_code_domain::get()
   return win32_code_domain;
 }
 
+namespace traits
+{
+  template <> struct is_trivially_erasable<_win32_code_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+
 namespace mixins
 {
   template <class Base> inline win32_code mixin<Base, _win32_code_domain>::current() noexcept
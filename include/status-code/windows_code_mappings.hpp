@@ -0,0 +1,144 @@
+/* OS independent mappings of NT kernel and Win32 error codes
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#ifndef SYSTEM_ERROR2_WINDOWS_CODE_MAPPINGS_HPP
+#define SYSTEM_ERROR2_WINDOWS_CODE_MAPPINGS_HPP
+
+#include "generic_code.hpp"
+
+#include <cstdint>  // for uint32_t
+
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+
+namespace detail
+{
+  struct nt_code_to_win32_code_entry
+  {
+    uint32_t code;
+    uint16_t win32;  // every mapped Win32 code is below 0xffff
+  };
+  struct windows_code_to_errc_entry
+  {
+    uint32_t code;
+    errc value;
+  };
+  /* The mapping tables generated by utils/generate-tables.cpp, sorted by code.
+  They use no Windows headers, so are usable everywhere.
+  */
+  template <class T = void> struct nt_code_to_win32_code_source
+  {
+    static constexpr nt_code_to_win32_code_entry entries[] = {
+#include "detail/nt_code_to_win32_code.ipp"
+    };
+    static constexpr size_t count = sizeof(entries) / sizeof(entries[0]);
+  };
+  template <class T> constexpr nt_code_to_win32_code_entry nt_code_to_win32_code_source<T>::entries[];
+  template <class T = void> struct nt_code_to_errc_source
+  {
+    static constexpr windows_code_to_errc_entry entries[] = {
+#include "detail/nt_code_to_generic_code.ipp"
+    };
+    static constexpr size_t count = sizeof(entries) / sizeof(entries[0]);
+  };
+  template <class T> constexpr windows_code_to_errc_entry nt_code_to_errc_source<T>::entries[];
+  template <class T = void> struct win32_code_to_errc_source
+  {
+    static constexpr windows_code_to_errc_entry entries[] = {
+#include "detail/win32_code_to_generic_code.ipp"
+    };
+    static constexpr size_t count = sizeof(entries) / sizeof(entries[0]);
+  };
+  template <class T> constexpr windows_code_to_errc_entry win32_code_to_errc_source<T>::entries[];
+
+  /* Returns the index of `code` in `Source`, or `Source::count` if it is not there.
+  The search narrows without branching on the comparisons, as codes from the wild are
+  too random for them to be predicted.
+  */
+  template <class Source> constexpr inline size_t windows_code_mapping_lower(uint32_t code, size_t base, size_t n) noexcept
+  {
+    return (n <= 1) ? base : windows_code_mapping_lower<Source>(code, (Source::entries[base + n / 2].code <= code) ? base + n / 2 : base, n - n / 2);
+  }
+  template <class Source> constexpr inline size_t windows_code_mapping_check(uint32_t code, size_t idx) noexcept
+  {
+    return (Source::entries[idx].code == code) ? idx : Source::count;
+  }
+  template <class Source> constexpr inline size_t windows_code_mapping_find(uint32_t code) noexcept
+  {
+    return windows_code_mapping_check<Source>(code, windows_code_mapping_lower<Source>(code, 0, Source::count));
+  }
+  // Checked by halving so the recursion depth stays within C++ 11 constexpr limits
+  template <class Source> constexpr inline bool windows_code_mapping_sorted(size_t lo = 0, size_t hi = Source::count) noexcept
+  {
+    return (hi - lo < 2) ? true :
+                           (Source::entries[lo + (hi - lo) / 2 - 1].code < Source::entries[lo + (hi - lo) / 2].code &&
+                            windows_code_mapping_sorted<Source>(lo, lo + (hi - lo) / 2) && windows_code_mapping_sorted<Source>(lo + (hi - lo) / 2, hi));
+  }
+  static_assert(windows_code_mapping_sorted<nt_code_to_win32_code_source<>>(), "nt_code_to_win32_code.ipp must be sorted by code");
+  static_assert(windows_code_mapping_sorted<nt_code_to_errc_source<>>(), "nt_code_to_generic_code.ipp must be sorted by code");
+  static_assert(windows_code_mapping_sorted<win32_code_to_errc_source<>>(), "win32_code_to_generic_code.ipp must be sorted by code");
+
+  constexpr inline uint32_t win32_code_from_nt_code_index(size_t idx) noexcept
+  {
+    return (idx == nt_code_to_win32_code_source<>::count) ? static_cast<uint32_t>(-1) : nt_code_to_win32_code_source<>::entries[idx].win32;
+  }
+  template <class Source> constexpr inline errc errc_from_windows_code_index(size_t idx) noexcept
+  {
+    return (idx == Source::count) ? errc::unknown : Source::entries[idx].value;
+  }
+}  // namespace detail
+
+/*! Returns the Win32 error code which the NT kernel error code `ntstatus` maps onto,
+zero if `ntstatus` is not a failure, or `static_cast<uint32_t>(-1)` if it has no mapping.
+Available on all platforms, e.g. for decoding codes reported by Windows machines.
+*/
+constexpr inline uint32_t win32_code_from_nt_code(uint32_t ntstatus) noexcept
+{
+  return (ntstatus < 0x80000000u) ? 0 : detail::win32_code_from_nt_code_index(detail::windows_code_mapping_find<detail::nt_code_to_win32_code_source<>>(ntstatus));
+}
+
+/*! Returns the `errc` which the NT kernel error code `ntstatus` is equivalent to,
+`errc::success` if `ntstatus` is not a failure, or `errc::unknown` if it has no mapping.
+Available on all platforms.
+*/
+constexpr inline errc errc_from_nt_code(uint32_t ntstatus) noexcept
+{
+  return (ntstatus < 0x80000000u) ?
+         errc::success :
+         detail::errc_from_windows_code_index<detail::nt_code_to_errc_source<>>(detail::windows_code_mapping_find<detail::nt_code_to_errc_source<>>(ntstatus));
+}
+
+/*! Returns the `errc` which the Win32 error code `code` is equivalent to,
+`errc::success` if `code` is zero, or `errc::unknown` if it has no mapping.
+Available on all platforms.
+*/
+constexpr inline errc errc_from_win32_code(uint32_t code) noexcept
+{
+  return (code == 0) ?
+         errc::success :
+         detail::errc_from_windows_code_index<detail::win32_code_to_errc_source<>>(detail::windows_code_mapping_find<detail::win32_code_to_errc_source<>>(code));
+}
+
+SYSTEM_ERROR2_NAMESPACE_END
+
+#endif
@@ -0,0 +1,106 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/backtraced_status_code.hpp"
+#include "status-code/posix_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+int main()
+{
+  using namespace SYSTEM_ERROR2_NAMESPACE;
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+
+  // Sampling is off by default, so codes are erased as normal
+  CHECK(backtrace_sampling_period() == 0);
+  {
+    system_code sc = make_backtraced_status_code(posix_code(EBADF));
+    CHECK(sc.domain() == posix_code_domain);
+    CHECK(sc == errc::bad_file_descriptor);
+    CHECK(get_backtrace<posix_code>(sc) == nullptr);
+  }
+
+  // Sample every code
+  set_backtrace_sampling_period(1);
+  {
+    system_code sc = make_backtraced_status_code(posix_code(EBADF));
+    CHECK(sc.domain() != posix_code_domain);
+    CHECK(sc.failure());
+    CHECK(sc == errc::bad_file_descriptor);
+    CHECK(sc != errc::no_such_file_or_directory);
+    CHECK(0 == strcmp(sc.domain().name().c_str(), posix_code_domain.name().c_str()));
+    const status_code_backtrace *bt = get_backtrace<posix_code>(sc);
+    CHECK(bt != nullptr);
+    if(bt != nullptr)
+    {
+#if SYSTEM_ERROR2_HAVE_EXECINFO
+      CHECK(!bt->empty());
+#endif
+      CHECK(bt->size() <= SYSTEM_ERROR2_BACKTRACE_MAX_FRAMES);
+    }
+    auto msg = sc.message();
+    printf("%s\n", msg.c_str());
+    CHECK(strstr(msg.c_str(), posix_code(EBADF).message().c_str()) == msg.c_str());
+    CHECK(strstr(msg.c_str(), "Backtrace:") != nullptr);
+    char buffer[1024];
+    CHECK(sc.message_into(buffer, sizeof(buffer)) < sizeof(buffer));
+    CHECK(strstr(buffer, posix_code(EBADF).message().c_str()) == buffer);
+    CHECK(strstr(buffer, "Backtrace:\n  0x") != nullptr);
+
+    // Copies are independent but compare equal
+    system_code sc2(sc.clone());
+    CHECK(sc2 == sc);
+    CHECK(get_backtrace<posix_code>(sc2) != get_backtrace<posix_code>(sc));
+    CHECK(get_backtrace<posix_code>(sc2)->size() == bt->size());
+  }
+
+  // Sample one in three per thread
+  set_backtrace_sampling_period(3);
+  {
+    int sampled = 0;
+    for(int n = 0; n < 9; n++)
+    {
+      system_code sc = make_backtraced_status_code(posix_code(ENOENT));
+      CHECK(sc == errc::no_such_file_or_directory);
+      if(get_backtrace<posix_code>(sc) != nullptr)
+      {
+        sampled++;
+      }
+    }
+    CHECK(sampled == 3);
+  }
+  set_backtrace_sampling_period(0);
+  return retcode;
+}
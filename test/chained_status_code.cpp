@@ -0,0 +1,113 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/chained_status_code.hpp"
+#include "status-code/posix_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+int main()
+{
+  using namespace SYSTEM_ERROR2_NAMESPACE;
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+
+  // "permission denied because no such file because bad file descriptor"
+  system_code c = make_chained_status_code(posix_code(ENOENT), posix_code(EBADF));
+  const system_code *links = &*get_chain(c).end().base();
+  c = make_chained_status_code(posix_code(EACCES), std::move(c));
+  CHECK(&*get_chain(c).end().base() == links);  // appended in place
+  CHECK(sizeof(c) == sizeof(system_code));
+  CHECK(c.failure());
+  CHECK(c == errc::permission_denied);
+  CHECK(c == errc::no_such_file_or_directory);
+  CHECK(c == errc::bad_file_descriptor);
+  CHECK(c != errc::io_error);
+  {
+    auto chain = get_chain(c);
+    CHECK(chain.size() == 3);
+    CHECK(chain.omitted() == 0);
+    CHECK(chain.outermost() == errc::permission_denied);
+    CHECK(chain.root_cause() == errc::bad_file_descriptor);
+    int errnos[] = {EACCES, ENOENT, EBADF}, n = 0;
+    for(const auto &link : chain)
+    {
+      CHECK(link == posix_code(errnos[n++]));
+    }
+  }
+  auto msg = c.message();
+  printf("%s\n", msg.c_str());
+  CHECK(strstr(msg.c_str(), "; caused by: ") != nullptr);
+  CHECK(strstr(msg.c_str(), posix_code(EACCES).message().c_str()) == msg.c_str());
+
+  // Clones share the chain, and appending to a shared chain copies it
+  {
+    system_code c2 = c.clone();
+    CHECK(&*get_chain(c2).end().base() == &*get_chain(c).end().base());
+    system_code c3 = make_chained_status_code(posix_code(EIO), c2.clone());
+    CHECK(&*get_chain(c3).end().base() != &*get_chain(c).end().base());
+    CHECK(get_chain(c3).size() == 4);
+    CHECK(get_chain(c).size() == 3);
+    CHECK(c3 == errc::io_error);
+    CHECK(c3 == errc::bad_file_descriptor);
+    CHECK(c != errc::io_error);
+  }
+
+  // A code which is not a chain is a chain of itself
+  {
+    system_code plain = posix_code(EIO);
+    CHECK(get_chain(plain).size() == 1);
+    CHECK(make_chained_status_code(posix_code(EIO), system_code()) == posix_code(EIO));
+  }
+
+  // Depth is bounded, retaining the root cause and the outermost links
+  for(int n = 0; n < SYSTEM_ERROR2_CHAIN_MAX_DEPTH; n++)
+  {
+    c = make_chained_status_code(posix_code(EINTR), std::move(c));
+  }
+  {
+    auto chain = get_chain(c);
+    CHECK(chain.size() == SYSTEM_ERROR2_CHAIN_MAX_DEPTH);
+    CHECK(chain.omitted() == 3);
+    CHECK(chain.root_cause() == errc::bad_file_descriptor);
+    CHECK(c != errc::permission_denied);
+    msg = c.message();
+    printf("%s\n", msg.c_str());
+    CHECK(strstr(msg.c_str(), "(3 links omitted)") != nullptr);
+    char buffer[2048];
+    CHECK(c.message_into(buffer, sizeof(buffer)) == msg.size());
+    CHECK(0 == strcmp(buffer, msg.c_str()));
+  }
+  return retcode;
+}
@@ -0,0 +1,145 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/compact_code.hpp"
+#include "status-code/getaddrinfo_code.hpp"
+#include "status-code/http_status_code.hpp"
+#include "status-code/nested_status_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static_assert(sizeof(compact_code) == 8, "");
+static_assert(std::is_trivially_copyable<compact_code>::value, "");
+static_assert(std::is_convertible<posix_code, compact_code>::value, "");
+static_assert(std::is_convertible<http_status_code, compact_code>::value, "");
+// Erased codes may be of a domain which was never registered, so must be converted explicitly
+static_assert(!std::is_convertible<system_code, compact_code>::value, "");
+static_assert(std::is_constructible<compact_code, system_code>::value, "");
+// Nested codes own what they point to, so cannot be held at all
+static_assert(!std::is_convertible<status_code<detail::indirecting_domain<generic_code, std::allocator<generic_code>>>, compact_code>::value, "");
+
+int main()
+{
+  int retcode = 0;
+  compact_code_domain_registry &registry = compact_code_domain_registry::get();
+
+  // Empty codes
+  {
+    compact_code c;
+    CHECK(c.empty());
+    CHECK(c.index() == 0);
+    CHECK(!c.success());
+    CHECK(!c.failure());
+    CHECK(c.to_system_code().empty());
+    CHECK(c == compact_code());
+    CHECK(c != errc::success);
+    CHECK(compact_code(system_code()).empty());
+  }
+
+  // The system_code domains are always registered, and round trip losslessly
+  {
+    const posix_code p(ENOENT);
+    compact_code c = p;
+    CHECK(!c.empty());
+    CHECK(c.index() == registry.find(p.domain()));
+    CHECK(&c.domain() == &p.domain());
+    CHECK(c.failure());
+    CHECK(c == errc::no_such_file_or_directory);
+    CHECK(c != errc::permission_denied);
+    CHECK(c.to_system_code().strictly_equivalent(p));
+    CHECK(strcmp(c.message().c_str(), p.message().c_str()) == 0);
+    const system_code sc = c;
+    CHECK(sc.strictly_equivalent(p));
+    CHECK(compact_code(sc).strictly_equivalent(c));
+    CHECK(compact_code(posix_code(0)).success());
+    CHECK(c == generic_code(errc::no_such_file_or_directory));
+    CHECK(c != generic_code(errc::permission_denied));
+
+    // Negative values survive being squeezed into 32 bits and back
+    const compact_code u = generic_code(errc::unknown);
+    CHECK(u.to_system_code().strictly_equivalent(generic_code(errc::unknown)));
+    CHECK(u == errc::unknown);
+    compact_code e = errc::permission_denied;
+    CHECK(e == errc::permission_denied);
+    e.clear();
+    CHECK(e.empty());
+  }
+
+  // Other domains are registered on first use, and compare via the registry's table
+  {
+    const size_t registered = registry.size();
+    const compact_code c = http_status_code(404);
+    const compact_code ok = http_status_code(200);
+    CHECK(registry.size() == registered + 1);
+    CHECK(c.index() == ok.index());
+    CHECK(c.index() == compact_code_domain_registry::index_of<_http_status_code_domain>());
+    CHECK(c.failure());
+    CHECK(ok.success());
+    CHECK(c == errc::no_such_file_or_directory);
+    CHECK(c != errc::permission_denied);
+    CHECK(c == compact_code(posix_code(ENOENT)));
+    CHECK(c != compact_code(posix_code(EACCES)));
+    CHECK(c.to_system_code().strictly_equivalent(http_status_code(404)));
+    CHECK(registry.domain(c.index()) == &http_status_code(404).domain());
+  }
+
+  // Erased codes of unregistered domains compact to empty until their domain is registered
+  {
+    const system_code sc = getaddrinfo_code(EAI_NONAME);
+    CHECK(compact_code(sc).empty());
+    CHECK(compact_code_domain_registry::index_of<_getaddrinfo_code_domain>() != 0);
+    const compact_code c(sc);
+    CHECK(!c.empty());
+    CHECK(c == errc::no_such_device_or_address);
+    CHECK(c.to_system_code().strictly_equivalent(sc));
+
+    // Nested codes are never registered
+    const system_code nested = make_nested_status_code(generic_code(errc::permission_denied));
+    CHECK(compact_code(nested).empty());
+  }
+
+  // Large arrays, which is what compact codes are for
+  {
+    std::vector<compact_code> codes(1000, posix_code(EAGAIN));
+    codes[500] = http_status_code(404);
+    size_t n = 0;
+    for(const auto &c : codes)
+    {
+      n += (c == errc::resource_unavailable_try_again);
+    }
+    CHECK(n == 999);
+  }
+  return retcode;
+}
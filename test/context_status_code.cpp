@@ -0,0 +1,121 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/context_status_code.hpp"
+#include "status-code/posix_code.hpp"
+#include "status-code/system_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+int main()
+{
+  using namespace SYSTEM_ERROR2_NAMESPACE;
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+  char buffer[SYSTEM_ERROR2_CONTEXT_RING_TEXT];
+
+  auto c1 = make_context_status_code(posix_code(ENOENT), "/etc/does/not/exist");
+  static_assert(traits::is_move_bitcopying<decltype(c1)::value_type>::value, "context handle is not trivially copyable");
+  system_code sc = c1;
+  CHECK(sc.failure());
+  CHECK(sc == errc::no_such_file_or_directory);
+  CHECK(sc != errc::permission_denied);
+  CHECK(sc == posix_code(ENOENT));
+  CHECK(0 == strcmp(sc.domain().name().c_str(), posix_code_domain.name().c_str()));
+  CHECK(get_context<posix_code>(sc, buffer));
+  CHECK(0 == strcmp(buffer, "/etc/does/not/exist"));
+  CHECK(!get_context<posix_code>(posix_code(ENOENT), buffer));
+  auto msg = sc.message();
+  printf("%s\n", msg.c_str());
+  CHECK(strstr(msg.c_str(), posix_code(ENOENT).message().c_str()) == msg.c_str());
+  CHECK(strstr(msg.c_str(), "[context: /etc/does/not/exist]") != nullptr);
+  {
+    char msgbuffer[256];
+    CHECK(sc.message_into(msgbuffer, sizeof(msgbuffer)) == msg.size());
+    CHECK(0 == strcmp(msgbuffer, msg.c_str()));
+  }
+
+  // Overlong context is truncated
+  {
+    char longctx[SYSTEM_ERROR2_CONTEXT_RING_TEXT * 2];
+    memset(longctx, 'x', sizeof(longctx) - 1);
+    longctx[sizeof(longctx) - 1] = 0;
+    auto c = make_context_status_code(posix_code(EIO), longctx);
+    CHECK(get_context<posix_code>(c, buffer));
+    CHECK(strlen(buffer) == SYSTEM_ERROR2_CONTEXT_RING_TEXT - 1);
+  }
+
+  // Wrapping the ring invalidates the oldest context
+  for(int n = 0; n < SYSTEM_ERROR2_CONTEXT_RING_SLOTS; n++)
+  {
+    (void) make_context_status_code(posix_code(EIO), "filler");
+  }
+  CHECK(!get_context<posix_code>(sc, buffer));
+  msg = sc.message();
+  printf("%s\n", msg.c_str());
+  CHECK(strstr(msg.c_str(), "[context: overwritten]") != nullptr);
+  CHECK(sc == errc::no_such_file_or_directory);
+
+  // Rewriting a slot 65536 times does not make an old handle valid again
+  {
+    auto c = make_context_status_code(posix_code(EIO), "before wrap");
+    for(int n = 0; n < 65536 * SYSTEM_ERROR2_CONTEXT_RING_SLOTS; n++)
+    {
+      (void) make_context_status_code(posix_code(EIO), "after wrap");
+    }
+    CHECK(!get_context<posix_code>(c, buffer));
+    auto d = make_context_status_code(posix_code(EIO), "latest");
+    CHECK(get_context<posix_code>(d, buffer));
+    CHECK(0 == strcmp(buffer, "latest"));
+  }
+
+  // Context made by an exited thread remains readable until its ring is reused
+  system_code fromthread;
+  std::thread([&] { fromthread = make_context_status_code(posix_code(EACCES), "request 42"); }).join();
+  CHECK(get_context<posix_code>(fromthread, buffer));
+  CHECK(0 == strcmp(buffer, "request 42"));
+  std::thread(
+  []
+  {
+    for(int n = 0; n < SYSTEM_ERROR2_CONTEXT_RING_SLOTS; n++)
+    {
+      (void) make_context_status_code(posix_code(EIO), "filler");
+    }
+  })
+  .join();
+  CHECK(!get_context<posix_code>(fromthread, buffer));
+  CHECK(fromthread == errc::permission_denied);
+  return retcode;
+}
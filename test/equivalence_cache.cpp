@@ -0,0 +1,107 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/equivalence_cache.hpp"
+#include "status-code/nested_status_code.hpp"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static bool would_block(const system_code &sc) { return SYSTEM_ERROR2_ERRC_EQUIVALENT(sc, errc::resource_unavailable_try_again); }
+static bool timed_out(const system_code &sc) { return SYSTEM_ERROR2_ERRC_EQUIVALENT(sc, errc::timed_out); }
+
+int main()
+{
+  int retcode = 0;
+  // Nested codes are compared through a pointer, so must never be cached
+  system_code nested1(make_nested_status_code(generic_code(errc::resource_unavailable_try_again)));
+  system_code nested2(make_nested_status_code(generic_code(errc::timed_out)));
+  const system_code *codes[] = {
+  new system_code,
+  new system_code(generic_code(errc::success)),
+  new system_code(generic_code(errc::resource_unavailable_try_again)),
+  new system_code(generic_code(errc::timed_out)),
+  new system_code(generic_code(errc::unknown)),
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  new system_code(posix_code(0)),
+  new system_code(posix_code(EAGAIN)),
+  new system_code(posix_code(ETIMEDOUT)),
+  new system_code(posix_code(EINTR)),
+#endif
+  &nested1,
+  &nested2,
+  };
+  const size_t count = sizeof(codes) / sizeof(codes[0]);
+
+  // The cached answers agree with equivalent(), however often and in whatever order they are asked for
+  for(int round = 0; round < 3; round++)
+  {
+    for(size_t n = 0; n < count; n++)
+    {
+      const system_code &sc = *codes[(n * 7 + static_cast<size_t>(round)) % count];
+      CHECK(would_block(sc) == (sc == errc::resource_unavailable_try_again));
+      CHECK(timed_out(sc) == (sc == errc::timed_out));
+    }
+  }
+
+  // And also when many threads race to fill the same caches
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for(size_t t = 0; t < failures.size(); t++)
+  {
+    threads.emplace_back([&, t] {
+      for(size_t n = 0; n < 100000; n++)
+      {
+        const system_code &sc = *codes[(n * 13 + t) % count];
+        if(would_block(sc) != (sc == errc::resource_unavailable_try_again) || timed_out(sc) != (sc == errc::timed_out))
+        {
+          failures[t]++;
+        }
+      }
+    });
+  }
+  for(auto &thread : threads)
+  {
+    thread.join();
+  }
+  for(int f : failures)
+  {
+    CHECK(f == 0);
+  }
+  for(size_t n = 0; n < count - 2; n++)
+  {
+    delete codes[n];
+  }
+  return retcode;
+}
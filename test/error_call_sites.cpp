@@ -0,0 +1,101 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/error_call_sites.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+#include <thread>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_CALL_SITES, "This test requires SYSTEM_ERROR2_CALL_SITES to be enabled");
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static SYSTEM_ERROR2_NOINLINE error fail_here()
+{
+  return error(posix_code(ENOENT));
+}
+static SYSTEM_ERROR2_NOINLINE error fail_there()
+{
+  return error(posix_code(EACCES));
+}
+
+int main()
+{
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+  error_call_site sites[8];
+  reset_error_call_sites();
+  CHECK(top_error_call_sites(sites, 8) == 0);
+
+  for(int n = 0; n < 3; n++)
+  {
+    (void) fail_here();
+  }
+  std::thread(
+  []
+  {
+    for(int n = 0; n < 5; n++)
+    {
+      (void) fail_there();
+    }
+    (void) fail_here();
+  })
+  .join();
+  size_t count = top_error_call_sites(sites, 8);
+  unsigned long long total = 0;
+  for(size_t n = 0; n < count; n++)
+  {
+    printf("%p: %llu\n", sites[n].address, sites[n].count);
+    total += sites[n].count;
+    if(n > 0)
+    {
+      CHECK(sites[n - 1].count >= sites[n].count);
+    }
+  }
+  CHECK(total == 9);
+#ifdef __OPTIMIZE__
+  // The errored status code constructors are inlined into each call site
+  CHECK(count == 2);
+  CHECK(sites[0].count == 5);
+  CHECK(sites[1].count == 4);
+  CHECK(sites[0].address != sites[1].address);
+#endif
+  CHECK(top_error_call_sites(sites, 1) == 1);
+  CHECK(sites[0].count >= 5);
+  CHECK(error_call_sites_dropped() == 0);
+
+  reset_error_call_sites();
+  CHECK(top_error_call_sites(sites, 8) == 0);
+  return retcode;
+}
@@ -0,0 +1,134 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/error_counters.hpp"
+#include "status-code/posix_code.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_ERROR_COUNTERS, "This test requires SYSTEM_ERROR2_ERROR_COUNTERS to be enabled");
+
+int main()
+{
+  using namespace SYSTEM_ERROR2_NAMESPACE;
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+  auto count_of = [](const status_code_domain &domain, long long value, error_event event) -> unsigned long long
+  {
+    error_counter counters[64];
+    size_t n = snapshot_error_counters(counters, 64);
+    for(size_t i = 0; i < n && i < 64; i++)
+    {
+      if(*counters[i].domain == domain && counters[i].value == value && counters[i].event == event)
+      {
+        return counters[i].count;
+      }
+    }
+    return 0;
+  };
+
+  reset_error_counters();
+  {
+    error e1(posix_code(ENOENT));
+    errored_status_code<_posix_code_domain> e2(ENOENT);
+    error e3(std::move(e2));  // already counted
+    (void) e3;
+  }
+  CHECK(count_of(posix_code_domain, ENOENT, error_event::constructed) == 2);
+  CHECK(count_of(posix_code_domain, EBADF, error_event::constructed) == 0);
+  CHECK(count_of(generic_code_domain, static_cast<long long>(errc::no_such_file_or_directory), error_event::constructed) == 0);
+  {
+    error e(errc::permission_denied);
+    CHECK(count_of(generic_code_domain, static_cast<long long>(errc::permission_denied), error_event::constructed) == 1);
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS)
+    try
+    {
+      e.throw_exception();
+    }
+    catch(...)
+    {
+    }
+    try
+    {
+      posix_code(EACCES).throw_exception();
+    }
+    catch(...)
+    {
+    }
+    CHECK(count_of(generic_code_domain, static_cast<long long>(errc::permission_denied), error_event::thrown) == 1);
+    CHECK(count_of(posix_code_domain, EACCES, error_event::thrown) == 1);
+#endif
+  }
+
+  // Increments from many threads are merged
+  {
+    std::vector<std::thread> threads;
+    for(int n = 0; n < 8; n++)
+    {
+      threads.emplace_back(
+      []
+      {
+        for(int i = 0; i < 1000; i++)
+        {
+          error e(posix_code(EIO));
+          (void) e;
+        }
+      });
+    }
+    for(auto &t : threads)
+    {
+      t.join();
+    }
+  }
+  CHECK(count_of(posix_code_domain, EIO, error_event::constructed) == 8000);
+  CHECK(error_counters_dropped() == 0);
+
+  char buffer[4096];
+  size_t len = write_error_counters_prometheus(buffer, sizeof(buffer));
+  printf("%s", buffer);
+  CHECK(len == strlen(buffer));
+  char expected[128];
+  snprintf(expected, sizeof(expected), "system_error2_errors_total{domain=\"posix domain\",value=\"%d\",event=\"constructed\"} 8000\n", EIO);
+  CHECK(strstr(buffer, expected) != nullptr);
+  char small[16];
+  CHECK(write_error_counters_prometheus(small, sizeof(small)) == len);
+  CHECK(strlen(small) == sizeof(small) - 1);
+
+  reset_error_counters();
+  CHECK(count_of(posix_code_domain, EIO, error_event::constructed) == 0);
+  return retcode;
+}
@@ -0,0 +1,107 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/exact_hash.hpp"
+#include "status-code/http_status_code.hpp"
+#include "status-code/nested_status_code.hpp"
+#include "status-code/system_code.hpp"
+
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+int main()
+{
+  int retcode = 0;
+  const exact_hash hash;
+  const exact_equal equal;
+
+  // Empty codes
+  CHECK(hash(system_code()) == 0);
+  CHECK(equal(system_code(), generic_code()));
+  CHECK(!equal(system_code(), posix_code(0)));
+  CHECK(!equal(posix_code(0), system_code()));
+
+  // Typed and erased codes of the same domain and value are exactly equal, and hash the same
+  {
+    const system_code sc = posix_code(ENOENT);
+    CHECK(equal(sc, posix_code(ENOENT)));
+    CHECK(hash(sc) == hash(posix_code(ENOENT)));
+    CHECK(!equal(sc, posix_code(EACCES)));
+    // Negative values are sign extended when erased, but only the payload is hashed
+    const system_code unknown = generic_code(errc::unknown);
+    CHECK(equal(unknown, generic_code(errc::unknown)));
+    CHECK(hash(unknown) == hash(generic_code(errc::unknown)));
+  }
+
+  // Semantically equivalent codes of different domains are not exactly equal
+  CHECK(posix_code(ENOENT) == generic_code(errc::no_such_file_or_directory));
+  CHECK(!equal(posix_code(ENOENT), generic_code(errc::no_such_file_or_directory)));
+  CHECK(http_status_code(404) == posix_code(ENOENT));
+  CHECK(!equal(http_status_code(404), posix_code(ENOENT)));
+
+  // Distinct values hash distinctly
+  {
+    std::unordered_set<size_t> hashes;
+    for(int n = 0; n < 1000; n++)
+    {
+      hashes.insert(hash(posix_code(n)));
+      hashes.insert(hash(http_status_code(n)));
+    }
+    CHECK(hashes.size() == 2000);
+  }
+
+  // Nested codes are compared by their payload, which is a pointer to the nested code
+  {
+    const system_code nested = make_nested_status_code(generic_code(errc::permission_denied));
+    const system_code copy = nested.clone();
+    CHECK(equal(nested, nested));
+    CHECK(nested == copy);
+    CHECK(!equal(nested, copy));
+  }
+
+  // Usable as the hash and equality of an unordered container
+  {
+    std::unordered_map<system_code, int, exact_hash, exact_equal> counts;
+    counts[posix_code(ENOENT)]++;
+    counts[posix_code(ENOENT)]++;
+    counts[generic_code(errc::no_such_file_or_directory)]++;
+    counts[http_status_code(404)]++;
+    counts[system_code()]++;
+    CHECK(counts.size() == 4);
+    CHECK(counts[posix_code(ENOENT)] == 2);
+    CHECK(counts[generic_code(errc::no_such_file_or_directory)] == 1);
+    CHECK(counts[system_code()] == 1);
+  }
+  return retcode;
+}
@@ -0,0 +1,114 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/format_support.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+struct payload
+{
+  int a, b;
+};
+struct payload_domain;
+using payload_code = status_code<payload_domain>;
+struct payload_domain : public status_code_domain
+{
+  using value_type = payload;
+  constexpr payload_domain() noexcept
+      : status_code_domain(0x4a3f1c0e6b2d9587)
+  {
+  }
+  static inline constexpr const payload_domain &get();
+  virtual string_ref name() const noexcept override { return string_ref("payload domain"); }
+  virtual payload_info_t payload_info() const noexcept override { return {sizeof(value_type), sizeof(payload_code), alignof(payload_code)}; }
+
+  // Public so status_code and status_error outside this namespace can call them
+  virtual bool _do_failure(const status_code<void> & /*unused*/) const noexcept override { return true; }
+  virtual bool _do_equivalent(const status_code<void> & /*unused*/, const status_code<void> & /*unused*/) const noexcept override { return false; }
+  virtual generic_code _generic_code(const status_code<void> & /*unused*/) const noexcept override { return errc::unknown; }
+  virtual string_ref _do_message(const status_code<void> & /*unused*/) const noexcept override { return string_ref("payload message"); }
+#if defined(_CPPUNWIND) || defined(__EXCEPTIONS) || defined(STANDARDESE_IS_IN_THE_HOUSE)
+  SYSTEM_ERROR2_NORETURN virtual void _do_throw_exception(const status_code<void> &code) const override
+  {
+    throw status_error<payload_domain>(static_cast<const payload_code &>(code));
+  }
+#endif
+};
+constexpr payload_domain payload_domain_instance;
+inline constexpr const payload_domain &payload_domain::get()
+{
+  return payload_domain_instance;
+}
+
+// Runs the checks for a format function, so both std::format and fmt get the same checks
+template <class Format> int check(Format &&format)
+{
+  int retcode = 0;
+  const generic_code gc(errc::permission_denied);
+  const std::string msg(gc.message().c_str());
+  CHECK(format("{:n}", gc) == "generic domain");
+  CHECK(format("{:v}", gc) == std::to_string(EACCES));
+  CHECK(format("{:m}", gc) == msg);
+  CHECK(format("{}", gc) == "generic domain: " + msg + " (" + std::to_string(EACCES) + ")");
+  CHECK(format("{:f}", gc) == format("{}", gc));
+  CHECK(format("{}", generic_code()) == "(empty)");
+
+  const system_code sc(posix_code(-5));
+  CHECK(format("{:v}", sc) == "-5");
+  CHECK(format("{:n}", sc) == "posix domain");
+  const error e(gc);
+  CHECK(format("{}", e) == format("{}", gc));
+
+  // Status codes whose value is not an integer can be formatted, but not by value
+  const payload_code pc(in_place, payload{1, 2});
+  CHECK(format("{}", pc) == "payload domain: payload message");
+
+  // string_ref formats like a string_view
+  CHECK(format("[{:>16}]", gc.domain().name()) == "[  generic domain]");
+  return retcode;
+}
+
+int main()
+{
+  int retcode = 0;
+#if SYSTEM_ERROR2_FMT
+  retcode |= check([](const char *fmt, const auto &v) { return fmt::format(fmt::runtime(fmt), v); });
+#endif
+#if SYSTEM_ERROR2_HAVE_STD_FORMAT
+  retcode |= check([](const char *fmt, const auto &v) { return std::vformat(fmt, std::make_format_args(v)); });
+#endif
+  return retcode;
+}
@@ -0,0 +1,116 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static size_t parse(http_status_code &code, const char *line) { return parse_http_status_line(code, line, strlen(line)); }
+
+int main()
+{
+  int retcode = 0;
+
+  // The tables agree with the classes, messages and mappings of the codes
+  for(int n = -5; n < 700; n++)
+  {
+    const http_status_code c(n);
+    CHECK(c.is_http_informational() == (n >= 100 && n < 200));
+    CHECK(c.is_http_success() == (n >= 200 && n < 300));
+    CHECK(c.is_http_redirection() == (n >= 300 && n < 400));
+    CHECK(c.is_http_client_error() == (n >= 400 && n < 500));
+    CHECK(c.is_http_server_error() == (n >= 500 && n < 600));
+    CHECK(c.message().size() == strlen(c.message().c_str()));
+  }
+  CHECK(0 == strcmp(http_status_code(200).message().c_str(), "OK"));
+  CHECK(0 == strcmp(http_status_code(418).message().c_str(), "I'm a teapot"));
+  CHECK(0 == strcmp(http_status_code(511).message().c_str(), "Network Authentication Required"));
+  CHECK(0 == strcmp(http_status_code(299).message().c_str(), "Unknown"));
+  CHECK(0 == strcmp(http_status_code(99).message().c_str(), "Unknown"));
+  CHECK(0 == strcmp(http_status_code(600).message().c_str(), "Unknown"));
+  CHECK(http_status_code(404) == errc::no_such_file_or_directory);
+  CHECK(http_status_code(410) == errc::no_such_file_or_directory);
+  CHECK(http_status_code(504) == errc::timed_out);
+  CHECK(http_status_code(202) == errc::operation_in_progress);
+  CHECK(http_status_code(200) != errc::operation_in_progress);
+  CHECK(http_status_code(500) != errc::timed_out);
+#if __cplusplus >= 201402L
+  static_assert(detail::http_status_lookup(404).message_length == 9, "");
+#endif
+
+  // Well formed status lines
+  http_status_code code;
+  CHECK(parse(code, "HTTP/1.1 404 Not Found\r\nServer: x\r\n") == 24);
+  CHECK(code.value() == 404);
+  CHECK(parse(code, "HTTP/1.0 200 OK\n") == 16);
+  CHECK(code.value() == 200);
+  CHECK(parse(code, "HTTP/1.1 204\r\n") == 14);
+  CHECK(code.value() == 204);
+  CHECK(parse(code, "HTTP/1.1 599 \n") == 14);
+  CHECK(code.value() == 599);
+
+  // Malformed or incomplete status lines leave the code alone
+  code = http_status_code(100);
+  CHECK(parse(code, "HTTP/1.1 404 Not Found") == 0);
+  CHECK(parse(code, "HTTP/1.2 404 Not Found\r\n") == 0);
+  CHECK(parse(code, "HTTP/2 404 Not Found\r\n") == 0);
+  CHECK(parse(code, "http/1.1 404 Not Found\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 4x4 Not Found\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 4:4 Not Found\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 600 Nope\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 099 Nope\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 2000 OK\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1  200 OK\r\n") == 0);
+  CHECK(parse(code, "HTTP/1.1 200") == 0);
+  CHECK(parse(code, "") == 0);
+  CHECK(code.value() == 100);
+
+  // Batches of status lines
+  {
+    static constexpr const char lines[] = "HTTP/1.1 200 OK\r\n"
+                                          "HTTP/1.1 301 Moved Permanently\r\n"
+                                          "garbage\r\n"
+                                          "HTTP/1.0 503 Service Unavailable\n"
+                                          "HTTP/1.1 404 Not";
+    http_status_code codes[8];
+    CHECK(parse_http_status_lines(codes, 8, lines, sizeof(lines) - 1) == 4);
+    CHECK(codes[0].value() == 200);
+    CHECK(codes[1].value() == 301);
+    CHECK(codes[2].empty());
+    CHECK(codes[3].value() == 503);
+    CHECK(codes[4].empty());
+    CHECK(parse_http_status_lines(codes, 2, lines, sizeof(lines) - 1) == 2);
+  }
+  return retcode;
+}
@@ -0,0 +1,120 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/instrumentation.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_INSTRUMENT, "This test requires SYSTEM_ERROR2_INSTRUMENT to be enabled");
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static domain_operation_stats stats_of(const status_code_domain &domain)
+{
+  domain_operation_stats stats[32];
+  size_t n = snapshot_domain_operations(stats, 32);
+  for(size_t i = 0; i < n && i < 32; i++)
+  {
+    if(*stats[i].domain == domain)
+    {
+      return stats[i];
+    }
+  }
+  return {};
+}
+static equivalence_stage_stats stages_of(const status_code_domain &first, const status_code_domain &second)
+{
+  equivalence_stage_stats stats[32];
+  size_t n = snapshot_equivalence_stages(stats, 32);
+  for(size_t i = 0; i < n && i < 32; i++)
+  {
+    if(*stats[i].first == first && *stats[i].second == second)
+    {
+      return stats[i];
+    }
+  }
+  return {};
+}
+static unsigned long long calls(const status_code_domain &domain, domain_operation op)
+{
+  return stats_of(domain).calls[static_cast<size_t>(op)];
+}
+static unsigned long long answers(const status_code_domain &first, const status_code_domain &second, equivalence_stage stage)
+{
+  return stages_of(first, second).answers[static_cast<size_t>(stage)];
+}
+
+int main()
+{
+  int retcode = 0;
+#ifdef _MSC_VER
+  _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+#endif
+  reset_instrumentation();
+  posix_code c(ENOENT);
+  CHECK(c.failure());
+  CHECK(!c.success());
+  CHECK(calls(posix_code_domain, domain_operation::failure) == 2);
+  (void) c.message();
+  CHECK(calls(posix_code_domain, domain_operation::message) == 1);
+  {
+    char buffer[64];
+    (void) c.message_into(buffer, sizeof(buffer));
+  }
+  CHECK(calls(posix_code_domain, domain_operation::message_into) == 1);
+  CHECK(calls(posix_code_domain, domain_operation::message) == 1);
+
+  // posix knows about generic, but generic does not know about posix
+  CHECK(c == errc::no_such_file_or_directory);
+  CHECK(answers(posix_code_domain, generic_code_domain, equivalence_stage::forward) == 1);
+  CHECK(generic_code(errc::no_such_file_or_directory) == c);
+  CHECK(answers(generic_code_domain, posix_code_domain, equivalence_stage::reverse) == 1);
+  CHECK(c != posix_code(EACCES));
+  CHECK(answers(posix_code_domain, posix_code_domain, equivalence_stage::none) == 1);
+  CHECK(calls(posix_code_domain, domain_operation::generic_code) == 2);
+  CHECK(calls(generic_code_domain, domain_operation::equivalent) == 1);
+
+  {
+    system_code sc(c);
+    system_code sc2(sc.clone());
+    CHECK(calls(posix_code_domain, domain_operation::erased_copy) == 1);
+  }
+  CHECK(calls(posix_code_domain, domain_operation::erased_destroy) == 2);
+#if SYSTEM_ERROR2_INSTRUMENT_TIMING
+  CHECK(stats_of(posix_code_domain).cycles[static_cast<size_t>(domain_operation::message)] > 0);
+#endif
+
+  reset_instrumentation();
+  CHECK(calls(posix_code_domain, domain_operation::failure) == 0);
+  CHECK(answers(posix_code_domain, generic_code_domain, equivalence_stage::forward) == 0);
+  return retcode;
+}
@@ -42,6 +42,11 @@ http://www.boost.org/LICENSE_1_0.txt)
 #include <iostream>
 #include <memory>
 #include <string>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#endif
 
 #ifdef _MSC_VER
 #define strdup _strdup
@@ -54,6 +59,22 @@ http://www.boost.org/LICENSE_1_0.txt)
     retcode = 1;                                                                                                                                               \
   }
 
+// A memory resource which counts its outstanding allocations
+struct counting_resource
+{
+  int outstanding{0};
+  void *allocate(size_t bytes, size_t /*unused*/)
+  {
+    ++outstanding;
+    return malloc(bytes);
+  }
+  void deallocate(void *p, size_t /*unused*/, size_t /*unused*/)
+  {
+    --outstanding;
+    free(p);
+  }
+};
+
 // An error coding with multiple success values
 enum class Code : size_t
 {
@@ -708,6 +729,208 @@ int main()
         }());
 #endif
 
+  // Test message_into() agrees with message(), and truncates like snprintf()
+  {
+    char buffer[1024];
+    const system_code generic(failure1);
+    CHECK(generic.message_into(buffer, sizeof(buffer)) == generic.message().size());
+    CHECK(0 == strcmp(buffer, generic.message().c_str()));
+    CHECK(generic.message_into(buffer, 5) == generic.message().size());
+    CHECK(strlen(buffer) == 4 && 0 == strncmp(buffer, generic.message().c_str(), 4));
+    CHECK(generic.message_into(nullptr, 0) == generic.message().size());
+    CHECK(system_code().message_into(buffer, sizeof(buffer)) == 7 && 0 == strcmp(buffer, "(empty)"));
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    CHECK(failure9.message_into(buffer, sizeof(buffer)) == failure9.message().size());
+    CHECK(0 == strcmp(buffer, failure9.message().c_str()));
+    CHECK(failure11.message_into(buffer, sizeof(buffer)) == failure11.message().size());
+    CHECK(0 == strcmp(buffer, failure11.message().c_str()));
+#endif
+    const std_error_code stdec(std::make_error_code(std::errc::permission_denied));
+    CHECK(stdec.message_into(buffer, sizeof(buffer)) == stdec.message().size());
+    CHECK(0 == strcmp(buffer, stdec.message().c_str()));
+  }
+
+  // Test thread local messages copy and share correctly
+  {
+    using local_string_ref = status_code_domain::local_refcounted_string_ref;
+    local_string_ref local(strdup("thread local message"));
+    status_code_domain::string_ref copy1(local), copy2(copy1);
+    CHECK(copy1.data() == local.data() && copy2.data() == local.data());
+    auto shared = local.share();
+    CHECK(shared.data() != local.data());
+    CHECK(0 == strcmp(shared.c_str(), "thread local message"));
+    local_string_ref sole(strdup("sole message"));
+    const char *text = sole.data();
+    auto stolen = std::move(sole).share();
+    CHECK(stolen.data() == text);
+    CHECK(0 == strcmp(stolen.c_str(), "sole message"));
+  }
+
+  // Test messages allocated from a memory resource are released back to it
+  {
+    counting_resource resource;
+    {
+      const system_code generic(failure1);
+      auto msg = generic.message(resource);
+      CHECK(resource.outstanding == 1);
+      CHECK(0 == strcmp(msg.c_str(), generic.message().c_str()));
+      auto msg2(msg);
+      auto msg3(std::move(msg));
+      CHECK(resource.outstanding == 1);
+      CHECK(0 == strcmp(msg2.c_str(), msg3.c_str()));
+      auto typed = failure1.message(resource);
+      CHECK(resource.outstanding == 2);
+    }
+    CHECK(resource.outstanding == 0);
+#if defined(__cpp_lib_memory_resource) && __cpp_lib_memory_resource >= 201603L
+    char arena[1024];
+    std::pmr::monotonic_buffer_resource monotonic(arena, sizeof(arena), std::pmr::null_memory_resource());
+    auto msg = failure1.message(monotonic);
+    CHECK(msg.data() >= arena && msg.data() < arena + sizeof(arena));
+    CHECK(0 == strcmp(msg.c_str(), failure1.message().c_str()));
+#endif
+  }
+
+  // Test the dense generic code table, and its reverse lookups
+  {
+    for(int n = -2; n < 300; n++)
+    {
+      auto msg = generic_code(static_cast<errc>(n)).message();
+      CHECK(msg.size() == strlen(msg.c_str()));
+    }
+    CHECK(0 == strcmp(generic_code(errc::timed_out).message().c_str(), "Connection timed out"));
+    CHECK(0 == strcmp(generic_code(errc::unknown).message().c_str(), "unknown"));
+    CHECK(0 == strcmp(generic_code(static_cast<errc>(100000)).message().c_str(), "unknown"));
+    CHECK(errc_from_name("timed_out") == errc::timed_out);
+    CHECK(errc_from_name("success") == errc::success);
+    CHECK(errc_from_name("address_family_not_supported") == errc::address_family_not_supported);
+    CHECK(errc_from_name("wrong_protocol_type") == errc::wrong_protocol_type);
+    CHECK(errc_from_name("timed_outx", 9) == errc::timed_out);
+    CHECK(errc_from_name("timed") == errc::unknown);
+    CHECK(errc_from_name("zzz") == errc::unknown);
+    CHECK(errc_from_message("Connection timed out") == errc::timed_out);
+    CHECK(errc_from_message("Success") == errc::success);
+    CHECK(errc_from_message("unknown") == errc::unknown);
+    CHECK(errc_from_message("No such file or directory") == errc::no_such_file_or_directory);
+    CHECK(errc_from_message("Connection timed outx", 20) == errc::timed_out);
+    CHECK(errc_from_message("Connection") == errc::unknown);
+    CHECK(errc_from_message("") == errc::unknown);
+    for(int n = 0; n < 4096; n++)
+    {
+      const generic_code c(static_cast<errc>(n));
+      const auto msg = c.message();
+      if(0 != strcmp(msg.c_str(), "unknown"))
+      {
+        const errc e = errc_from_message(msg.c_str());
+        CHECK(static_cast<int>(e) <= n && 0 == strcmp(generic_code(e).message().c_str(), msg.c_str()));
+      }
+    }
+    const generic_code codes[] = {errc::permission_denied, errc::success, static_cast<errc>(-7), errc::io_error};
+    const char *messages[4];
+    size_t lengths[4];
+    generic_code_messages(codes, 4, messages, lengths);
+    for(size_t n = 0; n < 4; n++)
+    {
+      CHECK(0 == strcmp(messages[n], codes[n].message().c_str()) && lengths[n] == strlen(messages[n]));
+    }
+#if __cplusplus >= 201402L
+    static_assert(detail::generic_code_lookup(errc::no_such_file_or_directory).message_length == 25, "");
+#endif
+  }
+
+  // Test that typed comparisons resolved by equivalence_traits agree with equivalent()
+  {
+    using another_code = quick_status_code_from_enum_code<another_namespace::AnotherCode>;
+    static_assert(detail::has_equivalence_traits<_generic_code_domain, _generic_code_domain>::value, "");
+    static_assert(detail::has_equivalence_traits<another_code::domain_type, _generic_code_domain>::value, "");
+    static_assert(!detail::has_equivalence_traits<_generic_code_domain, another_code::domain_type>::value, "");
+    const generic_code generics[] = {generic_code(), errc::success, errc::permission_denied, errc::timed_out, errc::unknown};
+    const another_code anothers[] = {another_code(), another_namespace::AnotherCode::success1, another_namespace::AnotherCode::goaway,
+                                     another_namespace::AnotherCode::success2, another_namespace::AnotherCode::error2};
+    for(const auto &a : generics)
+    {
+      for(const auto &b : generics)
+      {
+        CHECK((a == b) == a.equivalent(b));
+      }
+      for(const auto &b : anothers)
+      {
+        CHECK((a == b) == a.equivalent(b));
+        CHECK((b == a) == b.equivalent(a));
+        CHECK((b != a) != b.equivalent(a));
+      }
+    }
+    for(const auto &a : anothers)
+    {
+      for(const auto &b : anothers)
+      {
+        CHECK((a == b) == a.equivalent(b));
+      }
+    }
+    CHECK(another_code(another_namespace::AnotherCode::success1) == another_code(another_namespace::AnotherCode::success2));
+    CHECK(another_code(another_namespace::AnotherCode::goaway) == errc::permission_denied);
+    CHECK(errc::permission_denied == another_code(another_namespace::AnotherCode::goaway));
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    const posix_code posixes[] = {posix_code(), posix_code(0), posix_code(EACCES), posix_code(ETIMEDOUT), posix_code(-1)};
+    for(const auto &a : posixes)
+    {
+      for(const auto &b : posixes)
+      {
+        CHECK((a == b) == a.equivalent(b));
+      }
+      for(const auto &b : generics)
+      {
+        CHECK((a == b) == a.equivalent(b));
+        CHECK((b == a) == b.equivalent(a));
+      }
+      for(const auto &b : anothers)
+      {
+        CHECK((a == b) == a.equivalent(b));
+        CHECK((b == a) == b.equivalent(a));
+      }
+    }
+    CHECK(posix_code(EACCES) == errc::permission_denied);
+    CHECK(posix_code(EACCES) == another_code(another_namespace::AnotherCode::goaway));
+#endif
+  }
+
+  // Test matching codes against sets of errc values
+  {
+    using another_code = quick_status_code_from_enum_code<another_namespace::AnotherCode>;
+    static_assert(errc_sets::transient.contains(errc::timed_out), "");
+    static_assert(!errc_sets::transient.contains(errc::unknown), "");
+    static_assert((errc_sets::transient & errc_sets::permission).empty(), "");
+    static_assert((errc_sets::not_found | errc_sets::permission).contains(errc::permission_denied), "");
+    const generic_code generic_timed_out(errc::timed_out);
+    const StatusCode goaway(Code::goaway), success2(Code::success2);
+    const another_code another_goaway(another_namespace::AnotherCode::goaway);
+    const system_code nested(make_nested_status_code(generic_code(errc::no_such_file_or_directory)));
+    const generic_code empty;
+    const status_code<void> *codes[] = {&generic_timed_out, &goaway, &success2, &another_goaway, &nested, &empty};
+    const errc_set sets[] = {errc_sets::transient, errc_sets::not_found, errc_sets::permission, errc_set(errc::operation_not_permitted),
+                             errc_set(errc::success), errc_set()};
+    for(const auto *code : codes)
+    {
+      for(const auto &set : sets)
+      {
+        bool expected = false;
+        for(int n = 0; n <= detail::generic_code_max_value(); n++)
+        {
+          expected |= set.contains(static_cast<errc>(n)) && *code == generic_code(static_cast<errc>(n));
+        }
+        CHECK(code->matches(set) == expected);
+      }
+    }
+    CHECK(goaway.matches(errc_set(errc::operation_not_permitted)));  // only via _do_equivalent()
+    CHECK(classify(generic_timed_out, {errc_sets::not_found, errc_sets::permission, errc_sets::transient}) == 2);
+    CHECK(classify(nested, {errc_sets::not_found, errc_sets::permission, errc_sets::transient}) == 0);
+    CHECK(classify(goaway, {errc_sets::not_found, errc_sets::transient}) == 2);
+    CHECK(classify(empty, {errc_sets::not_found, errc_sets::transient}) == 2);
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    CHECK(classify(posix_code(EINTR), {errc_sets::not_found, errc_sets::transient}) == 1);
+#endif
+  }
+
   printf("\nExiting tests with code %d\n", retcode);
   return retcode;
 }
\ No newline at end of file
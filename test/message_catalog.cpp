@@ -0,0 +1,165 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/message_catalog.hpp"
+#include "status-code/posix_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_MESSAGE_CATALOGS, "This test requires SYSTEM_ERROR2_MESSAGE_CATALOGS to be enabled");
+
+enum class Code : int
+{
+  success,
+  goaway,
+  unlocalised
+};
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+template <> struct quick_status_code_from_enum<Code> : quick_status_code_from_enum_defaults<Code>
+{
+  static constexpr const auto domain_name = "Code";
+  static constexpr const auto domain_uuid = "{7e3b60f0-4c1d-2d8a-91f5-0b3c7a9d1e42}";
+  static const std::initializer_list<mapping> &value_mappings()
+  {
+    static const std::initializer_list<mapping> v = {
+    {Code::success, "Success", {errc::success}},                 //
+    {Code::goaway, "Go away", {errc::permission_denied}},        //
+    {Code::unlocalised, "Unlocalised", {errc::invalid_argument}}  //
+    };
+    return v;
+  }
+};
+SYSTEM_ERROR2_NAMESPACE_END
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static std::vector<char> read_file(const char *path)
+{
+  std::vector<char> ret;
+  FILE *f = fopen(path, "rb");
+  if(f != nullptr)
+  {
+    char buffer[4096];
+    for(size_t bytes; (bytes = fread(buffer, 1, sizeof(buffer), f)) > 0;)
+    {
+      ret.insert(ret.end(), buffer, buffer + bytes);
+    }
+    fclose(f);
+  }
+  return ret;
+}
+
+int main()
+{
+  int retcode = 0;
+  {
+    FILE *f = fopen("message_catalog_test.txt", "wb");
+    fputs("# Test catalog\n"
+          "domain posix\n"
+          "2 Aucun fichier ou dossier de ce type\n"
+          "13 Permission refus\xc3\xa9"
+          "e\n"
+          "\n"
+          "domain {7e3b60f0-4c1d-2d8a-91f5-0b3c7a9d1e42}\n"
+          "1   Va-t'en\\ntout de suite\n",
+          f);
+    fclose(f);
+  }
+  CHECK(0 == system(MESSAGE_CATALOG_COMPILER " message_catalog_test.txt message_catalog_test.bin"));
+
+  message_catalog catalog;
+  CHECK(catalog.empty());
+  CHECK(catalog.open("message_catalog_does_not_exist.bin") == errc::no_such_file_or_directory);
+  CHECK(catalog.open("message_catalog_test.txt") == errc::bad_message);
+  CHECK(catalog.empty());
+  CHECK(catalog.open("message_catalog_test.bin").success());
+  CHECK(catalog.size() == 3);
+
+  size_t length = 0;
+  const char *msg = catalog.find(posix_code(ENOENT).domain().id(), ENOENT, length);
+  CHECK(msg != nullptr && length == strlen(msg) && 0 == strcmp(msg, "Aucun fichier ou dossier de ce type"));
+  CHECK(catalog.find(posix_code(ENOENT).domain().id(), EINVAL, length) == nullptr);
+  CHECK(catalog.find(generic_code(errc::no_such_file_or_directory).domain().id(), ENOENT, length) == nullptr);
+
+  // Not installed, so domains use their own messages
+  CHECK(0 != strcmp(posix_code(ENOENT).message().c_str(), "Aucun fichier ou dossier de ce type"));
+  CHECK(0 == strcmp(quick_status_code_from_enum_code<Code>(Code::goaway).message().c_str(), "Go away"));
+
+  install_message_catalog(&catalog);
+  CHECK(installed_message_catalog() == &catalog);
+  {
+    auto m = posix_code(ENOENT).message();
+    CHECK(0 == strcmp(m.c_str(), "Aucun fichier ou dossier de ce type"));
+    // Messages point straight into the mapping
+    CHECK(m.c_str() == msg);
+    CHECK(0 == strcmp(posix_code(EACCES).message().c_str(), "Permission refus\xc3\xa9"
+                                                             "e"));
+    char buffer[64];
+    CHECK(posix_code(ENOENT).message_into(buffer, sizeof(buffer)) == strlen("Aucun fichier ou dossier de ce type"));
+    CHECK(0 == strcmp(buffer, "Aucun fichier ou dossier de ce type"));
+    CHECK(0 == strcmp(quick_status_code_from_enum_code<Code>(Code::goaway).message().c_str(), "Va-t'en\ntout de suite"));
+    // Messages absent from the catalog fall back
+    CHECK(0 == strcmp(quick_status_code_from_enum_code<Code>(Code::unlocalised).message().c_str(), "Unlocalised"));
+    CHECK(posix_code(EINVAL).message().size() > 0);
+  }
+
+  // Catalogs can also be constructed over memory
+  {
+    std::vector<char> image = read_file("message_catalog_test.bin");
+    message_catalog view(image.data(), image.size());
+    CHECK(view.size() == 3);
+    const char *p = view.find(posix_code(ENOENT).domain().id(), ENOENT, length);
+    CHECK(p > image.data() && p < image.data() + image.size());
+    CHECK(nullptr != view.find(posix_code(EACCES).domain().id(), EACCES, length));
+    // Truncated and corrupted catalogs are rejected
+    message_catalog truncated(image.data(), 16);
+    CHECK(truncated.empty());
+    image[0] = 'X';
+    message_catalog corrupted(image.data(), image.size());
+    CHECK(corrupted.empty());
+  }
+
+  // Moving keeps the mapping alive
+  message_catalog moved(static_cast<message_catalog &&>(catalog));
+  CHECK(catalog.empty());
+  CHECK(moved.size() == 3);
+  install_message_catalog(&moved);
+  CHECK(0 == strcmp(posix_code(ENOENT).message().c_str(), "Aucun fichier ou dossier de ce type"));
+  install_message_catalog(nullptr);
+  CHECK(0 != strcmp(posix_code(ENOENT).message().c_str(), "Aucun fichier ou dossier de ce type"));
+
+  remove("message_catalog_test.txt");
+  remove("message_catalog_test.bin");
+  return retcode;
+}
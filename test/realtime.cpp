@@ -0,0 +1,239 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#define SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS 4
+
+#include "status-code/chained_status_code.hpp"
+#include "status-code/context_status_code.hpp"
+#include "status-code/nested_status_code.hpp"
+#include "status-code/std_error_code.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_REALTIME, "This test requires SYSTEM_ERROR2_REALTIME to be enabled");
+
+#if defined(__linux__) && defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// Interpose the allocator and mutex, counting calls made while counting is enabled
+static std::atomic<bool> counting(false);
+static std::atomic<unsigned> allocations(0), locks(0);
+
+extern "C"
+{
+  extern void *__libc_malloc(size_t);
+  extern void *__libc_calloc(size_t, size_t);
+  extern void *__libc_realloc(void *, size_t);
+  extern void *__libc_memalign(size_t, size_t);
+  extern void __libc_free(void *);
+
+  static void count_allocation()
+  {
+    if(counting.load(std::memory_order_relaxed))
+    {
+      allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void *malloc(size_t size)
+  {
+    count_allocation();
+    return __libc_malloc(size);
+  }
+  void *calloc(size_t count, size_t size)
+  {
+    count_allocation();
+    return __libc_calloc(count, size);
+  }
+  void *realloc(void *p, size_t size)
+  {
+    count_allocation();
+    return __libc_realloc(p, size);
+  }
+  void *memalign(size_t alignment, size_t size)
+  {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+  }
+  void *aligned_alloc(size_t alignment, size_t size)
+  {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+  }
+  int posix_memalign(void **p, size_t alignment, size_t size)
+  {
+    count_allocation();
+    *p = __libc_memalign(alignment, size);
+    return (*p == nullptr) ? ENOMEM : 0;
+  }
+  void free(void *p) { __libc_free(p); }
+
+  int pthread_mutex_lock(pthread_mutex_t *mutex)
+  {
+    using real_type = int (*)(pthread_mutex_t *);
+    static real_type real = reinterpret_cast<real_type>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));  // NOLINT
+    if(counting.load(std::memory_order_relaxed))
+    {
+      locks.fetch_add(1, std::memory_order_relaxed);
+    }
+    return real(mutex);
+  }
+}
+
+// Allocates from a static arena, and never frees
+alignas(16) static char arena[4096];
+static std::atomic<size_t> arena_used(0);
+template <class T> struct arena_allocator
+{
+  using value_type = T;
+  arena_allocator() = default;
+  template <class U> arena_allocator(const arena_allocator<U> & /*unused*/) noexcept {}
+  T *allocate(size_t n) noexcept
+  {
+    const size_t bytes = (n * sizeof(T) + 15) & ~static_cast<size_t>(15);
+    const size_t offset = arena_used.fetch_add(bytes, std::memory_order_relaxed);
+    return (offset + bytes <= sizeof(arena)) ? reinterpret_cast<T *>(arena + offset) : nullptr;  // NOLINT
+  }
+  void deallocate(T * /*unused*/, size_t /*unused*/) noexcept {}
+  template <class U> bool operator==(const arena_allocator<U> & /*unused*/) const noexcept { return true; }
+  template <class U> bool operator!=(const arena_allocator<U> & /*unused*/) const noexcept { return false; }
+};
+
+// Exercises every hot path, returning how many checks failed
+static int exercise()
+{
+  int retcode = 0;
+  char buffer[256];
+
+  posix_code pc(ENOENT);
+  CHECK(pc.message().size() > 0);
+  CHECK(pc.message_into(buffer, sizeof(buffer)) > 0);
+  CHECK(pc == errc::no_such_file_or_directory);
+  CHECK(0 == strcmp(generic_code(errc::permission_denied).message().c_str(), "Permission denied"));
+
+  system_code sc(posix_code(EACCES));
+  CHECK(sc == errc::permission_denied);
+  CHECK(sc.failure());
+  CHECK(sc.message().size() > 0);
+  CHECK(sc.message_into(buffer, sizeof(buffer)) > 0);
+  errored_status_code<detail::erased<intptr_t>> ec(posix_code(EINVAL));
+  CHECK(ec == errc::invalid_argument);
+
+  std_error_code sec(std::make_error_code(std::errc::timed_out));
+  CHECK(sec == errc::timed_out);
+  CHECK(0 == strcmp(sec.message().c_str(), generic_code(errc::timed_out).message().c_str()));
+  CHECK(sec.message_into(buffer, sizeof(buffer)) > 0);
+  CHECK(sec.domain().name().size() > 0);
+
+  system_code cc = make_context_status_code(generic_code(errc::io_error), "reading header");
+  CHECK(cc == errc::io_error);
+  CHECK(cc.message().size() > 0);
+  CHECK(cc.message_into(buffer, sizeof(buffer)) > 0);
+
+  system_code nested = make_nested_status_code(generic_code(errc::broken_pipe), arena_allocator<generic_code>());
+  CHECK(nested == errc::broken_pipe);
+  CHECK(nested.message().size() > 0);
+
+  system_code chain = make_chained_status_code(generic_code(errc::io_error), posix_code(ENOSPC));
+  chain = make_chained_status_code(generic_code(errc::operation_canceled), static_cast<system_code &&>(chain));
+  CHECK(chain == errc::no_space_on_device);
+  CHECK(chain == errc::operation_canceled);
+  CHECK(0 == strcmp(chain.message().c_str(), "Operation canceled"));
+  CHECK(chain.message_into(buffer, sizeof(buffer)) > 0);
+  CHECK(nullptr != strstr(buffer, "Operation canceled; caused by: Input/output error; caused by: "));
+  return retcode;
+}
+
+int main()
+{
+  int retcode = 0;
+  // Set up thread local and function local statics, which may allocate upon first use
+  retcode |= exercise();
+  counting = true;
+  for(int n = 0; n < 100; n++)
+  {
+    retcode |= exercise();
+  }
+  counting = false;
+  CHECK(allocations == 0);
+  CHECK(locks == 0);
+  if(allocations != 0 || locks != 0)
+  {
+    fprintf(stderr, "%u allocations and %u locks in real-time paths\n", allocations.load(), locks.load());
+  }
+
+  // Check that the interposition works at all
+  counting = true;
+  {
+    // Store through volatile so the optimiser cannot elide the allocation
+    void *volatile p = malloc(16);
+    free(p);
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_mutex_lock(&mutex);
+    pthread_mutex_unlock(&mutex);
+  }
+  counting = false;
+  CHECK(allocations == 1);
+  CHECK(locks == 1);
+
+  // An exhausted chain block pool returns the outer code without its cause
+  static_assert(SYSTEM_ERROR2_REALTIME_CHAIN_BLOCKS == 4, "");
+  {
+    system_code a = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+    system_code b = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+    system_code c = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+    CHECK(a == errc::timed_out);
+    CHECK(b == errc::timed_out);
+    CHECK(c == errc::timed_out);
+    {
+      system_code d = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+      CHECK(d == errc::timed_out);
+      system_code outer = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+      CHECK(outer == errc::io_error);
+      CHECK(outer != errc::timed_out);
+    }
+    // Destroying a chain returns its block to the pool
+    system_code e = make_chained_status_code(generic_code(errc::io_error), generic_code(errc::timed_out));
+    CHECK(e == errc::timed_out);
+  }
+  return retcode;
+}
+#else
+int main()
+{
+  // Interposing malloc() and pthread_mutex_lock() is only implemented for glibc
+  return 0;
+}
+#endif
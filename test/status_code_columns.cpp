@@ -0,0 +1,187 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+#include "status-code/nested_status_code.hpp"
+#include "status-code/status_code_columns.hpp"
+
+#include <cstdio>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// A domain which counts calls into it, so the bulk operations can be shown not to call it per code
+static size_t failure_calls, generic_code_calls;
+class counting_domain : public _generic_code_domain
+{
+public:
+  constexpr counting_domain() noexcept
+      : _generic_code_domain(0x5b1d7e0c93a2f461)
+  {
+  }
+  static const counting_domain &get()
+  {
+    static const counting_domain v;
+    return v;
+  }
+
+protected:
+  virtual bool _do_failure(const status_code<void> &code) const noexcept override
+  {
+    ++failure_calls;
+    return _generic_code_domain::_do_failure(code);
+  }
+  virtual generic_code _generic_code(const status_code<void> &code) const noexcept override
+  {
+    ++generic_code_calls;
+    return _generic_code_domain::_generic_code(code);
+  }
+};
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+namespace traits
+{
+  template <> struct is_trivially_erasable<counting_domain>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace traits
+SYSTEM_ERROR2_NAMESPACE_END
+using counting_code = status_code<counting_domain>;
+
+int main()
+{
+  int retcode = 0;
+
+  // Empty containers
+  {
+    status_code_columns cols;
+    CHECK(cols.empty());
+    CHECK(cols.count_failures() == 0);
+    CHECK(cols.first_failure() == 0);
+    CHECK(cols.group_by_domain().empty());
+    CHECK(cols.histogram_by_errc()[errc::success] == 0);
+  }
+
+  // Codes of several domains, spread over several words of failure bits
+  status_code_columns cols;
+  cols.reserve(1000);
+  for(size_t n = 0; n < 1000; n++)
+  {
+    switch(n % 5)
+    {
+    case 0:
+      cols.push_back(posix_code((n == 0) ? 0 : EAGAIN));
+      break;
+    case 1:
+      cols.push_back(generic_code(errc::success));
+      break;
+    case 2:
+      cols.push_back(http_status_code((n < 500) ? 200 : 404));
+      break;
+    case 3:
+      cols.push_back(counting_code((n < 100) ? errc::success : ((n < 500) ? errc::permission_denied : errc::timed_out)));
+      break;
+    case 4:
+      cols.push_back((n == 4) ? system_code(make_nested_status_code(generic_code(errc::io_error))) : system_code());
+      break;
+    }
+  }
+  const size_t failures_when_added = failure_calls;
+  CHECK(cols.size() == 1000);
+  CHECK(cols.indices().size() == 1000);
+  CHECK(cols.values().size() == 1000);
+
+  // Codes come back out as they went in
+  CHECK(cols[0].strictly_equivalent(posix_code(0)));
+  CHECK(cols[0].success());
+  CHECK(cols[5].strictly_equivalent(posix_code(EAGAIN)));
+  CHECK(cols[5].failure());
+  CHECK(cols[5] == errc::resource_unavailable_try_again);
+  CHECK(cols[502] == http_status_code(404));
+  CHECK(cols[998].to_system_code().strictly_equivalent(counting_code(errc::timed_out)));
+  CHECK(cols[4].empty());  // nested codes cannot be compacted
+  CHECK(cols[9].empty());
+
+  // 199 POSIX, 100 HTTP and 180 counting codes are failures
+  CHECK(cols.count_failures() == 479);
+  CHECK(cols.first_failure() == 5);
+  {
+    status_code_columns few;
+    for(size_t n = 0; n < 130; n++)
+    {
+      few.push_back(generic_code(errc::success));
+    }
+    CHECK(few.first_failure() == 130);
+    few.push_back(generic_code(errc::io_error));
+    CHECK(few.first_failure() == 130);
+    CHECK(few.count_failures() == 1);
+  }
+
+  const auto groups = cols.group_by_domain();
+  CHECK(groups.size() == 4);
+  for(const auto &g : groups)
+  {
+    CHECK(g.index != 0);
+    CHECK(g.domain == compact_code_domain_registry::get().domain(g.index));
+    CHECK(g.count == 200);
+    if(*g.domain == posix_code_domain)
+    {
+      CHECK(g.failures == 199);
+    }
+    else if(*g.domain == generic_code_domain)
+    {
+      CHECK(g.failures == 0);
+    }
+    else if(*g.domain == http_status_code_domain)
+    {
+      CHECK(g.failures == 100);
+    }
+    else
+    {
+      CHECK(*g.domain == counting_domain::get());
+      CHECK(g.failures == 180);
+    }
+  }
+
+  // The counting domain has three distinct values, so is asked three times for its closest errc
+  const auto histogram = cols.histogram_by_errc();
+  CHECK(generic_code_calls == 3);
+  CHECK(histogram[errc::resource_unavailable_try_again] == 199);
+  CHECK(histogram[errc::success] == 1 + 200 + 20);
+  CHECK(histogram[errc::unknown] == 100);  // HTTP 200 has no errc
+  CHECK(histogram[errc::no_such_file_or_directory] == 100);
+  CHECK(histogram[errc::permission_denied] == 80);
+  CHECK(histogram[errc::timed_out] == 100);
+  CHECK(histogram[errc::io_error] == 0);
+
+  // None of the bulk operations asked any domain whether a code is a failure
+  CHECK(failure_calls == failures_when_added);
+  return retcode;
+}
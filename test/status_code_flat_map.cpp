@@ -0,0 +1,138 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+#include "status-code/status_code_flat_map.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+int main()
+{
+  int retcode = 0;
+
+  // Empty maps do not allocate, and find nothing
+  {
+    const status_code_flat_map<int> map;
+    CHECK(map.empty());
+    CHECK(map.find(posix_code(ENOENT)) == nullptr);
+    CHECK(map.find(trivial_system_code()) == nullptr);
+    CHECK(map.begin() == map.end());
+  }
+
+  // Keys are exact, so equivalent codes of different domains are different keys
+  {
+    status_code_flat_map<std::string> map;
+    CHECK(map.try_emplace(posix_code(ENOENT), "posix").second);
+    CHECK(map.try_emplace(generic_code(errc::no_such_file_or_directory), "generic").second);
+    CHECK(map.try_emplace(http_status_code(404), "http").second);
+    CHECK(!map.try_emplace(posix_code(ENOENT), "again").second);
+    CHECK(map.size() == 3);
+    CHECK(*map.find(posix_code(ENOENT)) == "posix");
+    CHECK(*map.find(generic_code(errc::no_such_file_or_directory)) == "generic");
+    CHECK(*map.find(http_status_code(404)) == "http");
+    CHECK(map.find(posix_code(EACCES)) == nullptr);
+    CHECK(map.contains(trivial_system_code(system_code(posix_code(ENOENT)))));
+
+    // The empty code is a key like any other
+    map[trivial_system_code()] = "empty";
+    CHECK(map.size() == 4);
+    CHECK(*map.find(trivial_system_code()) == "empty");
+    size_t seen = 0;
+    for(const auto &entry : map)
+    {
+      CHECK(*map.find(entry.first) == entry.second);
+      seen++;
+    }
+    CHECK(seen == 4);
+
+    CHECK(map.erase(posix_code(ENOENT)));
+    CHECK(!map.erase(posix_code(ENOENT)));
+    CHECK(map.erase(trivial_system_code()));
+    CHECK(map.size() == 2);
+    CHECK(map.find(posix_code(ENOENT)) == nullptr);
+    CHECK(*map.find(http_status_code(404)) == "http");
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(http_status_code(404)) == nullptr);
+  }
+
+  // Semantic lookup is opted into by keying codes by their closest generic code
+  {
+    status_code_flat_map<int, generic_key> map;
+    map[posix_code(ENOENT)]++;
+    map[http_status_code(404)]++;
+    map[generic_code(errc::no_such_file_or_directory)]++;
+    map[http_status_code(200)]++;  // no closest errc, so kept as it is
+    CHECK(map.size() == 2);
+    CHECK(*map.find(posix_code(ENOENT)) == 3);
+    CHECK(map.begin()->first.domain() == generic_code_domain || map.begin()->first.domain() == http_status_code_domain);
+    CHECK(*map.find(http_status_code(200)) == 1);
+    CHECK(map.find(http_status_code(201)) == nullptr);
+    CHECK(map.erase(http_status_code(404)));
+    CHECK(map.find(posix_code(ENOENT)) == nullptr);
+  }
+
+  // Many inserts, erases and finds agree with std::map, across many rehashes
+  {
+    status_code_flat_map<int> map;
+    std::map<std::pair<int, int>, int> reference;
+    unsigned seed = 78;
+    for(int n = 0; n < 100000 && retcode == 0; n++)
+    {
+      seed = seed * 1103515245 + 12345;
+      const int domain = static_cast<int>((seed >> 8) % 2), value = static_cast<int>((seed >> 12) % 1000), op = static_cast<int>((seed >> 24) % 3);
+      const trivial_system_code key = (domain == 0) ? trivial_system_code(posix_code(value)) : trivial_system_code(http_status_code(value));
+      const std::pair<int, int> rkey(domain, value);
+      if(op == 0)
+      {
+        map[key]++;
+        reference[rkey]++;
+      }
+      else if(op == 1)
+      {
+        CHECK(map.erase(key) == (reference.erase(rkey) != 0));
+      }
+      else
+      {
+        const int *found = map.find(key);
+        const auto it = reference.find(rkey);
+        CHECK((found != nullptr) == (it != reference.end()));
+        CHECK(found == nullptr || *found == it->second);
+      }
+      CHECK(map.size() == reference.size());
+    }
+  }
+  return retcode;
+}
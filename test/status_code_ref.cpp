@@ -0,0 +1,122 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/nested_status_code.hpp"
+#include "status-code/status_code_ref.hpp"
+#include "status-code/system_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <deque>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// Counts allocations, so references to nested codes can be shown not to copy them
+static size_t allocations;
+template <class T> struct counting_allocator : std::allocator<T>
+{
+  template <class U> struct rebind
+  {
+    using other = counting_allocator<U>;
+  };
+  counting_allocator() = default;
+  template <class U>
+  counting_allocator(const counting_allocator<U> & /*unused*/)  // NOLINT
+  {
+  }
+  T *allocate(size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>::allocate(n);
+  }
+};
+
+int main()
+{
+  int retcode = 0;
+  static_assert(sizeof(status_code_ref) == 2 * sizeof(void *), "");
+
+  const system_code timed_out(generic_code(errc::timed_out));
+  const system_code nested(make_nested_status_code(generic_code(errc::no_such_file_or_directory), counting_allocator<generic_code>()));
+  const generic_code success(errc::success);
+  const system_code empty;
+
+  // A queue of references, as a logger might keep, copies nothing
+  const size_t allocated = allocations;
+  std::deque<status_code_ref> queue;
+  queue.push_back(timed_out);
+  queue.push_back(nested);
+  queue.push_back(success);
+  queue.push_back(empty);
+  queue.push_back(status_code_ref());
+  std::deque<status_code_ref> copy(queue);
+  CHECK(allocations == allocated);
+
+  CHECK(copy[0].failure() && !copy[0].success());
+  CHECK(copy[0] == errc::timed_out);
+  CHECK(errc::timed_out == copy[0]);
+  CHECK(copy[0] != errc::interrupted);
+  CHECK(copy[0] == timed_out);
+  CHECK(timed_out == copy[0]);
+  CHECK(copy[0] == queue[0]);
+  CHECK(copy[0] != copy[1]);
+  CHECK(copy[0].equivalent(generic_code(errc::timed_out)));
+  CHECK(copy[0].matches(errc_sets::transient));
+  CHECK(&copy[0].get() == &timed_out);
+  CHECK(copy[0].domain() == generic_code_domain);
+  CHECK(0 == strcmp(copy[0].message().c_str(), timed_out.message().c_str()));
+  CHECK(copy[0].get_if<generic_code>() != nullptr && copy[0].get_if<generic_code>()->value() == errc::timed_out);
+
+  CHECK(copy[1].failure());
+  CHECK(copy[1] == errc::no_such_file_or_directory);
+  CHECK(copy[1].matches(errc_sets::not_found));
+  CHECK(copy[1].get_if<generic_code>() == nullptr);
+  char buffer[64];
+  CHECK(copy[1].message_into(buffer, sizeof(buffer)) == nested.message_into(buffer, sizeof(buffer)));
+  CHECK(allocations == allocated);
+
+  CHECK(copy[2].success() && !copy[2].failure());
+  CHECK(copy[2] == errc::success);
+  CHECK(copy[2].get_if<generic_code>() == &success);
+
+  for(size_t n = 3; n < copy.size(); n++)
+  {
+    CHECK(copy[n].empty());
+    CHECK(!copy[n].success() && !copy[n].failure());
+    CHECK(copy[n] != errc::success);
+    CHECK(copy[n] == empty);
+    CHECK(copy[n].get().empty());
+    CHECK(copy[n].get_if<generic_code>() == nullptr);
+    CHECK(0 == strcmp(copy[n].message().c_str(), "(empty)"));
+  }
+  CHECK(copy[3] == copy[4]);
+  return retcode;
+}
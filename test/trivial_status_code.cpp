@@ -0,0 +1,107 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/error.hpp"
+#include "status-code/nested_status_code.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+static_assert(std::is_trivially_copyable<trivial_system_code>::value, "");
+static_assert(std::is_trivially_destructible<trivial_system_code>::value, "");
+static_assert(std::is_trivially_copyable<trivial_error>::value, "");
+static_assert(std::is_trivially_destructible<trivial_error>::value, "");
+// Two words, trivially copyable and trivially destructible is what the Itanium and AAPCS64
+// ABIs need to return these in a register pair rather than through a hidden pointer. That GCC
+// then does so is checked on the factories below by test/trivial_status_code_codegen.cmake.
+static_assert(sizeof(trivial_system_code) == 2 * sizeof(void *), "");
+static_assert(sizeof(trivial_error) == 2 * sizeof(void *), "");
+static_assert(std::is_convertible<generic_code, trivial_system_code>::value, "");
+static_assert(std::is_convertible<trivial_system_code, system_code>::value, "");
+static_assert(std::is_convertible<trivial_error, error>::value, "");
+static_assert(!std::is_convertible<system_code, trivial_system_code>::value, "");
+// Nested codes own what they point to, so must be refused at compile time
+static_assert(!std::is_convertible<status_code<detail::indirecting_domain<generic_code, std::allocator<generic_code>>>, trivial_system_code>::value, "");
+
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+using system_code_type = posix_code;
+#define SYSTEM_CODE_VALUE ETIMEDOUT
+#else
+using system_code_type = generic_code;
+#define SYSTEM_CODE_VALUE errc::timed_out
+#endif
+
+SYSTEM_ERROR2_NOINLINE trivial_system_code make_trivial_system_code()
+{
+  return system_code_type(SYSTEM_CODE_VALUE);
+}
+SYSTEM_ERROR2_NOINLINE trivial_error make_trivial_error()
+{
+  return system_code_type(SYSTEM_CODE_VALUE);
+}
+
+int main()
+{
+  int retcode = 0;
+
+  trivial_system_code a = make_trivial_system_code();
+  CHECK(a.failure());
+  CHECK(a == errc::timed_out);
+  CHECK(a.domain() == system_code_type::domain_type::get());
+  CHECK(a.value() == static_cast<intptr_t>(SYSTEM_CODE_VALUE));
+  CHECK(0 == strcmp(a.message().c_str(), system_code_type(SYSTEM_CODE_VALUE).message().c_str()));
+
+  // Round trips through system_code and error are lossless
+  system_code b = a;
+  CHECK(b.domain() == a.domain() && b.value() == a.value());
+  trivial_system_code c(b);
+  CHECK(c.domain() == a.domain() && c.value() == a.value());
+  error d = make_trivial_error();
+  CHECK(d.domain() == a.domain() && d.value() == a.value());
+  trivial_error e(d);
+  CHECK(e.domain() == a.domain() && e.value() == a.value());
+  CHECK(!e.success());
+
+  // Erased codes of domains which are not trivially erasable convert to empty
+  system_code nested(make_nested_status_code(generic_code(errc::timed_out)));
+  CHECK(trivial_system_code(nested).empty());
+
+  trivial_system_code f = errc::interrupted;
+  CHECK(f == errc::interrupted);
+  f.clear();
+  CHECK(f.empty());
+  CHECK(trivial_system_code().empty());
+
+  return retcode;
+}
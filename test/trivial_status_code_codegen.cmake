@@ -0,0 +1,44 @@
+# Compiles the factories in test/trivial_status_code.cpp to assembly, and fails unless GCC
+# returns trivial_system_code and trivial_error in a register pair rather than through a
+# hidden pointer to the caller's storage.
+#
+# Expects CXX, SOURCE, INCLUDE_DIR, OUTPUT and PROCESSOR to be defined.
+
+execute_process(
+  COMMAND "${CXX}" -std=c++11 -O2 -S -I "${INCLUDE_DIR}" "${SOURCE}" -o "${OUTPUT}"
+  RESULT_VARIABLE result
+  ERROR_VARIABLE errors
+)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Compiling ${SOURCE} to assembly failed:\n${errors}")
+endif()
+file(READ "${OUTPUT}" assembly)
+
+if(PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+  # The second word is returned in rdx. A hidden pointer arrives in rdi and is returned in rax.
+  set(second_word "\t(mov|lea|xor|or|and|add|sub)[a-z]*\t[^\n]*%[re]?dx\n")
+  set(hidden_pointer "(\tmovq\t%rdi, %rax\n|\\(%rdi\\)\n)")
+elseif(PROCESSOR MATCHES "^(aarch64|arm64|ARM64)$")
+  # The second word is returned in x1. A hidden pointer arrives in x8.
+  set(second_word "\t[a-z]+\t(x0, )?x1, ")
+  set(hidden_pointer "\\[x8")
+else()
+  message(FATAL_ERROR "No register return check for ${PROCESSOR}")
+endif()
+
+foreach(function _Z24make_trivial_system_codev _Z18make_trivial_errorv)
+  string(FIND "${assembly}" "\n${function}:\n" begin)
+  if(begin EQUAL -1)
+    message(FATAL_ERROR "${function} not found in ${OUTPUT}")
+  endif()
+  string(SUBSTRING "${assembly}" ${begin} -1 body)
+  string(FIND "${body}" "\t.size\t${function}, " end)
+  string(SUBSTRING "${body}" 0 ${end} body)
+  if(NOT body MATCHES "${second_word}")
+    message(FATAL_ERROR "${function} does not return its second word in a register:\n${body}")
+  endif()
+  if(body MATCHES "${hidden_pointer}")
+    message(FATAL_ERROR "${function} returns through a hidden pointer:\n${body}")
+  endif()
+  message(STATUS "${function} returns in a register pair")
+endforeach()
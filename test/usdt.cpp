@@ -0,0 +1,170 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/nested_status_code.hpp"
+#include "status-code/system_code_from_exception.hpp"
+#include "status-code/system_error2.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+static_assert(SYSTEM_ERROR2_USDT, "This test requires SYSTEM_ERROR2_USDT to be enabled");
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#include <elf.h>
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+struct probe
+{
+  std::string provider, name, args;
+};
+
+// Reads the probes in the .note.stapsdt section of our own executable
+static std::vector<probe> read_probes()
+{
+  std::vector<probe> ret;
+  FILE *f = fopen("/proc/self/exe", "rb");
+  if(f == nullptr)
+  {
+    return ret;
+  }
+  std::vector<char> image;
+  char buffer[65536];
+  for(size_t bytes; (bytes = fread(buffer, 1, sizeof(buffer), f)) > 0;)
+  {
+    image.insert(image.end(), buffer, buffer + bytes);
+  }
+  fclose(f);
+  if(image.size() < sizeof(Elf64_Ehdr) || memcmp(image.data(), ELFMAG, SELFMAG) != 0 || image[EI_CLASS] != ELFCLASS64)
+  {
+    return ret;
+  }
+  Elf64_Ehdr ehdr;
+  memcpy(&ehdr, image.data(), sizeof(ehdr));
+  if(ehdr.e_shoff == 0 || ehdr.e_shoff + ehdr.e_shnum * sizeof(Elf64_Shdr) > image.size() || ehdr.e_shstrndx >= ehdr.e_shnum)
+  {
+    return ret;
+  }
+  std::vector<Elf64_Shdr> shdrs(ehdr.e_shnum);
+  memcpy(shdrs.data(), image.data() + ehdr.e_shoff, ehdr.e_shnum * sizeof(Elf64_Shdr));
+  const char *shstrtab = image.data() + shdrs[ehdr.e_shstrndx].sh_offset;
+  for(const Elf64_Shdr &shdr : shdrs)
+  {
+    if(shdr.sh_type != SHT_NOTE || strcmp(shstrtab + shdr.sh_name, ".note.stapsdt") != 0 || shdr.sh_offset + shdr.sh_size > image.size())
+    {
+      continue;
+    }
+    const char *p = image.data() + shdr.sh_offset, *end = p + shdr.sh_size;
+    while(p + sizeof(Elf64_Nhdr) <= end)
+    {
+      Elf64_Nhdr nhdr;
+      memcpy(&nhdr, p, sizeof(nhdr));
+      const char *name = p + sizeof(nhdr);
+      const char *desc = name + ((nhdr.n_namesz + 3) & ~3U);
+      p = desc + ((nhdr.n_descsz + 3) & ~3U);
+      if(p > end || nhdr.n_type != 3 || strcmp(name, "stapsdt") != 0 || nhdr.n_descsz < 3 * 8 + 3)
+      {
+        continue;
+      }
+      // Three addresses, then the provider, probe name and argument strings
+      probe pr;
+      const char *s = desc + 3 * 8;
+      pr.provider = s;
+      s += pr.provider.size() + 1;
+      pr.name = s;
+      s += pr.name.size() + 1;
+      pr.args = s;
+      ret.push_back(pr);
+    }
+  }
+  return ret;
+}
+
+static bool has_probe(const std::vector<probe> &probes, const char *name)
+{
+  for(const probe &pr : probes)
+  {
+    if(pr.provider == "system_error2" && pr.name == name)
+    {
+      // Two arguments in the SystemTap "size@location" format
+      return pr.args.compare(0, 2, "8@") == 0 && pr.args.find(" -8@") != std::string::npos;
+    }
+  }
+  return false;
+}
+
+int main()
+{
+  int retcode = 0;
+
+  // Exercise every probe site so it must be instantiated in this executable
+  error e(generic_code(errc::invalid_argument));
+  CHECK(e.failure());
+  try
+  {
+    generic_code(errc::permission_denied).throw_exception();
+  }
+  catch(const status_error<void> &ex)
+  {
+    CHECK(ex.code() == errc::permission_denied);
+  }
+  try
+  {
+    throw std::bad_alloc();
+  }
+  catch(...)
+  {
+    system_code sc = system_code_from_exception();
+    CHECK(sc == errc::not_enough_memory);
+  }
+  auto nested = make_nested_status_code(generic_code(errc::no_such_file_or_directory));
+  CHECK(nested == errc::no_such_file_or_directory);
+
+  const std::vector<probe> probes = read_probes();
+  CHECK(!probes.empty());
+  CHECK(has_probe(probes, "error_constructed"));
+  CHECK(has_probe(probes, "error_thrown"));
+  CHECK(has_probe(probes, "status_error_constructed"));
+  CHECK(has_probe(probes, "code_from_exception"));
+  CHECK(has_probe(probes, "nested_code_made"));
+  return retcode;
+}
+#else
+int main()
+{
+  // USDT probes are not emitted on this platform
+  return 0;
+}
+#endif
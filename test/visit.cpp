@@ -0,0 +1,167 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/http_status_code.hpp"
+#include "status-code/nested_status_code.hpp"
+#include "status-code/system_code.hpp"
+#include "status-code/visit.hpp"
+
+#include <cstdio>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+enum class Colour : int
+{
+  red,
+  green,
+  blue
+};
+SYSTEM_ERROR2_NAMESPACE_BEGIN
+template <> struct quick_status_code_from_enum<Colour> : quick_status_code_from_enum_defaults<Colour>
+{
+  static constexpr const auto domain_name = "Colour";
+  static constexpr const auto domain_uuid = "{3a1bd0cc-3b41-1d6c-a3e5-4e0f4b1b5a7d}";
+  static const std::initializer_list<mapping> &value_mappings()
+  {
+    static const std::initializer_list<mapping> v = {
+    {Colour::red, "red", {errc::invalid_argument}},  //
+    {Colour::green, "green", {errc::success}},       //
+    {Colour::blue, "blue", {}},                      //
+    };
+    return v;
+  }
+};
+SYSTEM_ERROR2_NAMESPACE_END
+using colour_code = quick_status_code_from_enum_code<Colour>;
+using nested_generic_code = status_code<detail::indirecting_domain<generic_code, std::allocator<generic_code>>>;
+
+// Enough more domains that visit() searches rather than compares in turn
+template <size_t N> class numbered_domain : public _generic_code_domain
+{
+public:
+  constexpr numbered_domain() noexcept
+      : _generic_code_domain(0x2f0c6d9e41b7a853ull * (N + 1))
+  {
+  }
+  static const numbered_domain &get()
+  {
+    static const numbered_domain v;
+    return v;
+  }
+};
+template <size_t N> using numbered_code = status_code<numbered_domain<N>>;
+
+// Returns which handler was called and what value it saw, and remembers what it was given
+struct visitor
+{
+  const void *seen{nullptr};
+
+  int operator()(const generic_code &c) { return seen = &c, 100 + static_cast<int>(c.value()); }
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  int operator()(const posix_code &c) { return seen = &c, 200 + c.value(); }
+#endif
+  int operator()(const http_status_code &c) { return seen = &c, static_cast<int>(c.value()); }
+  int operator()(const colour_code &c) { return seen = &c, 600 + static_cast<int>(c.value()); }
+  int operator()(const nested_generic_code &c) { return seen = &c, 700 + static_cast<int>(c.value()->sc.value()); }
+  template <size_t N> int operator()(const numbered_code<N> &c) { return seen = &c, 1000 * static_cast<int>(N + 1) + static_cast<int>(c.value()); }
+  int operator()(const status_code<void> &c) { return seen = &c, -1; }
+};
+
+int main()
+{
+  int retcode = 0;
+  const system_code codes[] = {system_code(),
+                               system_code(generic_code(errc::timed_out)),
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+                               system_code(posix_code(EINTR)),
+#endif
+                               system_code(http_status_code(404)),
+                               system_code(colour_code(Colour::blue)),
+                               system_code(make_nested_status_code(generic_code(errc::interrupted))),
+                               system_code(make_nested_status_code(http_status_code(500))),
+                               system_code(numbered_code<0>(errc::timed_out)),
+                               system_code(numbered_code<5>(errc::timed_out)),
+                               system_code(numbered_code<7>(errc::timed_out)),
+                               system_code(numbered_code<8>(errc::timed_out))};
+  for(const auto &sc : codes)
+  {
+    // Handlers get a reference to the code passed, not a copy
+    visitor v;
+    const int all = visit<generic_code,
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+                          posix_code,
+#endif
+                          http_status_code, colour_code, nested_generic_code, numbered_code<0>, numbered_code<1>, numbered_code<2>, numbered_code<3>,
+                          numbered_code<4>, numbered_code<5>, numbered_code<6>, numbered_code<7>>(sc, v);
+    CHECK(v.seen == &sc);
+    if(sc.empty() || get_id(sc) == http_status_code_domain.id() || sc.domain() == numbered_domain<8>::get())
+    {
+      CHECK(all == -1);
+    }
+    else if(sc.domain() == generic_code_domain)
+    {
+      CHECK(all == 100 + static_cast<int>(errc::timed_out));
+    }
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+    else if(sc.domain() == posix_code_domain)
+    {
+      CHECK(all == 200 + EINTR);
+    }
+#endif
+    else if(sc.domain() == http_status_code_domain)
+    {
+      CHECK(all == 404);
+    }
+    else if(sc.domain() == colour_code::domain_type::get())
+    {
+      CHECK(all == 600 + static_cast<int>(Colour::blue));
+    }
+    else if(sc.domain() == nested_generic_code::domain_type::get())
+    {
+      CHECK(all == 700 + static_cast<int>(errc::interrupted));
+    }
+    else
+    {
+      CHECK(all == 1000 * ((sc.domain() == numbered_domain<0>::get()) ? 1 : (sc.domain() == numbered_domain<5>::get()) ? 6 : 8) +
+                   static_cast<int>(errc::timed_out));
+    }
+
+    // Few candidates are dispatched differently to many, so check both agree
+    const int two = visit<numbered_code<5>, numbered_code<8>>(sc, visitor());
+    CHECK(two == ((!sc.empty() && (sc.domain() == numbered_domain<5>::get() || sc.domain() == numbered_domain<8>::get())) ?
+                  1000 * ((sc.domain() == numbered_domain<5>::get()) ? 6 : 9) + static_cast<int>(errc::timed_out) :
+                  -1));
+    const int few = visit<http_status_code, generic_code>(sc, visitor());
+    CHECK(few == ((!sc.empty() && (sc.domain() == http_status_code_domain || sc.domain() == generic_code_domain)) ? all : -1));
+    CHECK(visit<>(sc, visitor()) == -1);
+  }
+  return retcode;
+}
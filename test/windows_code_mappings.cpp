@@ -0,0 +1,93 @@
+/* Regression testing
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "status-code/windows_code_mappings.hpp"
+
+#include <cstdio>
+
+#define CHECK(expr)                                                                                                                                            \
+  if(!(expr))                                                                                                                                                  \
+  {                                                                                                                                                            \
+    fprintf(stderr, #expr " failed at line %d\n", __LINE__);                                                                                                   \
+    retcode = 1;                                                                                                                                               \
+  }
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+// The mappings are constexpr
+static_assert(win32_code_from_nt_code(0xc0000022 /*STATUS_ACCESS_DENIED*/) == 0x5 /*ERROR_ACCESS_DENIED*/, "");
+static_assert(errc_from_win32_code(0x2 /*ERROR_FILE_NOT_FOUND*/) == errc::no_such_file_or_directory, "");
+
+int main()
+{
+  int retcode = 0;
+
+  // Success and unmapped codes
+  CHECK(win32_code_from_nt_code(0) == 0);
+  CHECK(win32_code_from_nt_code(0x40000000 /*informational*/) == 0);
+  CHECK(win32_code_from_nt_code(0x80000001) == static_cast<uint32_t>(-1));
+  CHECK(win32_code_from_nt_code(0xffffffff) == static_cast<uint32_t>(-1));
+  CHECK(errc_from_nt_code(0x00000103 /*STATUS_PENDING*/) == errc::success);
+  CHECK(errc_from_nt_code(0xffffffff) == errc::unknown);
+  CHECK(errc_from_win32_code(0) == errc::success);
+  CHECK(errc_from_win32_code(0x10000) == errc::unknown);
+
+  // A sample of codes as reported by Windows machines
+  CHECK(win32_code_from_nt_code(0x80000002 /*STATUS_DATATYPE_MISALIGNMENT*/) == 0x3e6 /*ERROR_NOACCESS*/);
+  CHECK(win32_code_from_nt_code(0xc0000017 /*STATUS_NO_MEMORY*/) == 0x8 /*ERROR_NOT_ENOUGH_MEMORY*/);
+  CHECK(win32_code_from_nt_code(0xc0000034 /*STATUS_OBJECT_NAME_NOT_FOUND*/) == 0x2 /*ERROR_FILE_NOT_FOUND*/);
+  CHECK(errc_from_nt_code(0xc0000022 /*STATUS_ACCESS_DENIED*/) == errc::permission_denied);
+  CHECK(errc_from_nt_code(0xc0000017 /*STATUS_NO_MEMORY*/) == errc::not_enough_memory);
+  CHECK(errc_from_win32_code(0x5 /*ERROR_ACCESS_DENIED*/) == errc::permission_denied);
+  CHECK(errc_from_win32_code(0x57 /*ERROR_INVALID_PARAMETER*/) == errc::invalid_argument);
+
+  // Every entry of every table can be found, and NT codes are equivalent to the same
+  // generic code either directly or via their Win32 code
+  using nt_win32 = detail::nt_code_to_win32_code_source<>;
+  using nt_errc = detail::nt_code_to_errc_source<>;
+  using win32_errc = detail::win32_code_to_errc_source<>;
+  for(const auto &e : nt_win32::entries)
+  {
+    CHECK(win32_code_from_nt_code(e.code) == e.win32);
+  }
+  for(const auto &e : nt_errc::entries)
+  {
+    CHECK(errc_from_nt_code(e.code) == e.value);
+    const uint32_t win32code = win32_code_from_nt_code(e.code);
+    CHECK(win32code == static_cast<uint32_t>(-1) || errc_from_win32_code(win32code) == e.value);
+  }
+  for(const auto &e : win32_errc::entries)
+  {
+    CHECK(errc_from_win32_code(e.code) == e.value);
+  }
+  for(size_t n = 1; n < nt_win32::count; n++)
+  {
+    // Codes between entries are not found
+    if(nt_win32::entries[n].code - nt_win32::entries[n - 1].code > 1)
+    {
+      CHECK(win32_code_from_nt_code(nt_win32::entries[n].code - 1) == static_cast<uint32_t>(-1));
+    }
+  }
+  return retcode;
+}
@@ -0,0 +1,204 @@
+/* Compile a text message catalog into a binary message catalog
+(C) 2026 Niall Douglas <http://www.nedproductions.biz/> (5 commits)
+File Created: Oct 2026
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+/* The text source is UTF-8, one directive per line:
+
+  # A comment
+  domain posix
+  2 Aucun fichier ou dossier de ce type
+  domain {430f1201-94fc-06c7-430f-120194fc06c7}
+  1 Première ligne\nSeconde ligne
+
+`domain` takes `posix`, `generic`, a domain's UUID, or a domain's numeric id. All
+other lines are a value in the current domain followed by its message, in which
+`\n`, `\t` and `\\` are unescaped.
+*/
+
+#include "status-code/message_catalog.hpp"
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+#include "status-code/posix_code.hpp"
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace SYSTEM_ERROR2_NAMESPACE;
+
+struct message
+{
+  uint64_t domain;
+  int64_t value;
+  std::string text;
+};
+
+static bool parse_domain(const std::string &s, uint64_t &domain)
+{
+  if(s == "generic")
+  {
+    domain = _generic_code_domain::get().id();
+    return true;
+  }
+#ifndef SYSTEM_ERROR2_NOT_POSIX
+  if(s == "posix")
+  {
+    domain = _posix_code_domain::get().id();
+    return true;
+  }
+#endif
+  if(s.size() == 36 && s[8] == '-')
+  {
+    domain = detail::parse_uuid_from_pointer<36>(s.c_str());
+    return true;
+  }
+  if(s.size() == 38 && s[0] == '{' && s[37] == '}')
+  {
+    domain = detail::parse_uuid_from_pointer<38>(s.c_str());
+    return true;
+  }
+  char *end = nullptr;
+  domain = strtoull(s.c_str(), &end, 0);
+  return !s.empty() && *end == 0;
+}
+
+static std::string unescape(const std::string &s)
+{
+  std::string ret;
+  for(size_t n = 0; n < s.size(); n++)
+  {
+    if(s[n] == '\\' && n + 1 < s.size())
+    {
+      switch(s[++n])
+      {
+      case 'n':
+        ret.push_back('\n');
+        continue;
+      case 't':
+        ret.push_back('\t');
+        continue;
+      default:
+        break;
+      }
+    }
+    ret.push_back(s[n]);
+  }
+  return ret;
+}
+
+int main(int argc, char *argv[])
+{
+  if(argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <source.txt> <catalog.bin>" << std::endl;
+    return 1;
+  }
+  std::ifstream in(argv[1]);
+  if(!in)
+  {
+    std::cerr << "FATAL: Could not open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::vector<message> messages;
+  bool have_domain = false;
+  uint64_t domain = 0;
+  std::string line;
+  for(size_t lineno = 1; std::getline(in, line); lineno++)
+  {
+    if(!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    const size_t begin = line.find_first_not_of(" \t");
+    if(begin == std::string::npos || line[begin] == '#')
+    {
+      continue;
+    }
+    const size_t space = line.find_first_of(" \t", begin);
+    const std::string first = line.substr(begin, space - begin);
+    const size_t rest = (space == std::string::npos) ? std::string::npos : line.find_first_not_of(" \t", space);
+    const std::string remainder = (rest == std::string::npos) ? std::string() : line.substr(rest);
+    if(first == "domain")
+    {
+      if(!parse_domain(remainder, domain))
+      {
+        std::cerr << argv[1] << ":" << lineno << ": unknown domain '" << remainder << "'" << std::endl;
+        return 1;
+      }
+      have_domain = true;
+      continue;
+    }
+    char *end = nullptr;
+    const int64_t value = strtoll(first.c_str(), &end, 0);
+    if(*end != 0)
+    {
+      std::cerr << argv[1] << ":" << lineno << ": expected a value, not '" << first << "'" << std::endl;
+      return 1;
+    }
+    if(!have_domain)
+    {
+      std::cerr << argv[1] << ":" << lineno << ": value before any domain" << std::endl;
+      return 1;
+    }
+    messages.push_back({domain, value, unescape(remainder)});
+  }
+  std::stable_sort(messages.begin(), messages.end(), [](const message &a, const message &b) { return a.domain < b.domain || (a.domain == b.domain && a.value < b.value); });
+  for(size_t n = 1; n < messages.size(); n++)
+  {
+    if(messages[n].domain == messages[n - 1].domain && messages[n].value == messages[n - 1].value)
+    {
+      std::cerr << argv[1] << ": duplicate message for value " << messages[n].value << " in domain 0x" << std::hex << messages[n].domain << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<detail::message_catalog_entry> entries;
+  std::string strings;
+  for(const auto &m : messages)
+  {
+    entries.push_back({m.domain, m.value, strings.size(), m.text.size()});
+    strings.append(m.text);
+    strings.push_back(0);
+  }
+  detail::message_catalog_header header{};
+  memcpy(header.magic, detail::message_catalog_magic, sizeof(header.magic));
+  header.version = detail::message_catalog_version;
+  header.count = static_cast<uint32_t>(entries.size());
+  header.strings_offset = sizeof(header) + entries.size() * sizeof(detail::message_catalog_entry);
+  header.strings_size = strings.size();
+
+  std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(detail::message_catalog_entry)));
+  out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+  if(!out)
+  {
+    std::cerr << "FATAL: Could not write " << argv[2] << std::endl;
+    return 1;
+  }
+  std::cout << "Wrote " << entries.size() << " messages to " << argv[2] << std::endl;
+  return 0;
+}
@@ -59,87 +59,85 @@ Highest system facility error appears to be 0xC000A2A4L
 */
 
 // clang-format off
+// Windows errno values and the names of their `errc` enumerators
 static constexpr std::pair<int, const char *> posixmap[] = {
-  { 1,"EPERM" },
-  { 2,"ENOENT" },
-  { 3,"ESRCH" },
-  { 4,"EINTR" },
-  { 5,"EIO" },
-  { 6,"ENXIO" },
-  { 7,"E2BIG" },
-  { 8,"ENOEXEC" },
-  { 9,"EBADF" },
-  { 10,"ECHILD" },
-  { 11,"EAGAIN" },
-  { 12,"ENOMEM" },
-  { 13,"EACCES" },
-  { 14,"EFAULT" },
-  { 16,"EBUSY" },
-  { 17,"EEXIST" },
-  { 18,"EXDEV" },
-  { 19,"ENODEV" },
-  { 20,"ENOTDIR" },
-  { 21,"EISDIR" },
-  { 22,"EINVAL" },
-  { 23,"ENFILE" },
-  { 24,"EMFILE" },
-  { 25,"ENOTTY" },
-  { 27,"EFBIG" },
-  { 28,"ENOSPC" },
-  { 29,"ESPIPE" },
-  { 30,"EROFS" },
-  { 31,"EMLINK" },
-  { 32,"EPIPE" },
-  { 33,"EDOM" },
-  { 34,"ERANGE" },
-  { 36,"EDEADLK" },
-  { 38,"ENAMETOOLONG" },
-  { 39,"ENOLCK" },
-  { 40,"ENOSYS" },
-  { 41,"ENOTEMPTY" },
-  { 42,"EILSEQ" },
-  { 80,"STRUNCATE" },
-  { 100,"EADDRINUSE" },
-  { 101,"EADDRNOTAVAIL" },
-  { 102,"EAFNOSUPPORT" },
-  { 103,"EALREADY" },
-  { 104,"EBADMSG" },
-  { 105,"ECANCELED" },
-  { 106,"ECONNABORTED" },
-  { 107,"ECONNREFUSED" },
-  { 108,"ECONNRESET" },
-  { 109,"EDESTADDRREQ" },
-  { 110,"EHOSTUNREACH" },
-  { 111,"EIDRM" },
-  { 112,"EINPROGRESS" },
-  { 113,"EISCONN" },
-  { 114,"ELOOP" },
-  { 115,"EMSGSIZE" },
-  { 116,"ENETDOWN" },
-  { 117,"ENETRESET" },
-  { 118,"ENETUNREACH" },
-  { 119,"ENOBUFS" },
-  { 120,"ENODATA" },
-  { 121,"ENOLINK" },
-  { 122,"ENOMSG" },
-  { 123,"ENOPROTOOPT" },
-  { 124,"ENOSR" },
-  { 125,"ENOSTR" },
-  { 126,"ENOTCONN" },
-  { 127,"ENOTRECOVERABLE" },
-  { 128,"ENOTSOCK" },
-  { 129,"ENOTSUP" },
-  { 130,"EOPNOTSUPP" },
-  { 131,"EOTHER" },
-  { 132,"EOVERFLOW" },
-  { 133,"EOWNERDEAD" },
-  { 134,"EPROTO" },
-  { 135,"EPROTONOSUPPORT" },
-  { 136,"EPROTOTYPE" },
-  { 137,"ETIME" },
-  { 138,"ETIMEDOUT" },
-  { 139,"ETXTBSY" },
-  { 140,"EWOULDBLOCK" },
+  { 1,"operation_not_permitted" },
+  { 2,"no_such_file_or_directory" },
+  { 3,"no_such_process" },
+  { 4,"interrupted" },
+  { 5,"io_error" },
+  { 6,"no_such_device_or_address" },
+  { 7,"argument_list_too_long" },
+  { 8,"executable_format_error" },
+  { 9,"bad_file_descriptor" },
+  { 10,"no_child_process" },
+  { 11,"resource_unavailable_try_again" },
+  { 12,"not_enough_memory" },
+  { 13,"permission_denied" },
+  { 14,"bad_address" },
+  { 16,"device_or_resource_busy" },
+  { 17,"file_exists" },
+  { 18,"cross_device_link" },
+  { 19,"no_such_device" },
+  { 20,"not_a_directory" },
+  { 21,"is_a_directory" },
+  { 22,"invalid_argument" },
+  { 23,"too_many_files_open_in_system" },
+  { 24,"too_many_files_open" },
+  { 25,"inappropriate_io_control_operation" },
+  { 27,"file_too_large" },
+  { 28,"no_space_on_device" },
+  { 29,"invalid_seek" },
+  { 30,"read_only_file_system" },
+  { 31,"too_many_links" },
+  { 32,"broken_pipe" },
+  { 33,"argument_out_of_domain" },
+  { 34,"result_out_of_range" },
+  { 36,"resource_deadlock_would_occur" },
+  { 38,"filename_too_long" },
+  { 39,"no_lock_available" },
+  { 40,"function_not_supported" },
+  { 41,"directory_not_empty" },
+  { 42,"illegal_byte_sequence" },
+  { 100,"address_in_use" },
+  { 101,"address_not_available" },
+  { 102,"address_family_not_supported" },
+  { 103,"connection_already_in_progress" },
+  { 104,"bad_message" },
+  { 105,"operation_canceled" },
+  { 106,"connection_aborted" },
+  { 107,"connection_refused" },
+  { 108,"connection_reset" },
+  { 109,"destination_address_required" },
+  { 110,"host_unreachable" },
+  { 111,"identifier_removed" },
+  { 112,"operation_in_progress" },
+  { 113,"already_connected" },
+  { 114,"too_many_symbolic_link_levels" },
+  { 115,"message_size" },
+  { 116,"network_down" },
+  { 117,"network_reset" },
+  { 118,"network_unreachable" },
+  { 119,"no_buffer_space" },
+  { 121,"no_link" },
+  { 122,"no_message" },
+  { 123,"no_protocol_option" },
+  { 124,"no_stream_resources" },
+  { 125,"not_a_stream" },
+  { 126,"not_connected" },
+  { 127,"state_not_recoverable" },
+  { 128,"not_a_socket" },
+  { 129,"not_supported" },
+  { 130,"operation_not_supported" },
+  { 132,"value_too_large" },
+  { 133,"owner_dead" },
+  { 134,"protocol_error" },
+  { 135,"protocol_not_supported" },
+  { 136,"wrong_protocol_type" },
+  { 137,"stream_timeout" },
+  { 138,"timed_out" },
+  { 139,"text_file_busy" },
+  { 140,"operation_would_block" },
 };
 // clang-format on
 
@@ -172,8 +170,8 @@ static inline DWORD win32_error_from_nt_status(NTSTATUS ntstatus)
 
 int main()
 {
-  std::ofstream nt_win32("../include/detail/nt_code_to_win32_code.ipp");
-  std::ofstream nt_generic("../include/detail/nt_code_to_generic_code.ipp");
+  std::ofstream nt_win32("../include/status-code/detail/nt_code_to_win32_code.ipp");
+  std::ofstream nt_generic("../include/status-code/detail/nt_code_to_generic_code.ipp");
   for(auto &input : inputs)
   {
     for(NTSTATUS code = input.first; code < input.second; code++)
@@ -195,14 +193,14 @@ int main()
           }
         }
         if(win32code < 0xffff)
-          nt_win32 << "case 0x" << std::hex << (unsigned) code << ": return 0x" << win32code << ";\n";
+          nt_win32 << "{0x" << std::hex << (unsigned) code << ", 0x" << win32code << "},\n";
         if(errc[0] != '0')
-          nt_generic << "case 0x" << std::hex << (unsigned) code << ": return " << errc << ";\n";
+          nt_generic << "{0x" << std::hex << (unsigned) code << ", errc::" << errc << "},\n";
       }
     }
   }
 
-  std::ofstream win32_generic("../include/detail/win32_code_to_generic_code.ipp");
+  std::ofstream win32_generic("../include/status-code/detail/win32_code_to_generic_code.ipp");
   for(DWORD win32code = 0; win32code <= 0xffff; win32code++)
   {
     std::error_code ec(win32code, std::system_category());
@@ -217,10 +215,10 @@ int main()
       }
     }
     if(errc[0] != '0')
-      win32_generic << "case 0x" << std::hex << win32code << ": return " << errc << ";\n";
+      win32_generic << "{0x" << std::hex << win32code << ", errc::" << errc << "},\n";
     /* Omissions from the C++ 11 STL mapping */
     else if(win32code == 0x57 /*ERROR_INVALID_PARAMETER*/)
-      win32_generic << "case 0x" << std::hex << win32code << ": return EINVAL;\n";
+      win32_generic << "{0x" << std::hex << win32code << ", errc::invalid_argument},\n";
   }
 }
 